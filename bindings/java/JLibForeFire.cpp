@@ -213,6 +213,185 @@ JNIEXPORT void JNICALL Java_fprop_coupling_CCoupling_setMatrix
 
 	}
 
+/*
+ * Bulk transfers: a matrix crosses JNI once, as nx*ny*nz*nt doubles in
+ * the C order of the layer array (index ((i*ny + j)*nz + k)*nt + t),
+ * either in a double[] or in a direct ByteBuffer in native byte order
+ * (ByteBuffer.allocateDirect(8*n).order(ByteOrder.nativeOrder())).
+ * Values are read and written with the same shape, as given by
+ * getMatrixShape, so that a matrix read can be written back.
+ */
+
+/* Array of a flux or data layer, as given by its getMatrix */
+struct MatrixSource {
+	DataLayer<double>* layer;
+	FFArray<double>* array;
+	size_t nx, ny, nz, nt;
+};
+
+static bool findMatrix(JNIEnv *penv, jstring jstr, MatrixSource& src)
+{
+	const char * msg = penv->GetStringUTFChars(jstr,0);
+	string name(msg);
+	penv->ReleaseStringUTFChars(jstr,msg);
+
+	if ( executor == 0 ) {
+		executor = new Command();
+	}
+	if ( executor->getDomain() == 0 ) return false;
+
+	src.layer = executor->getDomain()->getFluxLayer(name);
+	if ( src.layer == 0 ) src.layer = executor->getDomain()->getDataLayer(name);
+	if ( src.layer == 0 ) return false;
+
+	src.array = 0;
+	src.layer->getMatrix(&src.array, executor->getTime());
+	if ( src.array == 0 ) return false;
+	src.nx = src.array->getDim("x");
+	src.ny = src.array->getDim("y");
+	src.nz = src.array->getDim("z");
+	src.nt = src.array->getDim("t");
+	return true;
+}
+
+/* copies of lazily loaded layers are not kept once used */
+static void releaseMatrix(MatrixSource& src)
+{
+	src.layer->releaseMatrix();
+	src.array = 0;
+}
+
+static void copyMatrix(MatrixSource& src, jdouble* dest)
+{
+	/* arrays are held in this order */
+	memcpy(dest, src.array->getData(), src.array->getSize()*sizeof(double));
+}
+
+static bool storeMatrix(MatrixSource& src, const jdouble* vals, size_t count)
+{
+	size_t size = src.array->getSize();
+	if ( count != size ){
+		cout << "Error: " << count << " values given for " << src.layer->getKey()
+				<< " of size " << size << endl;
+		return false;
+	}
+	if ( src.nt > 1 ){
+		/* layers are only set from 3D Fortran arrays */
+		cout << "Error: layer " << src.layer->getKey() << " has "
+				<< src.nt << " time steps and cannot be set" << endl;
+		return false;
+	}
+	/* layers are set from arrays in Fortran order */
+	vector<double> fortran(size);
+	for ( size_t i = 0; i < src.nx; i++ )
+		for ( size_t j = 0; j < src.ny; j++ )
+			for ( size_t k = 0; k < src.nz; k++ )
+				fortran[(k*src.ny + j)*src.nx + i] = vals[(i*src.ny + j)*src.nz + k];
+	string name = src.layer->getKey();
+	size_t sizeout = size;
+	src.layer->setMatrix(name, &fortran[0], size, sizeout, executor->getTime());
+	if ( name == "fuel" ) FDCell::landscapeChanged();
+	return true;
+}
+
+/*
+ * Class:     fprop_coupling_CCoupling
+ * Method:    getMatrixShape
+ * Signature: (Ljava/lang/String;)[I
+ */
+JNIEXPORT jintArray JNICALL Java_fprop_coupling_CCoupling_getMatrixShape
+	(JNIEnv *penv, jclass jc, jstring jstr)
+{
+	MatrixSource src;
+	if ( !findMatrix(penv, jstr, src) ) return NULL;
+	jint shape[4] = { (jint) src.nx, (jint) src.ny, (jint) src.nz, (jint) src.nt };
+	releaseMatrix(src);
+	jintArray result = penv->NewIntArray(4);
+	penv->SetIntArrayRegion(result, 0, 4, shape);
+	return result;
+}
+
+/*
+ * Class:     fprop_coupling_CCoupling
+ * Method:    getMatrixFlat
+ * Signature: (Ljava/lang/String;)[D
+ */
+JNIEXPORT jdoubleArray JNICALL Java_fprop_coupling_CCoupling_getMatrixFlat
+	(JNIEnv *penv, jclass jc, jstring jstr)
+{
+	MatrixSource src;
+	if ( !findMatrix(penv, jstr, src) ) return NULL;
+	size_t n = src.array->getSize();
+	jdoubleArray result = penv->NewDoubleArray(n);
+	jdouble* vals = ( result == NULL ) ? NULL : (jdouble*) penv->GetPrimitiveArrayCritical(result, 0);
+	if ( vals != NULL ){
+		copyMatrix(src, vals);
+		penv->ReleasePrimitiveArrayCritical(result, vals, 0);
+	}
+	releaseMatrix(src);
+	return ( vals == NULL ) ? NULL : result;
+}
+
+/*
+ * Class:     fprop_coupling_CCoupling
+ * Method:    getMatrixBuffer
+ * Signature: (Ljava/lang/String;Ljava/nio/ByteBuffer;)J
+ * Returns the number of values of the matrix (written only if the
+ * buffer is large enough), -1 if the matrix is unknown
+ */
+JNIEXPORT jlong JNICALL Java_fprop_coupling_CCoupling_getMatrixBuffer
+	(JNIEnv *penv, jclass jc, jstring jstr, jobject buffer)
+{
+	MatrixSource src;
+	if ( !findMatrix(penv, jstr, src) ) return -1;
+	size_t n = src.array->getSize();
+	jdouble* vals = (jdouble*) penv->GetDirectBufferAddress(buffer);
+	jlong capacity = penv->GetDirectBufferCapacity(buffer);
+	if ( vals != NULL and capacity >= (jlong) (n*sizeof(jdouble)) ) copyMatrix(src, vals);
+	releaseMatrix(src);
+	return n;
+}
+
+/*
+ * Class:     fprop_coupling_CCoupling
+ * Method:    setMatrixFlat
+ * Signature: (Ljava/lang/String;[D)Z
+ */
+JNIEXPORT jboolean JNICALL Java_fprop_coupling_CCoupling_setMatrixFlat
+	(JNIEnv *penv, jclass jc, jstring jstr, jdoubleArray values)
+{
+	MatrixSource src;
+	if ( !findMatrix(penv, jstr, src) ) return JNI_FALSE;
+	size_t n = penv->GetArrayLength(values);
+	bool stored = false;
+	if ( n > 0 ){
+		vector<jdouble> vals(n);
+		penv->GetDoubleArrayRegion(values, 0, n, &vals[0]);
+		stored = storeMatrix(src, &vals[0], n);
+	}
+	releaseMatrix(src);
+	return stored ? JNI_TRUE : JNI_FALSE;
+}
+
+/*
+ * Class:     fprop_coupling_CCoupling
+ * Method:    setMatrixBuffer
+ * Signature: (Ljava/lang/String;Ljava/nio/ByteBuffer;J)Z
+ */
+JNIEXPORT jboolean JNICALL Java_fprop_coupling_CCoupling_setMatrixBuffer
+	(JNIEnv *penv, jclass jc, jstring jstr, jobject buffer, jlong count)
+{
+	MatrixSource src;
+	if ( !findMatrix(penv, jstr, src) ) return JNI_FALSE;
+	const jdouble* vals = (const jdouble*) penv->GetDirectBufferAddress(buffer);
+	jlong capacity = penv->GetDirectBufferCapacity(buffer);
+	bool stored = false;
+	if ( vals != NULL and count >= 0 and capacity >= (jlong) (count*sizeof(jdouble)) )
+		stored = storeMatrix(src, vals, count);
+	releaseMatrix(src);
+	return stored ? JNI_TRUE : JNI_FALSE;
+}
+
 
 
 #endif
@@ -56,6 +56,46 @@ JNIEXPORT jobjectArray JNICALL Java_fprop_coupling_CCoupling_getMatrix
 JNIEXPORT void JNICALL Java_fprop_coupling_CCoupling_setMatrix
   (JNIEnv *, jobject, jstring, jobjectArray);
 
+/*
+ * Class:     fprop_coupling_CCoupling
+ * Method:    getMatrixShape
+ * Signature: (Ljava/lang/String;)[I
+ */
+JNIEXPORT jintArray JNICALL Java_fprop_coupling_CCoupling_getMatrixShape
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     fprop_coupling_CCoupling
+ * Method:    getMatrixFlat
+ * Signature: (Ljava/lang/String;)[D
+ */
+JNIEXPORT jdoubleArray JNICALL Java_fprop_coupling_CCoupling_getMatrixFlat
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     fprop_coupling_CCoupling
+ * Method:    getMatrixBuffer
+ * Signature: (Ljava/lang/String;Ljava/nio/ByteBuffer;)J
+ */
+JNIEXPORT jlong JNICALL Java_fprop_coupling_CCoupling_getMatrixBuffer
+  (JNIEnv *, jclass, jstring, jobject);
+
+/*
+ * Class:     fprop_coupling_CCoupling
+ * Method:    setMatrixFlat
+ * Signature: (Ljava/lang/String;[D)Z
+ */
+JNIEXPORT jboolean JNICALL Java_fprop_coupling_CCoupling_setMatrixFlat
+  (JNIEnv *, jclass, jstring, jdoubleArray);
+
+/*
+ * Class:     fprop_coupling_CCoupling
+ * Method:    setMatrixBuffer
+ * Signature: (Ljava/lang/String;Ljava/nio/ByteBuffer;J)Z
+ */
+JNIEXPORT jboolean JNICALL Java_fprop_coupling_CCoupling_setMatrixBuffer
+  (JNIEnv *, jclass, jstring, jobject, jlong);
+
 
 #ifdef __cplusplus
 }
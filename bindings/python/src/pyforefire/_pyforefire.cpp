@@ -100,26 +100,36 @@ bool PLibForeFire::isValued(char *name){
 	return params->isValued(string(name));
 }
 
-py::object PLibForeFire::getDataMatrixPy(char *name) {
-    // Get the 2D data matrix using the string name.
-    std::vector<std::vector<double>> matrix = pyxecutor->getDomain()->getDataMatrix(string(name));
-    
-    // Check if the matrix equals the sentinel value, i.e. a 1x1 matrix with -9999.
-    if (matrix.size() == 1 && matrix[0].size() == 1 && matrix[0][0] == -9999) {
-        return py::none();
+/* Hands a raster over to NumPy without copying it, the array owning the raster
+ * through a capsule. The array has the (x, y) shape of the raster, or the (y, x)
+ * shape when transposed, the strides doing the transposition. */
+template<typename T>
+static py::array rasterToArray(FFRaster<T>* raster, bool transposed) {
+    py::capsule owner(raster, [](void *r) { delete reinterpret_cast<FFRaster<T>*>(r); });
+    py::ssize_t nx = raster->sizeX();
+    py::ssize_t ny = raster->sizeY();
+    py::ssize_t rowBytes = raster->getStride() * sizeof(T);
+    py::ssize_t valBytes = sizeof(T);
+    if (transposed) {
+        return py::array_t<T>({ny, nx}, {valBytes, rowBytes}, raster->data(), owner);
     }
-    
-    // Flatten the 2D vector for conversion to a numpy array.
-    size_t rows = matrix.size();
-    size_t cols = matrix[0].size();
-    std::vector<double> flat_data;
-    flat_data.reserve(rows * cols);
-    for (const auto &row : matrix) {
-        flat_data.insert(flat_data.end(), row.begin(), row.end());
+    return py::array_t<T>({nx, ny}, {rowBytes, valBytes}, raster->data(), owner);
+}
+
+template<typename T>
+static py::object sampleRaster(const std::string &name, bool transposed) {
+    FFRaster<T>* raster = new FFRaster<T>();
+    if (!pyxecutor->getDomain()->getDataRaster(name, *raster) || raster->empty()) {
+        delete raster;
+        return py::none();
     }
-    
-    // Create and return a NumPy array with the shape (rows, cols)
-    return py::array_t<double>({rows, cols}, flat_data.data());
+    return rasterToArray(raster, transposed);
+}
+
+py::object PLibForeFire::getDataMatrixPy(char *name, bool float32) {
+    // Get the 2D data raster using the string name, shape (x, y), None if unknown.
+    if (float32) return sampleRaster<float>(string(name), false);
+    return sampleRaster<double>(string(name), false);
 }
 
 string PLibForeFire::execute(char *command)
@@ -162,6 +172,44 @@ void PLibForeFire::addIndexLayer(char *type, char *name, double x0 , double y0,
  	pyxecutor->getDomain()->addIndexLayer(ltype, lname, x0, y0, t0, width, height, timespan, ni, nj, nk, nl, values.mutable_data());
 }
 
+size_t PLibForeFire::addFireFronts(py::array_t<double> x, py::array_t<double> y, py::array_t<size_t> offsets, py::object parents, py::object t){
+	/* Rings of coordinates in meters, clockwise as in startFire[points=...],
+	 * ring r being made of the points offsets[r] to offsets[r+1]-1 */
+	if ( pyxecutor->getDomain() == 0 ) throw std::runtime_error("No domain defined, create one before adding fronts");
+	py::array_t<double, py::array::c_style | py::array::forcecast> xs(x);
+	py::array_t<double, py::array::c_style | py::array::forcecast> ys(y);
+	py::array_t<size_t, py::array::c_style | py::array::forcecast> offs(offsets);
+	size_t numPoints = (size_t) xs.size();
+	if ( (size_t) ys.size() != numPoints ) throw std::runtime_error("x and y must have the same size");
+	if ( offs.size() < 2 ) throw std::runtime_error("offsets must hold at least two values");
+	size_t numRings = (size_t) offs.size() - 1;
+	const size_t* o = offs.data();
+	for ( size_t r = 0; r < numRings; r++ ){
+		if ( o[r] > o[r+1] or o[r+1] > numPoints ) throw std::runtime_error("offsets must be increasing and within the coordinates");
+	}
+	py::array_t<int, py::array::c_style | py::array::forcecast> pars;
+	const int* p = 0;
+	if ( !parents.is_none() ){
+		pars = parents.cast<py::array_t<int, py::array::c_style | py::array::forcecast> >();
+		if ( (size_t) pars.size() != numRings ) throw std::runtime_error("parents must hold one value per ring");
+		p = pars.data();
+	}
+	double time = t.is_none() ? pyxecutor->getDomain()->getSimulationTime() : t.cast<double>();
+	pyxecutor->startFireRings(time, numRings, o, xs.data(), ys.data(), p);
+	return (size_t) pyxecutor->getDomain()->getDomainFront()->getTotalNumFN();
+}
+
+py::dict PLibForeFire::getMemoryUsage(){
+	if ( pyxecutor->getDomain() == 0 ) throw std::runtime_error("No domain defined");
+	std::map<std::string, size_t> usage;
+	pyxecutor->getDomain()->getMemoryUsage(usage);
+	py::dict result;
+	for ( std::map<std::string, size_t>::iterator it = usage.begin(); it != usage.end(); ++it ){
+		result[py::str(it->first)] = it->second;
+	}
+	return result;
+}
+
 py::array_t<double> PLibForeFire::getDoubleArray(char* name){
 	double lTime = pyxecutor->getDomain()->getSimulationTime();
 
@@ -242,6 +290,8 @@ py::array_t<double> PLibForeFire::getDoubleArray(char* name, double t){
                  reshaped_data.data() // Now directly use reshaped data
              );
              //free(srcD);
+             // the layer may have made a full copy for this request
+             myDataLayer->releaseMatrix();
              return arr;
 		}
 
@@ -254,13 +304,46 @@ py::array_t<double> PLibForeFire::getDoubleArray(char* name, double t){
 		return arr;
 }
 
+/* Arrival time map of a 'series' burning map output at the last record before
+ * 'time', shape (y, x) with -9999 for unburnt points, None if unreadable. */
+static py::object readArrivalTimeSeries(const std::string &filename, double time) {
+    std::vector<double> values;
+    size_t nx = 0, ny = 0;
+    double recordTime = 0;
+    if (!ArrivalTimeSeries::reconstruct(filename, time, values, nx, ny, recordTime)) {
+        return py::none();
+    }
+    py::array_t<double> atime({(py::ssize_t) ny, (py::ssize_t) nx});
+    std::copy(values.begin(), values.end(), atime.mutable_data());
+    return atime;
+}
+
 PYBIND11_MODULE(_pyforefire, m) {
     m.doc() = "pybind11 pyforefire plugin"; // optional module docstring
 
+    m.def("readArrivalTimeSeries", &readArrivalTimeSeries, py::arg("filename"), py::arg("time"),
+          "Arrival time map of a series output at the last record before the given time");
+    m.def("arrivalTimeSeriesTimes", [](const std::string &filename) {
+        std::vector<double> times;
+        ArrivalTimeSeries::getTimes(filename, times);
+        py::array_t<double> arr((py::ssize_t) times.size());
+        std::copy(times.begin(), times.end(), arr.mutable_data());
+        return arr;
+    }, py::arg("filename"), "Times of the records of a series output");
+
     py::class_<PLibForeFire>(m, "ForeFire")
         .def(py::init())
 		.def("createDomain", &PLibForeFire::createDomain)
         .def("addLayer", &PLibForeFire::addLayer)
+		.def("addFireFronts", &PLibForeFire::addFireFronts, py::arg("x"), py::arg("y"), py::arg("offsets"),
+			py::arg("parents") = py::none(), py::arg("t") = py::none(),
+			"Starts fires from rings of coordinates in one pass. Ring r is made of the points "
+			"offsets[r] to offsets[r+1]-1 of x and y (in meters, clockwise as in startFire[points=...]) "
+			"and is nested in ring parents[r] when given and positive. Returns the number of firenodes of the domain.")
+		.def("getMemoryUsage", &PLibForeFire::getMemoryUsage,
+			"Memory held by each subsystem of the domain, in bytes: 'burningMaps', 'layers' and "
+			"'layer.<name>' for each layer, 'fireNodes', 'trashNodes', 'events', 'backups', "
+			"'frontDepth', 'rasterBand' and their 'total'.")
 		.def("setInt", &PLibForeFire::setInt)
 		.def("getInt", &PLibForeFire::getInt)
 		.def("getInt", &PLibForeFire::getInt)
@@ -344,6 +427,7 @@ PYBIND11_MODULE(_pyforefire, m) {
             return self.addIndexLayer(type, name, x0, y0, t0, width, height, timespan, nx, ny, nz, nnt, dataC_py);
 
 		})
+		.def("getDataMatrix", &PLibForeFire::getDataMatrixPy, py::arg("name"), py::arg("float32") = false)
 		.def("getDoubleArray", [](PLibForeFire& self, char* name) {
 			return self.getDoubleArray(name);
 		})
@@ -376,25 +460,13 @@ PYBIND11_MODULE(_pyforefire, m) {
                     return py::cast(param_str);
                 }
             } else {
-                // Parameter is not set: check for a data matrix with the given key.
-                std::vector<std::vector<double>> matrix = pyxecutor->getDomain()->getDataMatrix(const_cast<char*>(key.c_str()));
-                // If the returned matrix is the sentinel (1x1 with -9999), consider it non-existent.
-                if (matrix.size() == 1 && matrix[0].size() == 1 && matrix[0][0] == -9999) {
+                // Parameter is not set: check for a data raster with the given key.
+                py::object matrix = sampleRaster<double>(key, true);
+                if (matrix.is_none()) {
                     throw std::runtime_error("Parameter '" + key + "' does not exist.");
                 }
-                // For the transposed case: rows come from matrix[0].size() and columns from matrix.size().
-                size_t rows = matrix[0].size();
-                size_t cols = matrix.size();
-                std::vector<double> flat_data;
-                flat_data.reserve(rows * cols);
-                // Build the flat array with the correct orientation: iterate row-wise.
-                for (size_t r = 0; r < rows; ++r) {
-                    for (size_t c = 0; c < cols; ++c) {
-                        flat_data.push_back(matrix[c][r]);
-                    }
-                }
-                // Return the data as a NumPy array with shape (rows, cols).
-                return py::array_t<double>({rows, cols}, flat_data.data());
+                // Rows along y and columns along x, viewed in place through the strides.
+                return matrix;
             }
         });
 }
@@ -21,6 +21,7 @@ typedef struct _SignedIntBuf
 #include <Futils.h>
 #include <SimulationParameters.h>
 #include <CLibForeFire.h>
+#include <ArrivalTimeSeries.h>
 
 using namespace std;
 
@@ -43,13 +44,15 @@ void createDomain( int id
 void addScalarLayer(char *type,char *name, double x0 , double y0, double t0, double width , double height, double timespan, int nnx, int nny, int nnz, int nnl, py::array_t<double> values);
 void addIndexLayer(char *type,char *name, double x0 , double y0, double t0, double width , double height, double timespan, int nnx, int nny, int nnz, int nnl, py::array_t<int> values);
 void addLayer(char*, char* ,char*);
+size_t addFireFronts(py::array_t<double> x, py::array_t<double> y, py::array_t<size_t> offsets, py::object parents, py::object t);
+py::dict getMemoryUsage();
 void setInt(char* name, int val);
 int getInt(char* name );
 void setDouble(char* name, double val);
 double getDouble(char* name);
 
 bool isValued(char *name);
-py::object getDataMatrixPy(char* name);
+py::object getDataMatrixPy(char* name, bool float32 = false);
 py::array_t<double> getDoubleArray(char* name);
 py::array_t<double> getDoubleArray(char* name, double t);
 void setString(char* name, char* val);
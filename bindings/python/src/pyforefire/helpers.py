@@ -677,3 +677,133 @@ def print_ff_script(file_path):
                 print(command)  # This is for demonstration; replace with actual ff.execute(clean_line) in use
                 # If you have the ff object with an execute method available, you would call it here:
                 # ff.execute(clean_line)
+
+
+def _decode_zigzag_varints(buf):
+    """Decodes a byte array of zigzag varints into int64 values."""
+    b = np.frombuffer(buf, dtype=np.uint8)
+    if b.size == 0:
+        return np.zeros(0, dtype=np.int64)
+    ends = np.flatnonzero((b & 0x80) == 0)
+    starts = np.concatenate(([0], ends[:-1] + 1))
+    pos = np.arange(b.size) - np.repeat(starts, ends - starts + 1)
+    parts = (b & 0x7F).astype(np.uint64) << (7 * pos).astype(np.uint64)
+    vals = np.add.reduceat(parts, starts)
+    return ((vals >> np.uint64(1)).astype(np.int64)) ^ -((vals & np.uint64(1)).astype(np.int64))
+
+
+def read_binary_fronts(source):
+    """
+    Reads a binary 'FFFRONTS' front stream (dumpMode=binary).
+
+    Parameters:
+        source (str or bytes): path of the stream, or its content.
+
+    Returns:
+        (header, records): the header as a dict, and one dict per output
+        time with its 'time' and its 'rings', each ring having its 'parent'
+        (index of the enclosing ring, -1 for top level fronts), 'depth',
+        'xy' (n x 2 array of coordinates in meters), 'speed' and 'state'.
+    """
+    if isinstance(source, (bytes, bytearray, memoryview)):
+        data = bytes(source)
+    else:
+        with open(source, "rb") as f:
+            data = f.read()
+    if data[:8] != b"FFFRONTS":
+        raise ValueError("not a FFFRONTS stream")
+    (version, encoding, quantum, ox, oy, ref_lon, ref_lat, m_lon, m_lat,
+     ref_year, ref_day, ref_time) = struct.unpack_from("<IIddddddd iid", data, 8)
+    header = dict(version=version, encoding="quantized" if encoding == 1 else "float32",
+                  quantum=quantum, origin=(ox, oy), refLongitude=ref_lon, refLatitude=ref_lat,
+                  metersPerDegreeLon=m_lon, metersPerDegreeLat=m_lat,
+                  refYear=ref_year, refDay=ref_day, refTime=ref_time)
+    offset = 88
+    records = []
+    while offset + 32 <= len(data):
+        tag, num_rings, time, num_nodes, payload = struct.unpack_from("<4sIdQQ", data, offset)
+        if tag != b"FREC":
+            raise ValueError("corrupted FFFRONTS stream at byte %d" % offset)
+        offset += 32
+        table = np.frombuffer(data, dtype=np.dtype([("parent", "<i4"), ("depth", "<u4"),
+                                                     ("count", "<u4"), ("bytes", "<u4")]),
+                              count=num_rings, offset=offset)
+        pos = offset + 16 * num_rings
+        rings = []
+        for parent, depth, count, nbytes in table:
+            coords = data[pos:pos + nbytes]
+            pos += nbytes
+            if encoding == 1:
+                q = _decode_zigzag_varints(coords).reshape(-1, 2)
+                xy = np.cumsum(q, axis=0) * quantum
+            else:
+                xy = np.frombuffer(coords, dtype="<f4").reshape(-1, 2).astype(np.float64)
+            xy = xy + (ox, oy)
+            speed = np.frombuffer(data, dtype="<f4", count=count, offset=pos)
+            pos += 4 * count
+            state = np.frombuffer(data, dtype=np.uint8, count=count, offset=pos)
+            pos += count
+            rings.append(dict(parent=int(parent), depth=int(depth), xy=xy, speed=speed, state=state))
+        offset += payload
+        records.append(dict(time=time, numNodes=num_nodes, rings=rings))
+    return header, records
+
+
+def binary_fronts_to_geojson(header, record):
+    """
+    Converts one record of a binary front stream into a GeoJSON FeatureCollection
+    (dict), with the same layout as dumpMode=geojson: one MultiPolygon feature per
+    top level front, its inner fronts being the holes of the polygon.
+    """
+    import datetime
+    secs = int(header["refTime"] + record["time"])
+    valid_at = (datetime.datetime(header["refYear"], 1, 1)
+                + datetime.timedelta(days=header["refDay"] - 1, seconds=secs))
+
+    def lonlat(xy):
+        lon = header["refLongitude"] + xy[:, 0] / header["metersPerDegreeLon"]
+        lat = header["refLatitude"] + xy[:, 1] / header["metersPerDegreeLat"]
+        pts = [[round(float(a), 5), round(float(b), 5), 0] for a, b in zip(lon[::-1], lat[::-1])]
+        if pts:
+            pts.append(pts[0])
+        return pts
+
+    rings = record["rings"]
+    features = []
+    owner = {}
+    for idx, ring in enumerate(rings):
+        # odd depths are fire areas, even depths are unburnt holes in their parent
+        if ring["depth"] % 2 == 1:
+            owner[idx] = len(features)
+            features.append([lonlat(ring["xy"])])
+        elif ring["parent"] in owner:
+            features[owner[ring["parent"]]].append(lonlat(ring["xy"]))
+    return {
+        "type": "FeatureCollection",
+        "valid_at": valid_at.strftime("%Y-%m-%dT%H:%M:%SZ"),
+        "features": [{
+            "type": "Feature",
+            "properties": {"numberOfPolygons": len(polygon)},
+            "geometry": {"type": "MultiPolygon", "coordinates": [polygon]},
+        } for polygon in features],
+    }
+
+
+def convert_binary_fronts(path, pattern=None):
+    """
+    Writes every record of a binary front stream as a GeoJSON file named
+    '<pattern>.<time>.geojson' (pattern defaults to the stream path without
+    its extension), and returns the list of written files.
+    """
+    import json
+    import os
+    header, records = read_binary_fronts(path)
+    if pattern is None:
+        pattern = os.path.splitext(path)[0]
+    written = []
+    for record in records:
+        fname = "%s.%g.geojson" % (pattern, record["time"])
+        with open(fname, "w") as f:
+            json.dump(binary_fronts_to_geojson(header, record), f)
+        written.append(fname)
+    return written
@@ -14,6 +14,7 @@
 #include "FFArrays.h"
 #include "FireNode.h"
 #include "include/FFConstants.h"
+#include "Logger.h"
 
 using namespace std;
 
@@ -115,6 +116,8 @@ public:
 	void setValueAt(FFPoint loc,  double tval, T value){};
 	/*! \brief getter to the pointer on the FFArray */
 	void getMatrix(FFArray<T>**, const double&);
+	/*! \brief memory held by the layer (bytes) */
+	size_t getMemorySize(){ return this->arrayMemory(array); }
 	/*! \brief stores data from a fortran array into the FFArray */
 	void setMatrix(string&, double*, const size_t&, size_t&, const double&);
 
@@ -140,8 +143,8 @@ template<typename T>
 T Array3DdataLayer<T>::getValueAt(FireNode* fn){
 	if ( interp == nearestData ) return getNearestData(fn->getLoc());
 	if ( interp == bilinear ) return bilinearInterp(fn->getLoc());
-	cout<<"WARNING: unknown interpolation method in "
-			<<"Array3DdataLayer<T>::getValueAt(FireNode*)"<<endl;
+	FF_WARNING(layer, "unknown interpolation method in "
+			<<"Array3DdataLayer<T>::getValueAt(FireNode*)");
 	return (T) 0;
 }
 
@@ -149,8 +152,8 @@ template<typename T>
 T Array3DdataLayer<T>::getValueAt(FFPoint loc, const double& time){
 	if ( interp == nearestData ) return getNearestData(loc);
 	if ( interp == bilinear ) return bilinearInterp(loc);
-	cout<<"WARNING: unknown interpolation method in "
-			<<"Array3DdataLayer<T>::getValueAt(FFPoint, const double&)"<<endl;
+	FF_WARNING(layer, "unknown interpolation method in "
+			<<"Array3DdataLayer<T>::getValueAt(FFPoint, const double&)");
 	return (T) 0;
 }
 
@@ -255,8 +258,8 @@ void Array3DdataLayer<T>::setMatrix(string& mname, double* inMatrix
 		// copying data from atmospheric matrix
 		array->copyDataFromFortran(inMatrix);
 	} else {
-		cout<<"Error while trying to retrieve data for layer "
-				<<this->getKey()<<", matrix size not matching";
+		FF_ERROR(layer, "Error while trying to retrieve data for layer "
+				<<this->getKey()<<", matrix size not matching");
 	}
 }
 
@@ -379,6 +382,8 @@ public:
 	void setValueAt(FFPoint loc,  double tval, T value){};
 	/*! \brief getter to the pointer on the FFArray */
 	void getMatrix(FFArray<T>**, const double&);
+	/*! \brief memory held by the layer (bytes) */
+	size_t getMemorySize(){ return this->arrayMemory(array); }
 	/*! \brief stores data from a fortran array into the FFArray */
 	void setMatrix(string&, double*, const size_t&, size_t&, const double&);
 
@@ -411,8 +416,8 @@ template<typename T>
 T Array2DdataLayer<T>::getValueAt(FireNode* fn){
 	if ( interp == nearestData ) return getNearestData(fn->getLoc());
 	if ( interp == bilinear ) return bilinearInterp(fn->getLoc());
-	cout<<"WARNING: unknown interpolation method in "
-			<<"Array2DdataLayer<T>::getValueAt(FireNode*)"<<endl;
+	FF_WARNING(layer, "unknown interpolation method in "
+			<<"Array2DdataLayer<T>::getValueAt(FireNode*)");
 	return (T) 0;
 }
 
@@ -420,8 +425,8 @@ template<typename T>
 T Array2DdataLayer<T>::getValueAt(FFPoint loc, const double& time){
 	if ( interp == nearestData ) return getNearestData(loc);
 	if ( interp == bilinear ) return bilinearInterp(loc);
-	cout<<"WARNING: unknown interpolation method in "
-			<<"Array3DdataLayer<T>::getValueAt(FFPoint, const double&)"<<endl;
+	FF_WARNING(layer, "unknown interpolation method in "
+			<<"Array3DdataLayer<T>::getValueAt(FFPoint, const double&)");
 	return (T) 0;
 }
 
@@ -517,8 +522,8 @@ void Array2DdataLayer<T>::setMatrix(string& mname, double* inMatrix
 		// copying data from atmospheric matrix
 		array->copyDataFromFortran(inMatrix);
 	} else {
-		cout<<"Error while trying to retrieve data for layer "
-				<<this->getKey()<<", matrix size not matching";
+		FF_ERROR(layer, "Error while trying to retrieve data for layer "
+				<<this->getKey()<<", matrix size not matching");
 	}
 }
 
@@ -0,0 +1,227 @@
+/**
+ * @file ArrivalTimeSeries.cpp
+ * @brief Implements the change-only time series of the arrival time map
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#include "ArrivalTimeSeries.h"
+#include "FireDomain.h"
+#include "FDCell.h"
+
+namespace libforefire {
+
+/* value stored for unburnt points, as in the full output */
+static const double unburnt = -9999;
+
+ArrivalTimeSeries::ArrivalTimeSeries(FireDomain* fd, const string& fname)
+	: domain(fd), path(fname), file(0), nx(0), ny(0), tileX(0), tileY(0)
+	  , numRecords(0), numTiles(0), lastRevision(0) {
+}
+
+ArrivalTimeSeries::~ArrivalTimeSeries() {
+	if ( file != 0 ) {
+		try {
+			file->close();
+		} catch (...) {}
+		delete file;
+	}
+}
+
+void ArrivalTimeSeries::open(const double& time){
+
+	nx = domain->globalBMapSizeX;
+	ny = domain->globalBMapSizeY;
+	tileX = domain->localBMapSizeX;
+	tileY = domain->localBMapSizeY;
+
+	file = new NcFile(path, NcFile::replace);
+	NcDim xDim = file->addDim("DIMX", nx);
+	NcDim yDim = file->addDim("DIMY", ny);
+	NcDim txDim = file->addDim("tile_x", tileX);
+	NcDim tyDim = file->addDim("tile_y", tileY);
+	NcDim recDim = file->addDim("record");
+	NcDim tileDim = file->addDim("tile");
+
+	vector<NcDim> dims = {yDim, xDim};
+	NcVar base = file->addVar("arrival_time_of_front", ncDouble, dims);
+	base.setCompression(true, true, 6);
+	base.putAtt("time", NC_DOUBLE, time);
+
+	vector<size_t> chunk(1, 1024);
+	NcVar times = file->addVar("time", ncDouble, recDim);
+	times.setChunking(NcVar::nc_CHUNKED, chunk);
+	NcVar first = file->addVar("first_tile", ncInt, recDim);
+	first.setChunking(NcVar::nc_CHUNKED, chunk);
+	NcVar count = file->addVar("num_tiles", ncInt, recDim);
+	count.setChunking(NcVar::nc_CHUNKED, chunk);
+	NcVar ti = file->addVar("tile_i", ncInt, tileDim);
+	ti.setChunking(NcVar::nc_CHUNKED, chunk);
+	NcVar tj = file->addVar("tile_j", ncInt, tileDim);
+	tj.setChunking(NcVar::nc_CHUNKED, chunk);
+
+	vector<NcDim> tileDims = {tileDim, tyDim, txDim};
+	NcVar data = file->addVar("tile_data", ncDouble, tileDims);
+	vector<size_t> tileChunk = {1, tileY, tileX};
+	data.setChunking(NcVar::nc_CHUNKED, tileChunk);
+	data.setCompression(true, true, 6);
+
+	NcDim domdim = file->addDim("domdim", 1);
+	NcVar dom = file->addVar("domain", ncChar, domdim);
+	dom.putAtt("SWx", NC_DOUBLE, domain->SWCorner.getX());
+	dom.putAtt("SWy", NC_DOUBLE, domain->SWCorner.getY());
+	dom.putAtt("Lx", NC_DOUBLE, domain->NECorner.getX() - domain->SWCorner.getX());
+	dom.putAtt("Ly", NC_DOUBLE, domain->NWCorner.getY() - domain->SWCorner.getY());
+	dom.putAtt("Lz", NC_DOUBLE, 0.);
+	dom.putAtt("refYear", NC_INT, int(domain->refYear));
+	dom.putAtt("refDay", NC_INT, int(domain->refDay));
+
+	/* base snapshot, everything changed up to now is in it */
+	lastRevision = FDCell::getRevisionCounter();
+	vector<double> matrix(nx*ny);
+	for ( size_t i = 0; i < nx; i++ ) {
+		for ( size_t j = 0; j < ny; j++ ) {
+			double val = domain->getArrivalTime(i, j);
+			matrix[j*nx + i] = std::isinf(val) ? unburnt : val;
+		}
+	}
+	base.putVar(matrix.data());
+}
+
+size_t ArrivalTimeSeries::record(){
+	double time = domain->getSimulationTime();
+	if ( file == 0 ) {
+		open(time);
+		vector<int> none;
+		vector<double> noData;
+		appendRecord(time, 0, none, none, noData);
+		return 0;
+	}
+
+	size_t revision = FDCell::getRevisionCounter();
+	vector<int> tileI, tileJ;
+	vector<double> data;
+	size_t tileValues = tileX*tileY;
+	FDCell** cells = domain->cells;
+	if ( revision > lastRevision ) {
+		for ( size_t ci = 0; ci < domain->atmoNX; ci++ ) {
+			for ( size_t cj = 0; cj < domain->atmoNY; cj++ ) {
+				if ( cells[ci][cj].getRevision() <= lastRevision ) continue;
+				tileI.push_back((int) ci);
+				tileJ.push_back((int) cj);
+				size_t offset = data.size();
+				data.resize(offset + tileValues, unburnt);
+				for ( size_t jj = 0; jj < tileY; jj++ ) {
+					for ( size_t ii = 0; ii < tileX; ii++ ) {
+						double val = domain->getArrivalTime(ci*tileX + ii, cj*tileY + jj);
+						if ( !std::isinf(val) ) data[offset + jj*tileX + ii] = val;
+					}
+				}
+			}
+		}
+	}
+	lastRevision = revision;
+	appendRecord(time, tileI.size(), tileI, tileJ, data);
+	return tileI.size();
+}
+
+void ArrivalTimeSeries::appendRecord(const double& time, const size_t& n
+		, const vector<int>& tileI, const vector<int>& tileJ, const vector<double>& data){
+	vector<size_t> rstart(1, numRecords);
+	vector<size_t> rcount(1, 1);
+	int first = (int) numTiles;
+	int count = (int) n;
+	file->getVar("time").putVar(rstart, rcount, &time);
+	file->getVar("first_tile").putVar(rstart, rcount, &first);
+	file->getVar("num_tiles").putVar(rstart, rcount, &count);
+	if ( n > 0 ) {
+		vector<size_t> tstart(1, numTiles);
+		vector<size_t> tcount(1, n);
+		file->getVar("tile_i").putVar(tstart, tcount, tileI.data());
+		file->getVar("tile_j").putVar(tstart, tcount, tileJ.data());
+		vector<size_t> dstart = {numTiles, 0, 0};
+		vector<size_t> dcount = {n, tileY, tileX};
+		file->getVar("tile_data").putVar(dstart, dcount, data.data());
+	}
+	numRecords++;
+	numTiles += n;
+	/* readers see the series as it grows */
+	file->sync();
+}
+
+bool ArrivalTimeSeries::getTimes(const string& fname, vector<double>& times){
+	try {
+		NcFile in(fname, NcFile::read);
+		size_t nrec = in.getDim("record").getSize();
+		times.resize(nrec);
+		if ( nrec > 0 ) in.getVar("time").getVar(times.data());
+		return true;
+	} catch (std::exception const & e) {
+		cout << "Error: unable to read arrival time series " << fname << ": " << e.what() << endl;
+	}
+	return false;
+}
+
+bool ArrivalTimeSeries::reconstruct(const string& fname, const double& time
+		, vector<double>& values, size_t& sizeX, size_t& sizeY, double& recordTime){
+	try {
+		NcFile in(fname, NcFile::read);
+		sizeX = in.getDim("DIMX").getSize();
+		sizeY = in.getDim("DIMY").getSize();
+		size_t tx = in.getDim("tile_x").getSize();
+		size_t ty = in.getDim("tile_y").getSize();
+		size_t nrec = in.getDim("record").getSize();
+
+		values.resize(sizeX*sizeY);
+		NcVar base = in.getVar("arrival_time_of_front");
+		base.getVar(values.data());
+		base.getAtt("time").getValues(&recordTime);
+		if ( nrec == 0 ) return true;
+
+		vector<double> times(nrec);
+		vector<int> first(nrec), count(nrec);
+		in.getVar("time").getVar(times.data());
+		in.getVar("first_tile").getVar(first.data());
+		in.getVar("num_tiles").getVar(count.data());
+
+		size_t last = 0;
+		while ( last + 1 < nrec and times[last + 1] <= time ) last++;
+		recordTime = times[last];
+		size_t ntiles = first[last] + count[last];
+		if ( ntiles == 0 ) return true;
+
+		vector<int> tileI(ntiles), tileJ(ntiles);
+		vector<size_t> tstart(1, 0);
+		vector<size_t> tcount(1, ntiles);
+		in.getVar("tile_i").getVar(tstart, tcount, tileI.data());
+		in.getVar("tile_j").getVar(tstart, tcount, tileJ.data());
+
+		/* applying the records in order, one record at a time */
+		NcVar data = in.getVar("tile_data");
+		vector<double> buffer;
+		for ( size_t r = 1; r <= last; r++ ) {
+			if ( count[r] == 0 ) continue;
+			buffer.resize(count[r]*ty*tx);
+			vector<size_t> dstart = {(size_t) first[r], 0, 0};
+			vector<size_t> dcount = {(size_t) count[r], ty, tx};
+			data.getVar(dstart, dcount, buffer.data());
+			for ( int t = 0; t < count[r]; t++ ) {
+				size_t i0 = tileI[first[r] + t]*tx;
+				size_t j0 = tileJ[first[r] + t]*ty;
+				const double* tile = &buffer[t*ty*tx];
+				for ( size_t jj = 0; jj < ty and j0 + jj < sizeY; jj++ ) {
+					for ( size_t ii = 0; ii < tx and i0 + ii < sizeX; ii++ ) {
+						values[(j0 + jj)*sizeX + i0 + ii] = tile[jj*tx + ii];
+					}
+				}
+			}
+		}
+		return true;
+	} catch (std::exception const & e) {
+		cout << "Error: unable to read arrival time series " << fname << ": " << e.what() << endl;
+	}
+	return false;
+}
+
+}
@@ -0,0 +1,86 @@
+/**
+ * @file ArrivalTimeSeries.h
+ * @brief Appendable NetCDF time series of the arrival time map, storing only the changed tiles.
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#ifndef ARRIVALTIMESERIES_H_
+#define ARRIVALTIMESERIES_H_
+
+#include <netcdf>
+#include "include/Futils.h"
+
+using namespace std;
+using namespace netCDF;
+using namespace netCDF::exceptions;
+
+namespace libforefire {
+
+class FireDomain;
+
+/*! \class ArrivalTimeSeries
+ * \brief Change-only records of the arrival time map in one opened file
+ *
+ *  The series keeps its NetCDF file opened for the whole run. The
+ *  first output writes a base snapshot of the arrival time map
+ *  ('arrival_time_of_front', same layout as the full output), then
+ *  each output appends a record made of the tiles that changed
+ *  since the previous one. Tiles are the burning maps of the
+ *  FDCells, changes being detected from their revision (see
+ *  FDCell::touch), so that the volume written at each output only
+ *  depends on the activity of the front.
+ *
+ *  Record 'r' is indexed by 'time[r]', 'first_tile[r]' and
+ *  'num_tiles[r]', its tiles being located by 'tile_i' and
+ *  'tile_j' and stored in 'tile_data'. The map at any recorded
+ *  time is reconstructed by applying all the records up to that
+ *  time on the base snapshot (see reconstruct()).
+ */
+class ArrivalTimeSeries {
+
+	FireDomain* domain; /*!< domain the series is recorded from */
+	string path; /*!< path of the file */
+	NcFile* file; /*!< file kept opened between outputs */
+
+	size_t nx; /*!< size of the map in the X direction */
+	size_t ny; /*!< size of the map in the Y direction */
+	size_t tileX; /*!< size of a tile in the X direction */
+	size_t tileY; /*!< size of a tile in the Y direction */
+
+	size_t numRecords; /*!< number of records written */
+	size_t numTiles; /*!< number of tiles written */
+	size_t lastRevision; /*!< revision counter at the last record */
+
+	/*! \brief creating the file and writing the base snapshot */
+	void open(const double&);
+	/*! \brief appending one record */
+	void appendRecord(const double&, const size_t&, const vector<int>&, const vector<int>&
+			, const vector<double>&);
+
+public:
+
+	/*! \brief Constructor from the domain and the path of the file */
+	ArrivalTimeSeries(FireDomain*, const string&);
+	/*! \brief destructor, closes the file */
+	~ArrivalTimeSeries();
+
+	/*! \brief writing the record of the current time, returns the number of tiles written */
+	size_t record();
+
+	const string& getPath(){ return path; }
+	size_t getNumRecords(){ return numRecords; }
+
+	/*! \brief times of the records of a series file */
+	static bool getTimes(const string&, vector<double>&);
+	/*! \brief arrival time map of a series file at the last record before a given time,
+	 * stored [j*nx + i] with -9999 for unburnt points */
+	static bool reconstruct(const string&, const double&, vector<double>&
+			, size_t&, size_t&, double&);
+
+};
+
+}
+
+#endif /* ARRIVALTIMESERIES_H_ */
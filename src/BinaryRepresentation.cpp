@@ -0,0 +1,218 @@
+/**
+ * @file BinaryRepresentation.cpp
+ * @brief Implements the binary 'FFFRONTS' representation of the fire fronts
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#include "BinaryRepresentation.h"
+#include <fstream>
+#include <cstring>
+#include <cmath>
+
+namespace libforefire {
+
+const char BinaryRepresentation::magic[8] = {'F','F','F','R','O','N','T','S'};
+const char BinaryRepresentation::recordTag[4] = {'F','R','E','C'};
+
+/* version of the format */
+static const uint32_t binaryVersion = 1;
+
+/* appending the bytes of a value */
+template<typename T> static void putValue(string& out, const T& val){
+	out.append(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+/* appending the bytes of an array */
+template<typename T> static void putArray(string& out, const T* vals, size_t n){
+	if ( n > 0 ) out.append(reinterpret_cast<const char*>(vals), n*sizeof(T));
+}
+
+/* appending a signed integer as a zigzag varint */
+static void putVarint(string& out, int64_t val){
+	uint64_t zz = (static_cast<uint64_t>(val) << 1) ^ static_cast<uint64_t>(val >> 63);
+	while ( zz >= 0x80 ) {
+		out.push_back(static_cast<char>((zz & 0x7F) | 0x80));
+		zz >>= 7;
+	}
+	out.push_back(static_cast<char>(zz));
+}
+
+BinaryRepresentation::BinaryRepresentation(FireDomain* fdom) : Visitor()
+	, domain(fdom), currentLevel(0), quantum(0.), recording(false) {
+	setTime(domain->getTime());
+	setUpdateTime(numeric_limits<double>::infinity());
+}
+
+BinaryRepresentation::~BinaryRepresentation() { }
+
+void BinaryRepresentation::input() { }
+void BinaryRepresentation::update() { }
+void BinaryRepresentation::timeAdvance() { }
+void BinaryRepresentation::output() { }
+
+void BinaryRepresentation::visit(FireDomain* fd) {
+	currentLevel = 0;
+	rings.clear();
+	openRings.assign(1, -1);
+	xs.clear();
+	ys.clear();
+	speeds.clear();
+	states.clear();
+}
+
+void BinaryRepresentation::postVisitInner(FireDomain* fd) { }
+void BinaryRepresentation::postVisitAll(FireDomain* fd) { }
+
+void BinaryRepresentation::visit(FireFront* ff) {
+	recording = ( currentLevel > 0 and ff->getDomain()->getSimulationTime() >= ff->getTime() );
+	if ( !recording ) return;
+	Ring ring;
+	ring.parent = openRings[currentLevel - 1];
+	ring.depth = static_cast<uint32_t>(currentLevel);
+	ring.first = xs.size();
+	ring.count = 0;
+	openRings[currentLevel] = static_cast<int32_t>(rings.size());
+	rings.push_back(ring);
+}
+
+void BinaryRepresentation::postVisitInner(FireFront* ff) {
+	recording = false;
+}
+
+void BinaryRepresentation::postVisitAll(FireFront* ff) { }
+
+void BinaryRepresentation::visit(FireNode* fn) {
+	if ( !recording ) return;
+	xs.push_back(fn->getX() - domain->SWCornerX());
+	ys.push_back(fn->getY() - domain->SWCornerY());
+	speeds.push_back(static_cast<float>(fn->getSpeed()));
+	states.push_back(static_cast<uint8_t>(fn->getState()));
+	rings.back().count++;
+}
+
+void BinaryRepresentation::increaseLevel() {
+	currentLevel++;
+	if ( openRings.size() < currentLevel + 1 ) openRings.resize(currentLevel + 1, -1);
+	/* inner fronts of a front without nodes keep the enclosing ring as parent */
+	openRings[currentLevel] = openRings[currentLevel - 1];
+}
+
+void BinaryRepresentation::decreaseLevel() {
+	currentLevel--;
+}
+
+size_t BinaryRepresentation::getLevel() {
+	return currentLevel;
+}
+
+void BinaryRepresentation::encodeHeader(string& out) {
+	/* the encoding is fixed for all the records of a stream */
+	quantum = SimulationParameters::GetInstance()->getDouble("binaryFrontQuantum");
+	if ( !(quantum > 0.) ) quantum = 0.;
+	out.append(magic, sizeof(magic));
+	putValue(out, binaryVersion);
+	uint32_t encoding = ( quantum > 0. ) ? 1 : 0;
+	putValue(out, encoding);
+	putValue(out, quantum);
+	putValue(out, domain->SWCornerX());
+	putValue(out, domain->SWCornerY());
+	putValue(out, domain->getRefLongitude());
+	putValue(out, domain->getRefLatitude());
+	putValue(out, domain->getMetersPerDegreesLon());
+	putValue(out, domain->getMetersPerDegreeLat());
+	SimulationParameters* simParam = SimulationParameters::GetInstance();
+	int32_t refYear = simParam->getInt("refYear");
+	int32_t refDay = simParam->getInt("refDay");
+	putValue(out, refYear);
+	putValue(out, refDay);
+	double refTime = simParam->getInt("refTime");
+	putValue(out, refTime);
+}
+
+void BinaryRepresentation::encodeRecord(string& out) {
+	domain->accept(this);
+
+	/* coordinates of each ring */
+	vector<string> coords(rings.size());
+	vector<float> pairs;
+	uint64_t payload = 16*rings.size() + 5*xs.size();
+	for ( size_t r = 0; r < rings.size(); r++ ) {
+		const Ring& ring = rings[r];
+		string& block = coords[r];
+		if ( quantum > 0. ) {
+			block.reserve(4*ring.count);
+			int64_t px = 0;
+			int64_t py = 0;
+			for ( size_t n = ring.first; n < ring.first + ring.count; n++ ) {
+				int64_t qx = llround(xs[n]/quantum);
+				int64_t qy = llround(ys[n]/quantum);
+				putVarint(block, qx - px);
+				putVarint(block, qy - py);
+				px = qx;
+				py = qy;
+			}
+		} else {
+			pairs.resize(2*ring.count);
+			for ( size_t n = 0; n < ring.count; n++ ) {
+				pairs[2*n] = static_cast<float>(xs[ring.first + n]);
+				pairs[2*n + 1] = static_cast<float>(ys[ring.first + n]);
+			}
+			putArray(block, pairs.data(), pairs.size());
+		}
+		payload += block.size();
+	}
+
+	out.reserve(out.size() + 32 + payload);
+	out.append(recordTag, sizeof(recordTag));
+	uint32_t numRings = static_cast<uint32_t>(rings.size());
+	putValue(out, numRings);
+	double time = domain->getSimulationTime();
+	putValue(out, time);
+	uint64_t numNodes = xs.size();
+	putValue(out, numNodes);
+	putValue(out, payload);
+
+	for ( size_t r = 0; r < rings.size(); r++ ) {
+		putValue(out, rings[r].parent);
+		putValue(out, rings[r].depth);
+		uint32_t count = static_cast<uint32_t>(rings[r].count);
+		putValue(out, count);
+		uint32_t bytes = static_cast<uint32_t>(coords[r].size());
+		putValue(out, bytes);
+	}
+	for ( size_t r = 0; r < rings.size(); r++ ) {
+		out.append(coords[r]);
+		putArray(out, speeds.data() + rings[r].first, rings[r].count);
+		putArray(out, states.data() + rings[r].first, rings[r].count);
+	}
+}
+
+string BinaryRepresentation::dumpBinaryRepresentation() {
+	string out;
+	encodeHeader(out);
+	encodeRecord(out);
+	return out;
+}
+
+bool BinaryRepresentation::appendRecord(const string& path) {
+	string out;
+	bool restart = ( path != streamPath );
+	if ( restart ) encodeHeader(out);
+	encodeRecord(out);
+	ofstream file(path.c_str(), restart ? (ios::binary | ios::trunc) : (ios::binary | ios::app));
+	if ( !file ) {
+		cout << "could not open file " << path << " for writing fronts" << endl;
+		return false;
+	}
+	file.write(out.data(), out.size());
+	streamPath = path;
+	return true;
+}
+
+string BinaryRepresentation::toString() {
+	return "binary representation";
+}
+
+}
@@ -0,0 +1,112 @@
+/**
+ * @file BinaryRepresentation.h
+ * @brief Compact binary, appendable representation of the fire fronts.
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#ifndef BINARYREPRESENTATION_H_
+#define BINARYREPRESENTATION_H_
+
+#include <stdint.h>
+#include "Visitor.h"
+#include "SimulationParameters.h"
+#include "include/Futils.h"
+
+namespace libforefire {
+
+/*! \class BinaryRepresentation
+ * \brief Visitor encoding the fronts in the binary 'FFFRONTS' format
+ *
+ *  A stream starts with an 88 bytes header (magic "FFFRONTS",
+ *  version, coordinate encoding, quantum, origin of the
+ *  coordinates, projection and reference date) followed by one
+ *  record per output time. A record is made of a 32 bytes header
+ *  (tag "FREC", number of rings, simulation time, number of nodes,
+ *  size of the rest of the record), a table of 16 bytes per ring
+ *  (index of the parent ring or -1, depth, number of nodes, size of
+ *  the coordinates) and, for each ring, its coordinates, the speed
+ *  of its nodes as float32 and their state as one byte.
+ *
+ *  Coordinates are relative to the south-west corner of the domain,
+ *  either as float32 (x,y) pairs, or, when the 'binaryFrontQuantum'
+ *  parameter is positive, as zigzag varint deltas of positions
+ *  quantized by that quantum. Values are in the byte order of the
+ *  writer, little endian on all supported platforms.
+ *
+ *  Records are appended to the same stream at each output time,
+ *  the format being decoded by pyforefire.helpers.read_binary_fronts.
+ */
+class BinaryRepresentation: public Visitor {
+
+	/*! \brief ring of the current snapshot */
+	struct Ring {
+		int32_t parent; /*!< index of the enclosing ring, -1 for top level fronts */
+		uint32_t depth; /*!< level of the front in the hierarchy, 1 for top level */
+		size_t first; /*!< first node of the ring in the node arrays */
+		size_t count; /*!< number of nodes of the ring */
+	};
+
+	FireDomain* domain; /*!< domain to represent */
+	size_t currentLevel; /*!< level of the front being visited */
+	double quantum; /*!< quantization step of the coordinates, 0 for float32 */
+
+	vector<Ring> rings; /*!< rings of the current snapshot */
+	vector<int32_t> openRings; /*!< ring being visited at each level */
+	bool recording; /*!< nodes of the visited front are recorded */
+	vector<double> xs; /*!< x coordinates of the nodes, relative to the origin */
+	vector<double> ys; /*!< y coordinates of the nodes, relative to the origin */
+	vector<float> speeds; /*!< speeds of the nodes */
+	vector<uint8_t> states; /*!< states of the nodes */
+
+	string streamPath; /*!< file the records are appended to */
+
+	/*! \brief encoding of the stream header, fixing the coordinate encoding */
+	void encodeHeader(string&);
+	/*! \brief encoding of the record of the current fronts */
+	void encodeRecord(string&);
+
+public:
+
+	static const char magic[8]; /*!< stream signature */
+	static const char recordTag[4]; /*!< record signature */
+
+	BinaryRepresentation(FireDomain*);
+	virtual ~BinaryRepresentation();
+
+	/* making the 'update()', 'timeAdvance()' and 'accept()'
+	 * virtual functions of 'ForeFireAtom' not virtual */
+	void input();
+	void update();
+	void timeAdvance();
+	void output();
+
+	size_t getLevel();
+
+	/* Visitors of the elements */
+	void visit(FireDomain*);
+	void postVisitInner(FireDomain*);
+	void postVisitAll(FireDomain*);
+
+	void visit(FireFront*);
+	void postVisitInner(FireFront*);
+	void postVisitAll(FireFront*);
+
+	void visit(FireNode*);
+
+	void increaseLevel();
+	void decreaseLevel();
+
+	/*! \brief stand-alone stream (header and one record) of the current fronts */
+	string dumpBinaryRepresentation();
+	/*! \brief appending the record of the current fronts to a stream file,
+	 * the file being started over the first time it is written by this object */
+	bool appendRecord(const string&);
+
+	string toString();
+};
+
+}
+
+#endif /* BINARYREPRESENTATION_H_ */
@@ -7,6 +7,9 @@
  */
 
 #include "BurningMap.h"
+#include "Logger.h"
+#include <cmath>
+#include <cstring>
 
 namespace libforefire {
 
@@ -20,14 +23,25 @@ BurningMap::BurningMap() {
 	sizeX = 1;
 	sizeY = 1;
 	arrivalTimeMap = 0;
+	relativeTimeMap = 0;
+	epoch = 0.;
+	hasEpoch = false;
+	packed = 0;
+	single = false;
 }
 
 BurningMap::
 BurningMap(const FFPoint& sw, const FFPoint& ne
-		, const size_t& nx, const size_t& ny) :
-sizeX(nx), sizeY(ny), SWCorner(sw), NECorner(ne) {
+		, const size_t& nx, const size_t& ny, bool single) :
+sizeX(nx), sizeY(ny), SWCorner(sw), NECorner(ne)
+, arrivalTimeMap(0), relativeTimeMap(0), epoch(0.), hasEpoch(false)
+, packed(0), single(single) {
 	try {
-		arrivalTimeMap = new FFArray<double>("ArrivalTime", numeric_limits<double>::infinity(), sizeX, sizeY);
+		if ( single ){
+			relativeTimeMap = new FFArray<float>("ArrivalTime", numeric_limits<float>::infinity(), sizeX, sizeY);
+		} else {
+			arrivalTimeMap = new FFArray<double>("ArrivalTime", numeric_limits<double>::infinity(), sizeX, sizeY);
+		}
 		
 		dx = ( NECorner.getX()-SWCorner.getX() )/sizeX;
 		dy = ( NECorner.getY()-SWCorner.getY() )/sizeY;
@@ -40,45 +54,221 @@ sizeX(nx), sizeY(ny), SWCorner(sw), NECorner(ne) {
 
 BurningMap::~BurningMap() {
 	delete arrivalTimeMap;
+	delete relativeTimeMap;
+	delete packed;
 }
 
 // Operators
 double BurningMap::operator ()(size_t i, size_t j) const {
 	if ( i >= sizeX or j >= sizeY ){
-		cout << "Array subscript out of bounds when reading a value" << endl;
-                return (*arrivalTimeMap)(0,0);
+		FF_WARNING(layer, "Array subscript out of bounds when reading a value");
+		i = 0;
+		j = 0;
 	}
+	if ( packed ) return unpack(i*sizeY + j);
+	if ( relativeTimeMap ) return epoch + (*relativeTimeMap)(i,j);
 	return (*arrivalTimeMap)(i,j);
 }
 
-double& BurningMap::operator ()(size_t i, size_t j){
+double BurningMap::unpack(const size_t& k) const {
+	uint32_t code;
+	if ( !packed->codes8.empty() ){
+		code = packed->codes8[k];
+	} else if ( !packed->codes16.empty() ){
+		code = packed->codes16[k];
+	} else {
+		code = packed->codes32[k];
+	}
+	return epoch + code*packed->quantum;
+}
+
+void BurningMap::set(size_t i, size_t j, const double& time){
 	if ( i >= sizeX or j >= sizeY ){
-		cout << "Array subscript out of bounds when writing a value" << endl;
-                return (*arrivalTimeMap)(0,0);
+		FF_WARNING(layer, "Array subscript out of bounds when writing a value");
+		i = 0;
+		j = 0;
 	}
-	return (*arrivalTimeMap)(i,j);
+	expand();
+	if ( relativeTimeMap ){
+		if ( !hasEpoch and std::isfinite(time) ) setEpoch(time);
+		(*relativeTimeMap)(i,j) = relative(time);
+		return;
+	}
+	(*arrivalTimeMap)(i,j) = time;
+}
+
+float BurningMap::relative(const double& time) const {
+	/* rounding towards the past, a point burnt at a given time
+	 * is then seen as burning from that time on */
+	float rel = (float) (time - epoch);
+	if ( epoch + rel > time ) rel = nextafterf(rel, -numeric_limits<float>::infinity());
+	return rel;
+}
+
+void BurningMap::setEpoch(const double& t){
+	/* values already stored are brought to the new epoch */
+	float* data = relativeTimeMap->getData();
+	size_t size = relativeTimeMap->getSize();
+	double previous = epoch;
+	epoch = t;
+	hasEpoch = true;
+	for ( size_t k = 0; k < size; k++ ){
+		if ( std::isfinite(data[k]) ) data[k] = relative(previous + data[k]);
+	}
+}
+
+void BurningMap::setVal(const double* vals){
+	expand();
+	if ( arrivalTimeMap ){
+		arrivalTimeMap->setVal(vals);
+		return;
+	}
+	/* the epoch is taken as the earliest arrival time of the map */
+	size_t size = relativeTimeMap->getSize();
+	double first = numeric_limits<double>::infinity();
+	for ( size_t k = 0; k < size; k++ ){
+		if ( std::isfinite(vals[k]) and vals[k] < first ) first = vals[k];
+	}
+	hasEpoch = std::isfinite(first);
+	epoch = hasEpoch ? first : 0.;
+	float* data = relativeTimeMap->getData();
+	for ( size_t k = 0; k < size; k++ ) data[k] = relative(vals[k]);
+}
+
+void BurningMap::fill(const double& val){
+	expand();
+	if ( arrivalTimeMap ){
+		arrivalTimeMap->fill(val);
+		return;
+	}
+	hasEpoch = std::isfinite(val);
+	epoch = hasEpoch ? val : 0.;
+	relativeTimeMap->fill(relative(val));
+}
+
+void BurningMap::copyTo(double* vals){
+	if ( packed ){
+		for ( size_t k = 0; k < sizeX*sizeY; k++ ) vals[k] = unpack(k);
+		return;
+	}
+	if ( arrivalTimeMap ){
+		memcpy(vals, arrivalTimeMap->getData(), arrivalTimeMap->getSize()*sizeof(double));
+		return;
+	}
+	float* data = relativeTimeMap->getData();
+	size_t size = relativeTimeMap->getSize();
+	for ( size_t k = 0; k < size; k++ ) vals[k] = epoch + data[k];
 }
 
+size_t BurningMap::getStorageSize(){
+	if ( packed ) return sizeof(PackedTimes) + packed->codes8.size()*sizeof(uint8_t)
+			+ packed->codes16.size()*sizeof(uint16_t) + packed->codes32.size()*sizeof(uint32_t);
+	if ( relativeTimeMap ) return relativeTimeMap->getSize()*sizeof(float);
+	if ( arrivalTimeMap ) return arrivalTimeMap->getSize()*sizeof(double);
+	return 0;
+}
 
+bool BurningMap::compress(const double& q){
+	if ( !(q > 0.) or packed ) return false;
+	size_t size = sizeX*sizeY;
+	vector<double> vals(size);
+	copyTo(vals.data());
+	double first = numeric_limits<double>::infinity();
+	double last = -first;
+	for ( size_t k = 0; k < size; k++ ){
+		if ( !std::isfinite(vals[k]) ) return false;
+		first = min(first, vals[k]);
+		last = max(last, vals[k]);
+	}
+	/* the narrowest integers holding the span of the arrival times */
+	double span = (last - first)/q;
+	if ( !(span < 4294967295.) ) return false;
+	size_t width = ( span < 255. ) ? 1 : ( ( span < 65535. ) ? 2 : 4 );
+	/* maps of a few points are not worth it */
+	if ( sizeof(PackedTimes) + size*width >= getStorageSize() ) return false;
+	packed = new PackedTimes;
+	packed->quantum = q;
+	if ( width == 1 ){
+		packed->codes8.resize(size);
+	} else if ( width == 2 ){
+		packed->codes16.resize(size);
+	} else {
+		packed->codes32.resize(size);
+	}
+	epoch = first;
+	hasEpoch = true;
+	for ( size_t k = 0; k < size; k++ ){
+		/* rounding towards the past, as for single precision */
+		double code = floor((vals[k] - first)/q);
+		if ( code > 0. and first + code*q > vals[k] ) code -= 1.;
+		if ( !packed->codes8.empty() ){
+			packed->codes8[k] = (uint8_t) code;
+		} else if ( !packed->codes16.empty() ){
+			packed->codes16[k] = (uint16_t) code;
+		} else {
+			packed->codes32[k] = (uint32_t) code;
+		}
+	}
+	delete arrivalTimeMap;
+	arrivalTimeMap = 0;
+	delete relativeTimeMap;
+	relativeTimeMap = 0;
+	return true;
+}
 
-FFArray<double>* BurningMap::getMap(){
-	return arrivalTimeMap;
+void BurningMap::expand(){
+	if ( !packed ) return;
+	vector<double> vals(sizeX*sizeY);
+	copyTo(vals.data());
+	delete packed;
+	packed = 0;
+	if ( single ){
+		relativeTimeMap = new FFArray<float>("ArrivalTime", numeric_limits<float>::infinity(), sizeX, sizeY);
+	} else {
+		arrivalTimeMap = new FFArray<double>("ArrivalTime", numeric_limits<double>::infinity(), sizeX, sizeY);
+	}
+	setVal(vals.data());
 }
 
 // Mutators
 void BurningMap::loadBin(std::ifstream&  FileIn){
+	expand();
+	if ( arrivalTimeMap ){
+		arrivalTimeMap->loadBin(FileIn);
+		return;
+	}
+	/* binary files always hold double precision values */
+	size_t dims[4];
+	FileIn.read((char *)dims, 4*sizeof(size_t));
+	if ( dims[0] != sizeX or dims[1] != sizeY ){
+		cout << "LOADING  NOT good dimentions in burning map " << sizeX*sizeY
+				<< "::" << dims[0]*dims[1] << endl;
+		return;
+	}
+	vector<double> vals(sizeX*sizeY);
+	FileIn.read((char *)vals.data(), vals.size()*sizeof(double));
+	setVal(vals.data());
+}
 
-		arrivalTimeMap->loadBin(	FileIn);
- 
-	
+void BurningMap::dumpBin(std::ofstream&  FileOut){
+	if ( arrivalTimeMap ){
+		arrivalTimeMap->dumpBin(FileOut);
+		return;
+	}
+	size_t dims[4] = {sizeX, sizeY, 1, 1};
+	FileOut.write(reinterpret_cast<const char*>(dims), 4*sizeof(size_t));
+	vector<double> vals(sizeX*sizeY);
+	copyTo(vals.data());
+	FileOut.write(reinterpret_cast<const char*>(vals.data()), vals.size()*sizeof(double));
 }
+
 void BurningMap::setBurning(FFPoint& p, const double& time){
 	// finding the indices in the burning matrix
 	int kx = int((p.getX()-SWCorner.getX())/dx);
 	int ky = int((p.getY()-SWCorner.getY())/dy);
-	if ( (*arrivalTimeMap)(kx,ky) == 0. ){
+	if ( (*this)(kx,ky) == 0. ){
 		// set the time of the end of burning in that cell
-		(*arrivalTimeMap)(kx,ky,time);
+		set(kx, ky, time);
 	}
 }
 
@@ -87,7 +277,7 @@ bool BurningMap::nothingBurning(const double& time){
 	double burningTime = 30.;
 	for ( size_t i = 0; i < sizeX; i++ ) {
 		for ( size_t j = 0; j < sizeY; j++ ) {
-			if ( abs(time-(*arrivalTimeMap)(i,j)) < burningTime ) return false;
+			if ( abs(time-(*this)(i,j)) < burningTime ) return false;
 		}
 	}
 	return true;
@@ -99,7 +289,7 @@ double BurningMap::maxTime(){
 	double myMax = -9999;
 	for ( size_t i = 0; i < sizeX; i++ ) {
 		for ( size_t j = 0; j < sizeY; j++ ) {
-			myMax = max((*arrivalTimeMap)(i,j),myMax);
+			myMax = max((*this)(i,j),myMax);
 			 if(myMax == infHere) return infHere;
 		}
 	}
@@ -130,7 +320,7 @@ string BurningMap::toString(const double& time){
 	ostringstream oss;
 	for (size_t i=0;i<sizeX;i++){
 		for (size_t j=0;j<sizeY;j++){
-			if ( (*arrivalTimeMap)(i,j)-time > 0. ) {
+			if ( (*this)(i,j)-time > 0. ) {
 				oss << 1 << " ";
 			} else {
 				oss << 0 << " ";
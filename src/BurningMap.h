@@ -13,6 +13,7 @@
 #include "FFPoint.h"
 #include "FFArrays.h"
 #include "include/FFConstants.h"
+#include <stdint.h>
 
 using namespace std;
 
@@ -25,6 +26,20 @@ namespace libforefire
  *  BurningMap defines the eulerian matrix of arrival times to localize
  *  the burning area and compute the resulting fluxes.
  *
+ *  Arrival times can be stored in single precision ('burningMapPrecision'
+ *  set to 'float'), halving the memory of the map. They are then kept
+ *  relative to an epoch, the first finite arrival time written in the
+ *  map, so that the resolution of the stored times stays below 0.01s
+ *  for fires lasting up to a day, rounded towards the past so that a
+ *  point is never seen as burning later than it was burnt. Values are
+ *  always read and written in double precision.
+ *
+ *  Once all its points are burnt, a map can be compressed: arrival
+ *  times are then stored as the number of time quanta elapsed since the
+ *  earliest one, on 1, 2 or 4 bytes depending on the span of the
+ *  arrival times of the map, and rounded towards the past so that the
+ *  error stays below a quantum. Compressed maps are read in place, the
+ *  first write bringing them back to their original precision.
  */
 class BurningMap
 {
@@ -34,6 +49,29 @@ class BurningMap
 	double dx, dy; /*!< spatial resolution of burning matrix */
 
 	FFArray<double>* arrivalTimeMap; /*!< matrix of the arrival times of the fire */
+	FFArray<float>* relativeTimeMap; /*!< single precision arrival times, relative to the epoch */
+	double epoch; /*!< origin of the single precision and compressed arrival times */
+	bool hasEpoch; /*!< whether the epoch has been set */
+
+	/*! \brief compressed arrival times, in quanta after the epoch */
+	struct PackedTimes {
+		vector<uint8_t> codes8; /*!< codes of the maps spanning less than 255 quanta */
+		vector<uint16_t> codes16; /*!< codes of the maps spanning less than 65535 quanta */
+		vector<uint32_t> codes32; /*!< codes of the larger spans */
+		double quantum; /*!< time quantum */
+	};
+	PackedTimes* packed; /*!< compressed arrival times, null when not compressed */
+	bool single; /*!< precision to restore when writing in a compressed map */
+
+	/*! \brief compressed arrival time at a given index */
+	double unpack(const size_t&) const;
+	/*! \brief bringing a compressed map back to its original precision */
+	void expand();
+
+	/*! \brief single precision time relative to the epoch, not after the given time */
+	float relative(const double&) const;
+	/*! \brief setting the epoch of the single precision map */
+	void setEpoch(const double&);
 
 public:
 
@@ -41,7 +79,7 @@ public:
 	BurningMap();
 	/*! \brief Constructor with specified corner points and spatial resolution */
 	BurningMap(const FFPoint&, const FFPoint&
-			, const size_t&, const size_t&);
+			, const size_t&, const size_t&, bool = false);
 	/*! \brief Destructor */
 	virtual
 	~BurningMap();
@@ -49,10 +87,22 @@ public:
 	/*!  \brief accessor of the data contained at position (i,j)  */
 	double operator() (size_t, size_t = 0) const;
 	/*!  \brief mutator of the data contained at position (i,j)  */
-	double& operator() (size_t, size_t = 0);
-
-	/*!  \brief pointer to the data of the matrix of arrival times */
-	FFArray<double>* getMap();
+	void set(size_t, size_t, const double&);
+
+	/*!  \brief mutator of the entire data  */
+	void setVal(const double*);
+	/*!  \brief setting all the arrival times to a given value  */
+	void fill(const double&);
+	/*!  \brief copying the arrival times in double precision  */
+	void copyTo(double*);
+	/*!  \brief whether the arrival times are stored in single precision  */
+	bool singlePrecision(){ return relativeTimeMap != 0; }
+	/*!  \brief memory used by the arrival times (bytes)  */
+	size_t getStorageSize();
+	/*!  \brief compressing a fully burnt map with a given time quantum  */
+	bool compress(const double&);
+	/*!  \brief whether the arrival times are compressed  */
+	bool compressed(){ return packed != 0; }
 
 	/*!  \brief getters of the sizes of the matrix of arrival times */
 	size_t getSizeX();
@@ -63,6 +113,8 @@ public:
 	double getDy();
 	double maxTime();
 	void loadBin(std::ifstream&  );
+	/*!  \brief writing the arrival times in double precision, as FFArray::dumpBin */
+	void dumpBin(std::ofstream&  );
 	/*!  \brief getters of the location of the center of a given cell */
 	FFPoint getCenter(const size_t&, const size_t&);
 
@@ -11,6 +11,7 @@
 
 #include "DataLayer.h"
 #include "FireDomain.h"
+#include "Logger.h"
 
 namespace libforefire {
 
@@ -68,6 +69,8 @@ public:
 	void setValueAt(FFPoint loc,  double tval, T value){};
 	/*! \brief getter to the pointer on the FFArray */
 	void getMatrix(FFArray<T>**, const double&);
+	/*! \brief memory held by the layer (bytes) */
+	size_t getMemorySize(){ return this->arrayMemory(arrivalTimes); }
 	/*! \brief stores data from a fortran array into the FFArray */
 	void setMatrix(string&, double*, const size_t&, size_t&, const double&);
 
@@ -130,7 +133,7 @@ T BurningMapLayer<T>::getNearestData(FFPoint loc){
 template<typename T>
 void BurningMapLayer<T>::getMatrix(
 		FFArray<T>** matrix, const double& t){
-			cout << "getting matrix lmayer  "<<nx<<"BMAPS"<<ny<<endl;
+			FF_DEBUG(layer, "getting matrix lmayer  "<<nx<<"BMAPS"<<ny);
 	/*if ( t != latestCall ){
 
 		for ( size_t i=0; i < nx; i++ ){
@@ -150,8 +153,8 @@ void BurningMapLayer<T>::setMatrix(string& mname, double* inMatrix
 	if ( arrivalTimes->getSize() == sizein ){
 		arrivalTimes->copyDataFromFortran(inMatrix);
 	} else {
-		cout<<"Error while trying to retrieve data for data layer "
-				<<this->getKey()<<", matrix size not matching";
+		FF_ERROR(layer, "Error while trying to retrieve data for data layer "
+				<<this->getKey()<<", matrix size not matching");
 	}
 }
 
@@ -12,6 +12,7 @@
 #include "DataLayer.h"
 #include "FDCell.h"
 #include "FFPoint.h"
+#include "Logger.h"
 
 using namespace std;
 
@@ -72,6 +73,8 @@ public:
 	void setValueAt(FFPoint loc,  double tval, T value){};
 	/*! \brief getter to the pointer on the FFArray */
 	void getMatrix(FFArray<T>**, const double&);
+	/*! \brief memory held by the layer (bytes) */
+	size_t getMemorySize(){ return this->arrayMemory(ratioMap); }
 	/*! \brief stores data from a fortran array into the FFArray */
 	void setMatrix(string&, double*, const size_t&, size_t&, const double&);
 
@@ -122,8 +125,8 @@ size_t BurningRatioLayer<T>::getValuesAt(FFPoint loc, const double& t
 
 template<typename T>
 T BurningRatioLayer<T>::getNearestData(FFPoint loc){
-	cout<<"BurningRatioLayer<T>::getNearestData() "
-			<<"shouldn't have been called"<<endl;
+	FF_WARNING(layer, "BurningRatioLayer<T>::getNearestData() "
+			<<"shouldn't have been called");
 	return 0.;
 }
 
@@ -161,8 +164,8 @@ void BurningRatioLayer<T>::setMatrix(string& mname, double* inMatrix
 	if ( ratioMap->getSize() == sizein ){
 		ratioMap->copyDataFromFortran(inMatrix);
 	} else {
-		cout<<"Error while trying to retrieve data for data layer "
-				<<this->getKey()<<", matrix size not matching";
+		FF_ERROR(layer, "Error while trying to retrieve data for data layer "
+				<<this->getKey()<<", matrix size not matching");
 	}
 }
 
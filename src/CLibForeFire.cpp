@@ -10,6 +10,11 @@
 #include "SimulationParameters.h"
 #include <cmath>
 #include <random>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <map>
+#include <set>
 
 #ifdef MPI_COUPLING
 #include <mpi.h>
@@ -41,6 +46,49 @@ double updateBinStreamFrequency = 10;
 double updateOutputFrequency = 0;
 
 
+/* Lagged coupling ('laggedCoupling' parameter): the fire step of an
+ * atmospheric step runs on a worker thread while the atmospheric model
+ * integrates, the fluxes handed back to it being those of the previous
+ * fire step. Every entry point touching the domain waits for the running
+ * step first, so the wind layers are only written once the fire step that
+ * reads them is over. The flux outputs are double buffered: the worker
+ * fills the back buffers at the end of its step, and they are swapped with
+ * the front buffers read by FFPutDoubleArray when the next step starts.
+ * MPI calls are all made by the calling thread. */
+static struct LaggedStep {
+	thread worker; /* fire step running behind the atmospheric model */
+	bool active; /* whether the fluxes are read from the front buffers */
+	set<string> outputs; /* flux layers requested by the atmospheric model */
+	map<string, vector<double> > front; /* fluxes handed back, Fortran ordered */
+	map<string, vector<double> > back; /* fluxes of the running step */
+	LaggedStep() : active(false) {}
+	~LaggedStep(){ sync(); }
+	void sync(){ if ( worker.joinable() ) worker.join(); }
+} lagged;
+
+/* Copying the current matrix of a layer in Fortran order */
+static void captureOutput(const string& name, vector<double>& buf){
+	DataLayer<double>* layer = session->fd->getDataLayer(name);
+	if ( layer == 0 ) return;
+	FFArray<double>* matrix;
+	layer->getMatrix(&matrix, executor.getTime());
+	buf.resize(matrix->getSize());
+	matrix->copyDataToFortran(buf.data());
+}
+
+/* Body of the worker: the fire step, then the fluxes at its end */
+static void laggedStep(string cmd){
+	try {
+		executor.ExecuteCommand(cmd);
+		for ( set<string>::iterator name = lagged.outputs.begin();
+				name != lagged.outputs.end(); ++name ){
+			captureOutput(*name, lagged.back[*name]);
+		}
+	} catch (...) {
+		cout<<"WARNING: lagged fire step "<<cmd<<" failed"<<endl;
+	}
+}
+
 Command* getLauncher(){
 	return &executor;
 }
@@ -266,6 +314,7 @@ void MNHCreateDomain(const int id
 }
 
 void CheckLayer(const char* lname){
+	lagged.sync();
 	string tmpname(lname);
 	// searching for concerned layer
 	
@@ -283,6 +332,10 @@ void CheckLayer(const char* lname){
 
 void MNHStep(double dt){
 
+	/* the previous fire step has to be over before exchanging burning maps */
+	lagged.sync();
+	bool lag = ( SimulationParameters::GetInstance()->getInt("laggedCoupling") != 0 );
+
 	#ifdef MPI_COUPLING
 		size_t sizeofcell = session->fd->getlocalBMapSize();
 		updateBinStreamFrequency = SimulationParameters::GetInstance()->getDouble("updateBinStreamFrequency");
@@ -291,88 +344,92 @@ void MNHStep(double dt){
 
 		if (world_rank == 0) {
 
-			
 			FDCell** mycells = session->fdp->getCells();
-			size_t domainID =  1;
-			FireDomain::distributedDomainInfo* domainInfo = session->fdp->getParallelDomainInfo(domainID);
-			size_t anx = domainInfo->atmoNX;
-			size_t any = domainInfo->atmoNY;
-			size_t rnx = domainInfo->refNX;
-			size_t rny = domainInfo->refNY;
-			// counting all active cells to be sent
-			for(size_t i = rnx; i < rnx + anx; ++i){
-				for(size_t j = rny; j < rny + any; ++j){
-					if(mycells[i][j].isActiveForDump()){
-						FFArray<double>* SRCburningMap = mycells[i][j].getBurningMap()->getMap();
-						session->fd->getCells()[i - rnx][j - rny].setBMapValues(SRCburningMap->getData());
-					//	cout << "sending Active cell found at (" << i << ", " << j << ")" << std::endl;
-						//mycells[i][j].setIfAllDumped();
+			// counting the active cells to be sent to each rank, rank nr
+			// getting the cells of the dispatch domain nr+1
+			vector<int32_t> numberOfActiveCells(world_size, 0);
+			for (int nr = 0; nr < world_size; ++nr) {
+				FireDomain::distributedDomainInfo* domainInfo = session->fdp->getParallelDomainInfo(nr + 1);
+				for (size_t i = domainInfo->refNX; i < domainInfo->refNX + domainInfo->atmoNX; ++i) {
+					for (size_t j = domainInfo->refNY; j < domainInfo->refNY + domainInfo->atmoNY; ++j) {
+						if (mycells[i][j].isActiveForDump()) {
+							numberOfActiveCells[nr]++;
+						}
 					}
 				}
 			}
-		
+
+			vector<vector<char> > BMAP_DATA_to_send(world_size);
+			vector<MPI_Request> requests;
+			requests.reserve(2*world_size);
+			vector<double> cellVals(sizeofcell);
 			for (int nr = 1; nr < world_size; ++nr) {
-				// Send the number of active cells to each rank depending on which subdomain they are, first the number of active cells per domain
-				domainID = nr + 1;
-				int32_t numberOfActiveCells = 0;//session->fdp->countActiveCellsInDispatchDomain(domainID);
-				FireDomain::distributedDomainInfo* domainInfo = session->fdp->getParallelDomainInfo(domainID);
+				FireDomain::distributedDomainInfo* domainInfo = session->fdp->getParallelDomainInfo(nr + 1);
 				size_t anx = domainInfo->atmoNX;
 				size_t any = domainInfo->atmoNY;
 				size_t rnx = domainInfo->refNX;
 				size_t rny = domainInfo->refNY;
-				// Iterate over the cells within the specified domain
-				for (size_t i = rnx; i < rnx + anx; ++i) {
-					for (size_t j = rny; j < rny + any; ++j) {
-						if (mycells[i][j].isActiveForDump()) {
-							numberOfActiveCells++;
-						}
-					}
-				}
-			
-				MPI_Send(&numberOfActiveCells, 1, MPI_INT32_T, nr, 0, MPI_COMM_WORLD);
+				MPI_Request request;
+				MPI_Isend(&numberOfActiveCells[nr], 1, MPI_INT32_T, nr, 0, MPI_COMM_WORLD, &request);
+				requests.push_back(request);
 				// Send the data of the active cells
-				if (numberOfActiveCells>0){
-					size_t totalBytes = numberOfActiveCells * (2 * sizeof(int32_t) + sizeofcell * sizeof(double));
-					std::vector<char> BMAP_DATA_to_send(totalBytes);
+				if (numberOfActiveCells[nr]>0){
+					size_t totalBytes = numberOfActiveCells[nr] * (2 * sizeof(int32_t) + sizeofcell * sizeof(double));
+					BMAP_DATA_to_send[nr].resize(totalBytes);
+					char* buffer = BMAP_DATA_to_send[nr].data();
 					size_t offset = 0;
 					// Iterate through the cells and serialize active cell data
-						for(size_t i = rnx; i < rnx + anx; ++i){
-							for(size_t j = rny; j < rny + any; ++j){
-								if(mycells[i][j].isActiveForDump()){
-									// Extract local indices
-									int32_t localx = static_cast<int32_t>(i - rnx);
-									int32_t localy = static_cast<int32_t>(j - rny);
-									// Extract cell data
-									FFArray<double>* burningMap =  session->fdp->getCells()[i][j].getBurningMap()->getMap();
-									// Serialize localx
-									memcpy(BMAP_DATA_to_send.data() + offset, &localx, sizeof(int32_t));
-									offset += sizeof(int32_t);
-									memcpy(BMAP_DATA_to_send.data() + offset, &localy, sizeof(int32_t));
-									offset += sizeof(int32_t);
-									memcpy(BMAP_DATA_to_send.data() + offset, burningMap->getData(), sizeofcell * sizeof(double));
-									offset += sizeofcell * sizeof(double);
-									// marked it dumped
-									//mycells[i][j].setIfAllDumped();
-								}
+					for(size_t i = rnx; i < rnx + anx; ++i){
+						for(size_t j = rny; j < rny + any; ++j){
+							if(mycells[i][j].isActiveForDump()){
+								// Extract local indices
+								int32_t localx = static_cast<int32_t>(i - rnx);
+								int32_t localy = static_cast<int32_t>(j - rny);
+								// Extract cell data
+								mycells[i][j].getBurningMap()->copyTo(cellVals.data());
+								// Serialize localx
+								memcpy(buffer + offset, &localx, sizeof(int32_t));
+								offset += sizeof(int32_t);
+								memcpy(buffer + offset, &localy, sizeof(int32_t));
+								offset += sizeof(int32_t);
+								memcpy(buffer + offset, cellVals.data(), sizeofcell * sizeof(double));
+								offset += sizeofcell * sizeof(double);
 							}
 						}
-					MPI_Send(BMAP_DATA_to_send.data(), totalBytes, MPI_CHAR, nr, 1, MPI_COMM_WORLD);
-				}	
+					}
+					MPI_Isend(buffer, totalBytes, MPI_CHAR, nr, 1, MPI_COMM_WORLD, &request);
+					requests.push_back(request);
+				}
 			}
-				// mark as dumped the cells in the subdomain for rank 1
-			domainInfo = session->fdp->getParallelDomainInfo(1);
-				anx = domainInfo->atmoNX;
-				any = domainInfo->atmoNY;
-				rnx = domainInfo->refNX;
-				rny = domainInfo->refNY;
-			// Iterate over the cells within the specified domain
-			for (size_t i = rnx; i < rnx + anx; ++i) {
-				for (size_t j = rny; j < rny + any; ++j) {
-					if (mycells[i][j].isActiveForDump()) {
-						//mycells[i][j].setIfAllDumped();
+
+			// the cells of rank 0 itself are copied while the others are sent
+			FireDomain::distributedDomainInfo* domainInfo = session->fdp->getParallelDomainInfo(1);
+			size_t anx = domainInfo->atmoNX;
+			size_t any = domainInfo->atmoNY;
+			size_t rnx = domainInfo->refNX;
+			size_t rny = domainInfo->refNY;
+			for(size_t i = rnx; i < rnx + anx; ++i){
+				for(size_t j = rny; j < rny + any; ++j){
+					if(mycells[i][j].isActiveForDump()){
+						mycells[i][j].getBurningMap()->copyTo(cellVals.data());
+						session->fd->getCells()[i - rnx][j - rny].setBMapValues(cellVals.data());
 					}
 				}
 			}
+
+			// load of the ranks, as the ratio of the largest number of
+			// active cells to the mean one
+			int32_t maxActiveCells = 0;
+			double meanActiveCells = 0.;
+			for (int nr = 0; nr < world_size; ++nr) {
+				maxActiveCells = std::max(maxActiveCells, numberOfActiveCells[nr]);
+				meanActiveCells += numberOfActiveCells[nr];
+			}
+			meanActiveCells /= world_size;
+			SimulationParameters::GetInstance()->setInt("dispatch.maxActiveCells", maxActiveCells);
+			SimulationParameters::GetInstance()->setDouble("dispatch.imbalance"
+					, meanActiveCells > 0. ? maxActiveCells/meanActiveCells : 1.);
+
 			bool timeForDump = (std::fmod(session->fdp->getTime(), updateOutputFrequency) < 1e-6);
 			vector<string> optLayers =	SimulationParameters::GetInstance()->getParameterArray("accumulatedDiagnosticScalarLayersNames");
 			for (size_t i = 0; i < optLayers.size(); i++)
@@ -410,7 +467,12 @@ void MNHStep(double dt){
 					fullMatrix->fill(0.0);
 				}
 			}
-			
+			MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+			// the dispatch domain holds the burning maps of all the ranks,
+			// it is not reached by the 'step' command
+			session->fdp->compressExtinguishedCells(session->fdp->getTime());
+			session->fdp->enforceMemoryBudget();
 
 		}else {
 			int32_t numberOfActiveCellsInDomain = 0;
@@ -442,7 +504,24 @@ void MNHStep(double dt){
 	ostringstream cmd;
 	cmd << "step[dt=" << dt <<"]";
 	string scmd = cmd.str(); 
-	executor.ExecuteCommand(scmd); 
+	if ( lag ){
+		/* handing the fluxes of the step that just ended, those of the
+		 * outputs requested since being captured now */
+		for ( set<string>::iterator name = lagged.outputs.begin();
+				name != lagged.outputs.end(); ++name ){
+			map<string, vector<double> >::iterator b = lagged.back.find(*name);
+			if ( b != lagged.back.end() and !b->second.empty() ){
+				lagged.front[*name].swap(b->second);
+			} else {
+				captureOutput(*name, lagged.front[*name]);
+			}
+		}
+		lagged.active = true;
+		lagged.worker = thread(laggedStep, scmd);
+	} else {
+		lagged.active = false;
+		executor.ExecuteCommand(scmd); 
+	}
 	
 /*
 mnhPause = SimulationParameters::GetInstance()->getInt("MNHalt");
@@ -460,8 +539,55 @@ mnhPause = SimulationParameters::GetInstance()->getInt("MNHalt");
 
 
 
+#ifdef MPI_COUPLING
+/* Sum of the interior of a subdomain array, halo excluded so that
+ * no cell is counted by two ranks */
+static double interiorSum(FFArray<double>* arr){
+	size_t nx = arr->getDim("x");
+	size_t ny = arr->getDim("y");
+	double* data = arr->getData();
+	double total = 0.;
+	for (size_t i = 1; i + 1 < nx; ++i) {
+		for (size_t j = 1; j + 1 < ny; ++j) {
+			total += data[i * ny + j];
+		}
+	}
+	return total;
+}
+
+/* Spotting re-ignitions of the interior of this rank's subdomain, as
+ * (x, y) pairs. Each rank draws from its own random stream, seeded by
+ * 'spottingRandomSeed' and the rank, so that runs are reproducible
+ * for a given decomposition. */
+static void spottingIgnitions(DataLayer<double>* layer, FFArray<double>* arr, vector<double>& ignitions){
+	double reignitionThreshold = SimulationParameters::GetInstance()->getDouble("reignitionThresholdFromSpotting");
+	double reignitionMaxProbalilityValueFromSpotting = SimulationParameters::GetInstance()->getDouble("reignitionMaxProbalilityValueFromSpotting");
+	static std::mt19937 rng = [](){
+		std::seed_seq seq{ SimulationParameters::GetInstance()->getInt("spottingRandomSeed"), world_rank };
+		return std::mt19937(seq);
+	}();
+	std::uniform_real_distribution<double> unif(0.0, 1.0);
+
+	size_t nx = arr->getDim("x");
+	size_t ny = arr->getDim("y");
+	double* matrixData = arr->getData();
+	for (size_t i = 1; i + 1 < nx; ++i) {
+		for (size_t j = 1; j + 1 < ny; ++j) {
+			double excess = matrixData[i * ny + j] - reignitionThreshold;
+			if (excess <= 0.0 or excess > 2*reignitionThreshold)
+				continue;                          // nothing to ignite here
+			if (unif(rng) < reignitionMaxProbalilityValueFromSpotting) {
+				ignitions.push_back(layer->getOriginX() + (i + unif(rng)) * layer->getDx());
+				ignitions.push_back(layer->getOriginY() + (j + unif(rng)) * layer->getDy());
+			}
+		}
+	}
+}
+#endif
+
 void FFGetDoubleArray(const char* mname, double t
 		, double* x, size_t sizein, size_t sizeout){
+	lagged.sync();
 	string tmpname(mname);
 	double ct = executor.refTime + t;
 	// searching for the layer to put data 
@@ -469,6 +595,7 @@ void FFGetDoubleArray(const char* mname, double t
 
 	if ( myLayer ){
 			myLayer->setMatrix(tmpname, x, sizein, sizeout, ct);
+			if ( tmpname == "fuel" ) FDCell::landscapeChanged();
 		
 	
 			#ifdef MPI_COUPLING
@@ -480,94 +607,63 @@ void FFGetDoubleArray(const char* mname, double t
 				myLayer->getMatrix(&t2,0);
 				MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
 				MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+				bool timeForDump = (std::fmod(t, updateBinStreamFrequency) < 1e-6);
+
+				// Budgets, reduced over all the ranks from their own subdomain
+				if (tmpname == "injectedAtGround" || tmpname == "spotAtGround"){
+					string budget = (tmpname == "injectedAtGround") ? "sumInjected" : "sumSedimented";
+					double atmosphericTimeStep = SimulationParameters::GetInstance()->getDouble("atmosphericTimeStep");
+					double localSum = interiorSum(t2);
+					double globalSum = 0.;
+					MPI_Allreduce(&localSum, &globalSum, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+					SimulationParameters::GetInstance()->setDouble(budget
+							, SimulationParameters::GetInstance()->getDouble(budget) + globalSum*atmosphericTimeStep);
+				}
+
+				// Re-ignitions, decided by each rank on its subdomain and applied by rank 0
+				if (timeForDump and tmpname == "spotAtGround"
+						and SimulationParameters::GetInstance()->isValued("reignitionThresholdFromSpotting")){
+					vector<double> ignitions;
+					spottingIgnitions(myLayer, t2, ignitions);
+					int numLocal = (int) ignitions.size();
+					vector<int> counts(world_size, 0);
+					MPI_Gather(&numLocal, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+					vector<int> displs(world_size, 0);
+					for (int nr = 1; nr < world_size; ++nr) displs[nr] = displs[nr-1] + counts[nr-1];
+					vector<double> allIgnitions(world_rank == 0 ? displs[world_size-1] + counts[world_size-1] : 0);
+					MPI_Gatherv(ignitions.data(), numLocal, MPI_DOUBLE
+							, allIgnitions.data(), counts.data(), displs.data(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+					if (world_rank == 0){
+						double ignitionTime = executor.getDomain()->getTime();
+						for (size_t k = 0; k + 1 < allIgnitions.size(); k += 2){
+							FFPoint loc(allIgnitions[k], allIgnitions[k+1], 0.);
+							executor.startFireAt(loc, ignitionTime);
+						}
+					}
+				}
+
 				if (world_rank == 0){
 					DataLayer<double>* myMasterLayer = session->fdp->getDataLayer(tmpname);
 					FFArray<double>* fullMatrix;
 					myMasterLayer->getMatrix(&fullMatrix,0);
 					FireDomain::distributedDomainInfo* DM = session->fdp->getParallelDomainInfo(1);
 					fullMatrix->setDataAtLoc(t2->getData(),DM->atmoNX+2,DM->atmoNY+2,DM->refNX,DM->refNY,DM->ID);
+					// receiving the subdomains in whatever order they arrive
+					vector<vector<double> > data_processed(world_size);
+					vector<MPI_Request> requests(world_size - 1);
 					for (int nr = 1; nr < world_size; ++nr) {
 						FireDomain::distributedDomainInfo* DR = session->fdp->getParallelDomainInfo(nr+1);
 						size_t dsize = (DR->atmoNX+2)*(DR->atmoNY+2);
-						std::vector<double> data_processed(dsize);
-						MPI_Recv(data_processed.data(),dsize, MPI_DOUBLE, nr, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-					    fullMatrix->setDataAtLoc(data_processed.data(),DR->atmoNX+2,DR->atmoNY+2,DR->refNX,DR->refNY,DR->ID);				
+						data_processed[nr].resize(dsize);
+						MPI_Irecv(data_processed[nr].data(), dsize, MPI_DOUBLE, nr, 2, MPI_COMM_WORLD, &requests[nr-1]);
 					}
-					if (tmpname == "injectedAtGround"){
-						double atmosphericTimeStep = SimulationParameters::GetInstance()->getDouble("atmosphericTimeStep");
-						double atmoSurf = SimulationParameters::GetInstance()->getDouble("atmosphericCellLength") * SimulationParameters::GetInstance()->getDouble("atmosphericCellWidth");
-						double sumInjected = SimulationParameters::GetInstance()->getDouble("sumInjected");
-
-						
-						sumInjected = sumInjected + ((fullMatrix->sum()) * atmosphericTimeStep );;
-						SimulationParameters::GetInstance()->setDouble("sumInjected", sumInjected);
-
-					}
-
-					if (tmpname == "spotAtGround"){
-						double atmosphericTimeStep = SimulationParameters::GetInstance()->getDouble("atmosphericTimeStep");
-						double atmoSurf = SimulationParameters::GetInstance()->getDouble("atmosphericCellLength") * SimulationParameters::GetInstance()->getDouble("atmosphericCellWidth");
-				
-						double sumSedimented = SimulationParameters::GetInstance()->getDouble("sumSedimented");
-						sumSedimented = sumSedimented + ((fullMatrix->sum()) * atmosphericTimeStep );;
-
-						SimulationParameters::GetInstance()->setDouble("sumSedimented", sumSedimented);
-
-
+					MPI_Waitall(world_size - 1, requests.data(), MPI_STATUSES_IGNORE);
+					for (int nr = 1; nr < world_size; ++nr) {
+						FireDomain::distributedDomainInfo* DR = session->fdp->getParallelDomainInfo(nr+1);
+					    fullMatrix->setDataAtLoc(data_processed[nr].data(),DR->atmoNX+2,DR->atmoNY+2,DR->refNX,DR->refNY,DR->ID);				
 					}
 
-
-					//cout << updateBinStreamFrequency<<endl;
-					if (std::fmod(t, updateBinStreamFrequency) < 1e-6) {
-
-					 	if(tmpname == "spotAtGround"){
-						//	cout <<"Time: "<< t<< " DT:"<< SimulationParameters::GetInstance()->getDouble("atmosphericTimeStep")<< " sumInjected: " << SimulationParameters::GetInstance()->getDouble("sumInjected") << " sumSedimented: " << SimulationParameters::GetInstance()->getDouble("sumSedimented") << endl;
-						
-							if (SimulationParameters::GetInstance()->isValued("reignitionThresholdFromSpotting")){
-								double reignitionThreshold = SimulationParameters::GetInstance()->getDouble("reignitionThresholdFromSpotting");
-								double reignitionMaxProbalilityValueFromSpotting = SimulationParameters::GetInstance()->getDouble("reignitionMaxProbalilityValueFromSpotting");
-								 
-								// --- Re‑ignition logic ---
-								size_t nx = fullMatrix->getDim("x");
-								size_t ny = fullMatrix->getDim("y");
-								double* matrixData = fullMatrix->getData();
-
-								// Random number generator (static so it is created only once)
-								static std::mt19937 rng(std::random_device{}());
-								std::uniform_real_distribution<double> unif(0.0, 1.0);
-								
-								for (size_t i = 2; i < nx-2; ++i) {
-									for (size_t j = 2; j < ny-2; ++j) {
-										const size_t idx = i * ny + j;
-										double excess = matrixData[idx] - reignitionThreshold;
-
-										if (excess <= 0.0)
-											continue;                          // nothing to ignite here
-										if (excess > 2*reignitionThreshold)
-											continue;                          // nothing to ignite here
-										
-
-										
-										if (unif(rng) < reignitionMaxProbalilityValueFromSpotting) {
-											double igX = myMasterLayer->getOriginX()+
-													((i+unif(rng)) * myMasterLayer->getDx()) ;
-											double igY = myMasterLayer->getOriginY()+
-													((j+unif(rng)) * myMasterLayer->getDy());
-					
-
-											std::ostringstream fireCmd;
-										//	cout <<" nx << " << nx << " ny "<< ny << " i "<< i << " j "<< j << " idx "<< idx << " excess "<< idx << " DX "<<igX<<"  "<<igY<< endl;
-											fireCmd << "startFire[loc=(" << igX << ", " << igY << ",0)]";
-										//	cout << "Re-ignition command: " << fireCmd.str() << std::endl;
-											//cout <<"Time: "<<t << "Re-ignition command: " << fireCmd.str() << std::endl;
-											string scmd = fireCmd.str();
-											executor.ExecuteCommand(scmd);
-										}
-									}
-								}
-								// --- End re‑ignition logic ---
-							}
-						}					
+					if (timeForDump) {
 						std::string opath = SimulationParameters::GetInstance()->getParameter("genRawBytesDir");
 						if (opath != "1234567890") {
 							SimulationParameters::GetInstance()->isValued(tmpname+"Range");
@@ -611,6 +707,7 @@ void FFGetDoubleArray(const char* mname, double t
 }
 
 void MNHGoTo(double time){
+	lagged.sync();
 	ostringstream cmd;
 	cmd << "goTo[t=" << time <<"]";
 	string scmd = cmd.str();
@@ -618,6 +715,7 @@ void MNHGoTo(double time){
 }
 
 void executeMNHCommand(const char* cmd){
+	lagged.sync();
 	string scmd(cmd);
 	executor.ExecuteCommand(scmd);
 }
@@ -627,17 +725,20 @@ void FFPutString(const char* mname, char* str){
 }
 
 void FFGetString(const char* mname, const char* str){
+	lagged.sync();
 	string name(mname);
 	string val(str);
 	SimulationParameters::GetInstance()->setParameter(name, val);
 }
 
 void FFPutInt(const char* mname, int* n){
+	lagged.sync();
 	string name(mname);
 	*n = SimulationParameters::GetInstance()->getInt(name);
 }
 
 void FFGetInt(const char* mname, int* n){
+	lagged.sync();
 	string name(mname);
 	SimulationParameters::GetInstance()->setInt(name, *n);
 }
@@ -653,11 +754,13 @@ void FFGetIntArray(const char* mname, double time
 }
 
 void FFPutDouble(const char* mname, double* x){
+	lagged.sync();
 	string name(mname);
 	*x = SimulationParameters::GetInstance()->getDouble(name);
 }
 
 void FFGetDouble(const char* mname, double* x){
+	lagged.sync();
 	string name(mname); 
 	SimulationParameters::GetInstance()->setDouble(name, *x);
 }
@@ -665,6 +768,19 @@ void FFGetDouble(const char* mname, double* x){
 void FFPutDoubleArray(const char* mname, double* x,
 		size_t sizein, size_t sizeout){
 	string tmpname(mname);
+
+	/* in lagged coupling, the fluxes of the previous fire step */
+	if ( lagged.active ){
+		map<string, vector<double> >::iterator buf = lagged.front.find(tmpname);
+		if ( buf != lagged.front.end() and !buf->second.empty() ){
+			memcpy(x, buf->second.data(), buf->second.size()*sizeof(double));
+			return;
+		}
+		/* first request of this output, read from the domain until the next step */
+		lagged.sync();
+		lagged.outputs.insert(tmpname);
+	}
+
 	// searching for concerned layer
  
  
@@ -0,0 +1,647 @@
+/**
+ * @file Checkpoint.cpp
+ * @brief Implements the binary checkpoint/restart of a FireDomain simulation.
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#include "Checkpoint.h"
+#include "FireDomain.h"
+#include "EventCommand.h"
+#include "RasterPropagator.h"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+namespace libforefire {
+
+const char Checkpoint::magic[8] = {'F','F','C','K','P','T','\0','\0'};
+const uint64_t Checkpoint::byteOrderMark = 0x0102030405060708ULL;
+
+/* Marker written at the very end of a complete image */
+static const char endMagic[8] = {'F','F','C','K','E','N','D','\0'};
+
+/*! \class CheckpointReader
+ * \brief Bounded cursor over a memory-mapped checkpoint image */
+class CheckpointReader {
+	const char* cur;
+	const char* end;
+	bool valid;
+public:
+	CheckpointReader(const char* data, size_t size)
+		: cur(data), end(data + size), valid(true) {}
+
+	bool good(){ return valid; }
+
+	bool need(size_t n){
+		if ( !valid or (size_t) (end - cur) < n ) valid = false;
+		return valid;
+	}
+	uint64_t getU64(){
+		uint64_t v = 0;
+		if ( need(sizeof(uint64_t)) ){
+			memcpy(&v, cur, sizeof(uint64_t));
+			cur += sizeof(uint64_t);
+		}
+		return v;
+	}
+	int64_t getI64(){
+		return (int64_t) getU64();
+	}
+	double getDouble(){
+		double v = 0.;
+		if ( need(sizeof(double)) ){
+			memcpy(&v, cur, sizeof(double));
+			cur += sizeof(double);
+		}
+		return v;
+	}
+	FFPoint getPoint(){
+		double x = getDouble();
+		double y = getDouble();
+		double z = getDouble();
+		return FFPoint(x, y, z);
+	}
+	FFVector getVector(){
+		double vx = getDouble();
+		double vy = getDouble();
+		double vz = getDouble();
+		return FFVector(vx, vy, vz);
+	}
+	string getString(){
+		size_t len = getU64();
+		size_t padded = (len + 7) & ~((size_t) 7);
+		if ( !need(padded) ) return "";
+		string s(cur, len);
+		cur += padded;
+		return s;
+	}
+	/*! pointer to 'n' doubles in the mapping (records are 8 bytes aligned) */
+	const double* getDoubles(size_t n){
+		if ( !need(n*sizeof(double)) ) return 0;
+		const double* vals = reinterpret_cast<const double*>(cur);
+		cur += n*sizeof(double);
+		return vals;
+	}
+};
+
+/* Writing helpers, every record is a multiple of 8 bytes */
+static void putU64(ostream& os, uint64_t v){
+	os.write(reinterpret_cast<const char*>(&v), sizeof(uint64_t));
+}
+static void putI64(ostream& os, int64_t v){
+	putU64(os, (uint64_t) v);
+}
+static void putDouble(ostream& os, double v){
+	os.write(reinterpret_cast<const char*>(&v), sizeof(double));
+}
+static void putPoint(ostream& os, FFPoint p){
+	putDouble(os, p.getX());
+	putDouble(os, p.getY());
+	putDouble(os, p.getZ());
+}
+static void putVector(ostream& os, FFVector v){
+	putDouble(os, v.getVx());
+	putDouble(os, v.getVy());
+	putDouble(os, v.getVz());
+}
+static void putString(ostream& os, const string& s){
+	static const char zeros[8] = {0,0,0,0,0,0,0,0};
+	putU64(os, s.size());
+	os.write(s.data(), s.size());
+	size_t pad = ((s.size() + 7) & ~((size_t) 7)) - s.size();
+	if ( pad > 0 ) os.write(zeros, pad);
+}
+
+/* Trashing a tree of fronts from the leaves up, so that no
+ * trashed (and later recycled) front keeps inner fronts */
+static void trashFrontTree(FireDomain* domain, FireFront* ff){
+	list<FireFront*> fronts = ff->getInnerFronts();
+	list<FireFront*>::iterator front;
+	for ( front = fronts.begin(); front != fronts.end(); ++front ){
+		trashFrontTree(domain, *front);
+		domain->addToTrashFronts(*front);
+	}
+}
+
+void Checkpoint::writeFront(ostream& os, FireFront* ff){
+	putI64(os, ff->getID());
+	putU64(os, ff->expanding ? 1 : 0);
+	putDouble(os, ff->getTime());
+	putDouble(os, ff->getUpdateTime());
+	size_t numFN = ff->getHead() ? ff->getNumFN() : 0;
+	putU64(os, numFN);
+	FireNode* fn = ff->getHead();
+	for ( size_t k = 0; k < numFN; k++ ){
+		putI64(os, fn->getID());
+		putI64(os, (int64_t) fn->currentState);
+		putPoint(os, fn->location);
+		putPoint(os, fn->nextloc);
+		putVector(os, fn->velocity);
+		putVector(os, fn->normal);
+		putDouble(os, fn->speed);
+		putDouble(os, fn->frontDepth);
+		putDouble(os, fn->curvature);
+		putDouble(os, fn->getTime());
+		putDouble(os, fn->getUpdateTime());
+		putI64(os, fn->mergingNode ? fn->mergingNode->getID() : 0);
+		fn = fn->getNext();
+	}
+	list<FireFront*> fronts = ff->getInnerFronts();
+	putU64(os, fronts.size());
+	list<FireFront*>::iterator front;
+	for ( front = fronts.begin(); front != fronts.end(); ++front ){
+		writeFront(os, *front);
+	}
+}
+
+/* Parsed records of an image, validated before being applied */
+struct NodeRecord {
+	long id;
+	int64_t state;
+	FFPoint loc, nextloc;
+	FFVector vel, normal;
+	double speed, depth, curvature, time, updateTime;
+	long merging;
+};
+
+struct FrontRecord {
+	long id;
+	bool expanding;
+	double time, updateTime;
+	vector<NodeRecord> nodes;
+	vector<FrontRecord> inner;
+};
+
+struct CellRecord {
+	size_t i, j;
+	const double* vals; /*!< values in the mapping */
+};
+
+struct RasterRecord {
+	bool present;
+	double time, updateTime;
+	size_t numBurnt, numEvaluations;
+	vector<pair<size_t, double> > band; /*!< tentative arrival times by point */
+};
+
+struct EventRecord {
+	int64_t kind;
+	bool input, output;
+	double time;
+	long atom;
+	string command;
+};
+
+bool Checkpoint::readFront(CheckpointReader& in, FrontRecord& rec){
+	rec.id = in.getI64();
+	rec.expanding = in.getU64() != 0;
+	rec.time = in.getDouble();
+	rec.updateTime = in.getDouble();
+	size_t numFN = in.getU64();
+	for ( size_t k = 0; k < numFN and in.good(); k++ ){
+		NodeRecord n;
+		n.id = in.getI64();
+		n.state = in.getI64();
+		n.loc = in.getPoint();
+		n.nextloc = in.getPoint();
+		n.vel = in.getVector();
+		n.normal = in.getVector();
+		n.speed = in.getDouble();
+		n.depth = in.getDouble();
+		n.curvature = in.getDouble();
+		n.time = in.getDouble();
+		n.updateTime = in.getDouble();
+		n.merging = in.getI64();
+		if ( !in.good() ) return false;
+		if ( n.state < FireNode::init or n.state > FireNode::link ) return false;
+		rec.nodes.push_back(n);
+	}
+	size_t numInner = in.getU64();
+	for ( size_t k = 0; k < numInner and in.good(); k++ ){
+		rec.inner.push_back(FrontRecord());
+		if ( !readFront(in, rec.inner.back()) ) return false;
+	}
+	return in.good();
+}
+
+void Checkpoint::buildFront(FireDomain* domain, FireFront* ff, const FrontRecord& rec
+		, map<long, ForeFireAtom*>& atoms, list<pair<FireNode*, long> >& merging
+		, long& maxShortID){
+	if ( ff != domain->getDomainFront() ){
+		ff->setID(rec.id);
+		ff->expanding = rec.expanding;
+		ff->setTime(rec.time);
+		ff->setUpdateTime(rec.updateTime);
+		atoms[rec.id] = ff;
+		maxShortID = max(maxShortID, ff->getShortID());
+	}
+	FireNode* prev = 0;
+	for ( size_t k = 0; k < rec.nodes.size(); k++ ){
+		const NodeRecord& n = rec.nodes[k];
+		FFPoint loc = n.loc;
+		FFVector vel = n.vel;
+		FireNode* fn = domain->addFireNode(loc, vel, n.time, n.depth, n.curvature, ff, prev
+				, 0, 0, (FireNode::State) n.state);
+		fn->setID(n.id);
+		fn->nextloc = n.nextloc;
+		fn->normal = n.normal;
+		fn->speed = n.speed;
+		fn->setUpdateTime(n.updateTime);
+		if ( n.merging != 0 ) merging.push_back(make_pair(fn, n.merging));
+		atoms[n.id] = fn;
+		maxShortID = max(maxShortID, fn->getShortID());
+		prev = fn;
+	}
+	for ( size_t k = 0; k < rec.inner.size(); k++ ){
+		FireFront* inner = domain->addFireFront(0., ff);
+		buildFront(domain, inner, rec.inner[k], atoms, merging, maxShortID);
+	}
+}
+
+bool Checkpoint::save(const string& path, FireDomain* domain, const double& simTime){
+	TimeTable* schedule = domain->getTimeTable();
+	SimulationParameters* params = SimulationParameters::GetInstance();
+
+	/* writing in a temporary file, renamed once complete */
+	string tmpPath = path + ".tmp";
+	vector<char> buffer(1 << 20);
+	ofstream os;
+	os.rdbuf()->pubsetbuf(&buffer[0], buffer.size());
+	os.open(tmpPath.c_str(), ios::out | ios::binary | ios::trunc);
+	if ( !os.is_open() ){
+		cout << "checkpoint: unable to open " << tmpPath << " for writing" << endl;
+		return false;
+	}
+
+	/* header */
+	os.write(magic, 8);
+	putU64(os, version);
+	putU64(os, byteOrderMark);
+	putDouble(os, simTime);
+
+	/* simulation parameters */
+	vector<string> keys = params->getAllKeys();
+	putU64(os, keys.size());
+	for ( size_t k = 0; k < keys.size(); k++ ){
+		putString(os, keys[k]);
+		putString(os, params->getParameter(keys[k]));
+	}
+
+	/* domain */
+	putPoint(os, domain->SWCorner);
+	putPoint(os, domain->NECorner);
+	putU64(os, domain->atmoNX);
+	putU64(os, domain->atmoNY);
+	putU64(os, domain->localBMapSizeX);
+	putU64(os, domain->localBMapSizeY);
+	putDouble(os, domain->getTime());
+	putDouble(os, domain->getUpdateTime());
+	putI64(os, ForeFireAtom::getNextShortID());
+
+	/* burning matrices of the active cells */
+	size_t numActive = 0;
+	for ( size_t i = 0; i < domain->atmoNX; i++ )
+		for ( size_t j = 0; j < domain->atmoNY; j++ )
+			if ( domain->cells[i][j].isActive() ) numActive++;
+	putU64(os, numActive);
+	for ( size_t i = 0; i < domain->atmoNX; i++ ){
+		for ( size_t j = 0; j < domain->atmoNY; j++ ){
+			if ( !domain->cells[i][j].isActive() ) continue;
+			BurningMap* bmap = domain->cells[i][j].getBurningMap();
+			vector<double> vals(bmap->getSizeX()*bmap->getSizeY());
+			bmap->copyTo(vals.data());
+			putU64(os, i);
+			putU64(os, j);
+			putU64(os, vals.size());
+			os.write(reinterpret_cast<const char*>(vals.data())
+					, vals.size()*sizeof(double));
+		}
+	}
+
+	/* fronts and firenodes */
+	writeFront(os, domain->getDomainFront());
+
+	/* narrow band of the raster propagation engine, the band
+	 * being rebuilt from the tentative arrival times */
+	RasterPropagator* raster = domain->rasterEngine;
+	putU64(os, raster ? 1 : 0);
+	if ( raster ){
+		putDouble(os, raster->getTime());
+		putDouble(os, raster->getUpdateTime());
+		putU64(os, raster->numBurnt);
+		putU64(os, raster->numEvaluations);
+		putU64(os, raster->tentative.size());
+		unordered_map<size_t, double>::iterator point;
+		for ( point = raster->tentative.begin(); point != raster->tentative.end(); ++point ){
+			putU64(os, point->first);
+			putDouble(os, point->second);
+		}
+	}
+
+	/* pending events, in scheduling order */
+	vector<FFEvent*> events;
+	if ( schedule and schedule->getTime() > -numeric_limits<double>::infinity() ){
+		FFEvent* ev = schedule->getHead();
+		do {
+			events.push_back(ev);
+			ev = ev->getNext();
+		} while ( ev != schedule->getHead() );
+	}
+	size_t numEvents = 0;
+	ostringstream evs;
+	for ( size_t k = 0; k < events.size(); k++ ){
+		ForeFireAtom* atom = events[k]->getAtom();
+		int64_t kind;
+		int64_t atomId = 0;
+		string command;
+		if ( dynamic_cast<FireNode*>(atom) ){
+			kind = nodeEvent;
+			atomId = atom->getID();
+		} else if ( dynamic_cast<FireFront*>(atom) ){
+			kind = frontEvent;
+			atomId = atom->getID();
+		} else if ( atom == domain ){
+			kind = domainEvent;
+		} else if ( raster != 0 and atom == raster ){
+			kind = rasterEvent;
+		} else if ( dynamic_cast<EventCommand*>(atom) ){
+			kind = commandEvent;
+			command = dynamic_cast<EventCommand*>(atom)->getCommand();
+		} else if ( dynamic_cast<Visitor*>(atom) ){
+			kind = outputsEvent;
+		} else {
+			cout << "checkpoint: skipping event of unknown type "
+					<< atom->toString() << endl;
+			continue;
+		}
+		putI64(evs, kind);
+		putU64(evs, events[k]->input ? 1 : 0);
+		putU64(evs, events[k]->output ? 1 : 0);
+		putDouble(evs, events[k]->getTime());
+		putI64(evs, atomId);
+		putString(evs, command);
+		numEvents++;
+	}
+	putU64(os, numEvents);
+	string evdata = evs.str();
+	os.write(evdata.data(), evdata.size());
+
+	os.write(endMagic, 8);
+	os.close();
+	if ( !os ){
+		cout << "checkpoint: error while writing " << tmpPath << endl;
+		remove(tmpPath.c_str());
+		return false;
+	}
+	if ( rename(tmpPath.c_str(), path.c_str()) != 0 ){
+		cout << "checkpoint: unable to move " << tmpPath << " to " << path << endl;
+		return false;
+	}
+	return true;
+}
+
+bool Checkpoint::restore(const string& path, FireDomain* domain
+		, ForeFireAtom* outputs, double& simTime){
+
+	/* mapping the image */
+	int fd = open(path.c_str(), O_RDONLY);
+	if ( fd < 0 ){
+		cout << "restart: unable to open checkpoint " << path << endl;
+		return false;
+	}
+	struct stat st;
+	if ( fstat(fd, &st) != 0 or st.st_size < 48 ){
+		cout << "restart: " << path << " is not a ForeFire checkpoint" << endl;
+		close(fd);
+		return false;
+	}
+	size_t size = st.st_size;
+	void* addr = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if ( addr == MAP_FAILED ){
+		cout << "restart: unable to map checkpoint " << path << endl;
+		return false;
+	}
+	madvise(addr, size, MADV_SEQUENTIAL);
+	const char* data = static_cast<const char*>(addr);
+
+	/* checking the header and the completeness of the image */
+	CheckpointReader in(data + 8, size - 16);
+	if ( memcmp(data, magic, 8) != 0 or memcmp(data + size - 8, endMagic, 8) != 0 ){
+		cout << "restart: " << path << " is not a complete ForeFire checkpoint" << endl;
+		munmap(addr, size);
+		return false;
+	}
+	uint64_t fversion = in.getU64();
+	uint64_t bom = in.getU64();
+	if ( fversion != version or bom != byteOrderMark ){
+		cout << "restart: checkpoint " << path << " has version " << fversion
+				<< " (expected " << version << ") or foreign byte order" << endl;
+		munmap(addr, size);
+		return false;
+	}
+	simTime = in.getDouble();
+
+	/* simulation parameters, applied once the geometry is validated */
+	vector<pair<string, string> > savedParams;
+	size_t numParams = in.getU64();
+	for ( size_t k = 0; k < numParams and in.good(); k++ ){
+		string key = in.getString();
+		string value = in.getString();
+		savedParams.push_back(make_pair(key, value));
+	}
+
+	/* domain geometry has to be the one of the checkpoint */
+	FFPoint sw = in.getPoint();
+	FFPoint ne = in.getPoint();
+	size_t anx = in.getU64();
+	size_t any = in.getU64();
+	size_t lnx = in.getU64();
+	size_t lny = in.getU64();
+	double dtime = in.getDouble();
+	double dutime = in.getDouble();
+	long nextShortID = in.getI64();
+	if ( !in.good() or anx != domain->atmoNX or any != domain->atmoNY
+			or lnx != domain->localBMapSizeX or lny != domain->localBMapSizeY
+			or sw.distance(domain->SWCorner) > EPSILONX
+			or ne.distance(domain->NECorner) > EPSILONX ){
+		cout << "restart: checkpoint domain " << sw.print() << "-" << ne.print()
+				<< " (" << anx << "x" << any << " cells of " << lnx << "x" << lny
+				<< ") does not match current " << domain->toString() << endl;
+		munmap(addr, size);
+		return false;
+	}
+
+	/* parsing the rest of the image before touching the current state */
+	vector<CellRecord> cellRecords;
+	size_t numActive = in.getU64();
+	for ( size_t k = 0; k < numActive and in.good(); k++ ){
+		CellRecord c;
+		c.i = in.getU64();
+		c.j = in.getU64();
+		size_t csize = in.getU64();
+		c.vals = in.getDoubles(csize);
+		if ( !c.vals or c.i >= anx or c.j >= any or csize != lnx*lny ){
+			cout << "restart: corrupted burning matrix record in " << path << endl;
+			munmap(addr, size);
+			return false;
+		}
+		cellRecords.push_back(c);
+	}
+
+	FrontRecord domainFront;
+	if ( !in.good() or !readFront(in, domainFront) ){
+		cout << "restart: corrupted front records in " << path << endl;
+		munmap(addr, size);
+		return false;
+	}
+
+	RasterRecord rasterRecord;
+	rasterRecord.present = in.getU64() != 0;
+	if ( rasterRecord.present ){
+		rasterRecord.time = in.getDouble();
+		rasterRecord.updateTime = in.getDouble();
+		rasterRecord.numBurnt = in.getU64();
+		rasterRecord.numEvaluations = in.getU64();
+		size_t bandSize = in.getU64();
+		size_t numPoints = domain->globalBMapSizeX*domain->globalBMapSizeY;
+		for ( size_t k = 0; k < bandSize and in.good(); k++ ){
+			size_t index = in.getU64();
+			double t = in.getDouble();
+			if ( index >= numPoints ){
+				cout << "restart: corrupted raster band in " << path << endl;
+				munmap(addr, size);
+				return false;
+			}
+			rasterRecord.band.push_back(make_pair(index, t));
+		}
+	}
+	if ( !in.good() ){
+		cout << "restart: truncated raster band in " << path << endl;
+		munmap(addr, size);
+		return false;
+	}
+
+	vector<EventRecord> eventRecords;
+	size_t numEvents = in.getU64();
+	for ( size_t k = 0; k < numEvents and in.good(); k++ ){
+		EventRecord e;
+		e.kind = in.getI64();
+		e.input = in.getU64() != 0;
+		e.output = in.getU64() != 0;
+		e.time = in.getDouble();
+		e.atom = in.getI64();
+		e.command = in.getString();
+		if ( e.kind < domainEvent or e.kind > rasterEvent
+				or ( e.kind == rasterEvent and !rasterRecord.present ) ){
+			cout << "restart: corrupted event records in " << path << endl;
+			munmap(addr, size);
+			return false;
+		}
+		eventRecords.push_back(e);
+	}
+	if ( !in.good() ){
+		cout << "restart: truncated event records in " << path << endl;
+		munmap(addr, size);
+		return false;
+	}
+
+	/* the image is valid, replacing the current state */
+	SimulationParameters* params = SimulationParameters::GetInstance();
+	for ( size_t k = 0; k < savedParams.size(); k++ ){
+		params->setParameter(savedParams[k].first, savedParams[k].second);
+	}
+	domain->reloadScalarParameters();
+
+	TimeTable* schedule = domain->getTimeTable();
+	trashFrontTree(domain, domain->getDomainFront());
+	domain->trashFrontsAndNodes();
+	schedule->clear();
+	domain->setTime(dtime);
+	domain->setUpdateTime(dutime);
+
+	/* burning matrices */
+	for ( size_t i = 0; i < domain->atmoNX; i++ )
+		for ( size_t j = 0; j < domain->atmoNY; j++ )
+			if ( domain->cells[i][j].isActive() ){
+				domain->cells[i][j].getBurningMap()->fill(numeric_limits<double>::infinity());
+				domain->cells[i][j].touch();
+			}
+	for ( size_t k = 0; k < cellRecords.size(); k++ ){
+		domain->cells[cellRecords[k].i][cellRecords[k].j].setBMapValues(cellRecords[k].vals);
+	}
+
+	/* raster propagation engine, created anew so that its event
+	 * is the one of the image (or that it registers again later) */
+	if ( domain->rasterEngine != 0 ){
+		delete domain->rasterEngine;
+		domain->rasterEngine = 0;
+	}
+	if ( rasterRecord.present ){
+		RasterPropagator* raster = new RasterPropagator(domain, rasterRecord.time);
+		raster->setUpdateTime(rasterRecord.updateTime);
+		raster->numBurnt = rasterRecord.numBurnt;
+		raster->numEvaluations = rasterRecord.numEvaluations;
+		for ( size_t k = 0; k < rasterRecord.band.size(); k++ ){
+			RasterPropagator::BandPoint bp = { rasterRecord.band[k].second, rasterRecord.band[k].first };
+			raster->tentative[bp.index] = bp.time;
+			raster->band.push(bp);
+		}
+		domain->rasterEngine = raster;
+	}
+
+	/* fronts and firenodes, new atoms getting IDs after the restored ones */
+	map<long, ForeFireAtom*> atoms;
+	list<pair<FireNode*, long> > merging;
+	long maxShortID = domain->getDomainFront()->getShortID();
+	buildFront(domain, domain->getDomainFront(), domainFront, atoms, merging, maxShortID);
+	ForeFireAtom::setNextShortID(max(nextShortID, maxShortID + 1));
+	list<pair<FireNode*, long> >::iterator mn;
+	for ( mn = merging.begin(); mn != merging.end(); ++mn ){
+		map<long, ForeFireAtom*>::iterator target = atoms.find(mn->second);
+		if ( target != atoms.end() )
+			mn->first->mergingNode = dynamic_cast<FireNode*>(target->second);
+	}
+
+	/* rebuilding the timetable (the fronts and nodes registered
+	 * themselves while being created, their events are replaced) */
+	schedule->clear();
+	for ( size_t k = 0; k < eventRecords.size(); k++ ){
+		const EventRecord& e = eventRecords[k];
+		ForeFireAtom* atom = 0;
+		switch ( e.kind ){
+		case domainEvent:
+			atom = domain;
+			break;
+		case frontEvent:
+		case nodeEvent:
+			if ( atoms.find(e.atom) != atoms.end() ) atom = atoms[e.atom];
+			break;
+		case commandEvent:
+			atom = new EventCommand(e.command, e.time);
+			break;
+		case outputsEvent:
+			atom = outputs;
+			break;
+		case rasterEvent:
+			atom = domain->rasterEngine;
+			break;
+		}
+		if ( atom == 0 ) continue;
+		FFEvent* ev = new FFEvent(atom, e.time, "none");
+		ev->input = e.input;
+		ev->output = e.output;
+		schedule->insert(ev);
+	}
+	munmap(addr, size);
+	return true;
+}
+
+}
@@ -0,0 +1,84 @@
+/**
+ * @file Checkpoint.h
+ * @brief Binary checkpoint/restart of the complete state of a FireDomain simulation.
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#ifndef CHECKPOINT_H_
+#define CHECKPOINT_H_
+
+#include <stdint.h>
+#include "ForeFireAtom.h"
+#include "include/Futils.h"
+
+using namespace std;
+
+namespace libforefire {
+
+class FireDomain;
+class FireFront;
+class FireNode;
+class TimeTable;
+class CheckpointReader;
+struct FrontRecord;
+
+/*! \class Checkpoint
+ * \brief Versioned binary image of the dynamic state of a simulation
+ *
+ *  A checkpoint holds everything needed to continue a run
+ *  without re-reading fronts or arrival times: the simulation
+ *  parameters, the burning matrices of the active cells, the
+ *  whole tree of fire fronts with the full state of their
+ *  firenodes, the narrow band of the raster propagation
+ *  engine (if any), and the pending events of the timetable
+ *  in their scheduling order. Landscape layers are not stored,
+ *  the image is restored into a domain created with the same
+ *  geometry (typically by the same loadData[] initialization).
+ *
+ *  All records are padded to 8 bytes so that, at restart,
+ *  the file is memory-mapped and the burning matrices are
+ *  copied straight out of the mapping.
+ */
+class Checkpoint {
+
+	/*! \brief kind of atom targeted by a scheduled event */
+	enum EventKind {
+		domainEvent = 0,
+		frontEvent = 1,
+		nodeEvent = 2,
+		commandEvent = 3,
+		outputsEvent = 4,
+		rasterEvent = 5
+	};
+
+	static const char magic[8]; /*!< file signature */
+	static const uint64_t byteOrderMark; /*!< detection of foreign endianness */
+
+	static void writeFront(ostream&, FireFront*);
+	/*! \brief parsing a front, its firenodes and inner fronts */
+	static bool readFront(CheckpointReader&, FrontRecord&);
+	/*! \brief creating a parsed front and its firenodes in the domain */
+	static void buildFront(FireDomain*, FireFront*, const FrontRecord&
+			, map<long, ForeFireAtom*>&, list<pair<FireNode*, long> >&, long&);
+
+public:
+
+	static const uint64_t version = 3; /*!< current version of the format */
+
+	/*! \brief writing the state of the domain and its timetable in a file */
+	static bool save(const string&, FireDomain*, const double&);
+
+	/*! \brief restoring a saved state into a domain of identical geometry,
+	 * 'outputs' is the atom to re-schedule for output events (if any),
+	 * the time of simulation of the checkpoint is returned in the double.
+	 * The whole image is parsed before the current state is replaced,
+	 * which is left untouched if the image is corrupted. */
+	static bool restore(const string&, FireDomain*, ForeFireAtom*, double&);
+
+};
+
+}
+
+#endif /* CHECKPOINT_H_ */
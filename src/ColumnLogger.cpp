@@ -0,0 +1,145 @@
+/**
+ * @file ColumnLogger.cpp
+ * @brief Implements the buffered logging of model inputs and outputs
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#include "ColumnLogger.h"
+#include "SimulationParameters.h"
+#include <sstream>
+#include <iostream>
+#include <set>
+#include <stdint.h>
+
+namespace libforefire {
+
+/* loggers still open, flushed when the program exits as
+ * the models owning them are never deleted */
+static bool registryAlive = false;
+static struct LoggerRegistry {
+	set<ColumnLogger*> loggers;
+	LoggerRegistry(){ registryAlive = true; }
+	~LoggerRegistry(){
+		registryAlive = false;
+		for ( set<ColumnLogger*>::iterator l = loggers.begin(); l != loggers.end(); ++l ) (*l)->close();
+	}
+} registry;
+
+ColumnLogger::ColumnLogger(const string& p, const vector<string>& names)
+	: path(p), columns(names), numCalls(0), numRows(0), numChunks(0) {
+	SimulationParameters* params = SimulationParameters::GetInstance();
+	int rows = params->getInt("loggerBufferRows");
+	bufferRows = ( rows > 0 ) ? rows : 1;
+	int every = params->getInt("loggerSampling");
+	sampling = ( every > 0 ) ? every : 1;
+	filling.assign(columns.size(), vector<double>(bufferRows));
+	writing.assign(columns.size(), vector<double>(bufferRows));
+
+	npy = ( path.size() > 4 and path.compare(path.size() - 4, 4, ".npy") == 0 );
+	ofstream header;
+	if ( npy ){
+		/* the chunks are named after the path, the columns being listed aside */
+		path = path.substr(0, path.size() - 4);
+		header.open((path + ".columns").c_str());
+	} else {
+		csv.open(path.c_str());
+	}
+	ostream& out = npy ? (ostream&) header : (ostream&) csv;
+	for ( size_t c = 0; c < columns.size(); c++ ) out << ( c > 0 ? ";" : "" ) << columns[c];
+	out << endl;
+	if ( !isOpen() ){
+		cout << "WARNING: could not open log file " << p << endl;
+		return;
+	}
+	if ( registryAlive ) registry.loggers.insert(this);
+}
+
+ColumnLogger::~ColumnLogger() {
+	close();
+	if ( registryAlive ) registry.loggers.erase(this);
+}
+
+bool ColumnLogger::isOpen(){
+	return npy or csv.is_open();
+}
+
+bool ColumnLogger::sampled(){
+	return (numCalls++ % sampling) == 0;
+}
+
+void ColumnLogger::append(const double* lead, const size_t& nlead, const double* vals){
+	for ( size_t c = 0; c < nlead; c++ ) filling[c][numRows] = lead[c];
+	for ( size_t c = nlead; c < columns.size(); c++ ) filling[c][numRows] = vals[c - nlead];
+	if ( ++numRows == bufferRows ) flush();
+}
+
+void ColumnLogger::flush(){
+	if ( numRows == 0 ) return;
+	/* the previous buffers have to be written before being filled again */
+	if ( writer.joinable() ) writer.join();
+	filling.swap(writing);
+	writer = thread(&ColumnLogger::write, this, numRows);
+	numRows = 0;
+}
+
+void ColumnLogger::close(){
+	flush();
+	if ( writer.joinable() ) writer.join();
+	if ( csv.is_open() ) csv.close();
+}
+
+void ColumnLogger::write(size_t rows){
+	if ( npy ){
+		writeNpy(rows);
+	} else {
+		writeCSV(rows);
+	}
+	numChunks++;
+}
+
+void ColumnLogger::writeCSV(size_t rows){
+	if ( !csv.is_open() ) return;
+	ostringstream oss;
+	for ( size_t r = 0; r < rows; r++ ){
+		for ( size_t c = 0; c < columns.size(); c++ ){
+			if ( c > 0 ) oss << ';';
+			oss << writing[c][r];
+		}
+		oss << '\n';
+	}
+	string text = oss.str();
+	csv.write(text.data(), text.size());
+	csv.flush();
+}
+
+void ColumnLogger::writeNpy(size_t rows){
+	ostringstream name;
+	name << path << "." << numChunks << ".npy";
+	ofstream out(name.str().c_str(), ios_base::binary);
+	if ( !out ){
+		cout << "WARNING: could not write log chunk " << name.str() << endl;
+		return;
+	}
+	/* version 1.0 header, padded so that the data is 64 bytes aligned;
+	 * the columns are stored one after the other (Fortran order),
+	 * in the little-endian layout of the supported platforms */
+	ostringstream dict;
+	dict << "{'descr': '<f8', 'fortran_order': True, 'shape': ("
+			<< rows << ", " << columns.size() << "), }";
+	string header = dict.str();
+	size_t total = 10 + header.size() + 1;
+	header.append((64 - total%64)%64, ' ');
+	header.push_back('\n');
+	uint16_t headerSize = (uint16_t) header.size();
+	out.write("\x93NUMPY\x01\x00", 8);
+	out.put((char) (headerSize & 0xff));
+	out.put((char) (headerSize >> 8));
+	out.write(header.data(), header.size());
+	for ( size_t c = 0; c < columns.size(); c++ ){
+		out.write(reinterpret_cast<const char*>(writing[c].data()), rows*sizeof(double));
+	}
+}
+
+}
@@ -0,0 +1,87 @@
+/**
+ * @file ColumnLogger.h
+ * @brief Buffered logging of model inputs and outputs, flushed in the background as CSV or columnar .npy chunks.
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#ifndef COLUMNLOGGER_H_
+#define COLUMNLOGGER_H_
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <fstream>
+
+using namespace std;
+
+namespace libforefire {
+
+/*! \class ColumnLogger
+ * \brief Sink of the rows logged by the propagation models
+ *
+ *  Rows (e.g. a rate of spread followed by the properties it was
+ *  computed from) are appended to preallocated column buffers of
+ *  'loggerBufferRows' rows. When the buffers are full they are
+ *  swapped with a second set, written by a helper thread while the
+ *  model goes on filling the first one, so that logging costs a few
+ *  stores per row on the calling thread. Only one row out of
+ *  'loggerSampling' is kept.
+ *
+ *  Rows are written as a ';' separated CSV file with a header line,
+ *  or, when the path ends with '.npy', as successive chunks
+ *  'path.0.npy', 'path.1.npy', ... each holding a (rows, columns)
+ *  double array stored column by column, the names of the columns
+ *  being written in 'path.columns'. Loggers still open are flushed
+ *  when the program exits.
+ *
+ *  Rows are expected to be appended by a single thread, as the
+ *  propagation models are evaluated.
+ */
+class ColumnLogger {
+
+	string path; /*!< path of the CSV file, or of the .npy chunks */
+	vector<string> columns; /*!< names of the columns */
+	bool npy; /*!< columnar .npy chunks instead of CSV */
+	size_t bufferRows; /*!< rows held by a set of buffers */
+	size_t sampling; /*!< one row out of 'sampling' is logged */
+	size_t numCalls; /*!< number of rows offered to the logger */
+
+	vector<vector<double> > filling; /*!< column buffers being filled */
+	vector<vector<double> > writing; /*!< column buffers being written */
+	size_t numRows; /*!< rows in the buffers being filled */
+	size_t numChunks; /*!< chunks written so far */
+	ofstream csv; /*!< CSV file */
+	thread writer; /*!< helper thread writing the full buffers */
+
+	/*! \brief writing the rows of the buffers being written */
+	void write(size_t);
+	/*! \brief writing a chunk as a column ordered .npy file */
+	void writeNpy(size_t);
+	/*! \brief writing the rows at the end of the CSV file */
+	void writeCSV(size_t);
+
+public:
+
+	/*! \brief Constructor from the path and the names of the columns */
+	ColumnLogger(const string&, const vector<string>&);
+	/*! \brief destructor, flushing the remaining rows */
+	~ColumnLogger();
+
+	/*! \brief whether the logger could be opened */
+	bool isOpen();
+	/*! \brief whether the next row is logged, according to the sampling */
+	bool sampled();
+	/*! \brief appending a row made of a few leading values followed by the
+	 * values of the remaining columns */
+	void append(const double*, const size_t&, const double*);
+	/*! \brief handing the buffered rows to the helper thread */
+	void flush();
+	/*! \brief writing all the rows and closing the files */
+	void close();
+};
+
+}
+
+#endif /* COLUMNLOGGER_H_ */
@@ -7,9 +7,16 @@
  */
 
 #include "Command.h"
+#include "Checkpoint.h"
+#include "TilePyramid.h"
+#include "NCChunkWriter.h"
+#include "RasterPropagator.h"
 #include "colormap.h"
 #include <sstream>
 #include <dirent.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <thread>
 #include <cmath> 
 #include <fstream>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
@@ -64,6 +71,12 @@ namespace libforefire
 
     const Command::commandMap Command::translator = Command::makeCmds();
 
+    std::shared_ptr<const Command::Snapshot> Command::snapshot;
+    std::atomic<bool> Command::snapshotStale(false);
+    std::chrono::steady_clock::time_point Command::lastPublish;
+    std::recursive_mutex Command::sessionMutex;
+    map<string, TilePyramid*> Command::tilePyramids;
+
     // Defaults constructor and destructor for the 'Command' abstract class
     Command::Command()
     {
@@ -93,8 +106,8 @@ namespace libforefire
        // if there are 2 ption and it is "pgdNcFile" and a timestamp then it extracts NS, SW and t then calls again createDomain(..) with the 3 options
             string pgdNcFile = getString("pgdNcFile", arg);
             string timeStampDomain = getString("ISOdate", arg);
-            cout << "pgdNcFile: " << pgdNcFile << endl;
-            cout << "timeStampDomain: " << timeStampDomain << endl;
+            *currentSession.outStream << "pgdNcFile: " << pgdNcFile << endl;
+            *currentSession.outStream << "timeStampDomain: " << timeStampDomain << endl;
             if (pgdNcFile != stringError)
             {
                 
@@ -110,11 +123,11 @@ namespace libforefire
                         simParam->setInt("refDay", yday);
                         //simParam->setInt("refTime", secs);
                         simParam->setParameter("ISOdate", timeStampDomain);
-                        cout<<"refYear: " << year << " refDay: " << yday << " refTime: " << secs << endl;
+                        *currentSession.outStream <<"refYear: " << year << " refDay: " << yday << " refTime: " << secs << endl;
                     }
                     else
                     {
-                        cout << "Error: Invalid date format "<< timeStampDomain<<" Expected YYYY-MM-DDTHH:MM:SSZ" << endl;
+                        *currentSession.outStream << "Error: Invalid date format "<< timeStampDomain<<" Expected YYYY-MM-DDTHH:MM:SSZ" << endl;
                         throw BadOption();
                     }
 
@@ -164,11 +177,11 @@ namespace libforefire
                     std::string domCommand = domStream.str();
                     
                     // Optionally, set or use 'dom' as needed.
-                    cout << "Domain string created: " << domCommand << endl;
+                    *currentSession.outStream << "Domain string created: " << domCommand << endl;
                     ExecuteCommand(domCommand);
                     return normal;
                 } else {
-                    cout << "Error: Unable to create domain string due to insufficient data." << endl;
+                    *currentSession.outStream << "Error: Unable to create domain string due to insufficient data." << endl;
                 }
             
 
@@ -267,7 +280,7 @@ namespace libforefire
                                        simParam->getInt("refDay"),
                                        secs, year, yday);
             if (t<0){
-                cout << "WARNING: Trying to set an ignition at date "<< date<<" before reference date at " << simParam->FormatISODate(simParam->getDouble("refTime"), simParam->getInt("refYear"), simParam->getInt("refDay")) << endl;
+                *currentSession.outStream << "WARNING: Trying to set an ignition at date "<< date<<" before reference date at " << simParam->FormatISODate(simParam->getDouble("refTime"), simParam->getInt("refYear"), simParam->getInt("refDay")) << endl;
                 t=0;     
             }
         }
@@ -348,7 +361,7 @@ namespace libforefire
                                                   secs, year, yday);
                           
                         if (t<0){
-                                cout << "WARNING: Adding contour at t=0 because was trying to set an ignition at date "<< iso<<" before reference data date at " << simParam->FormatISODate(simParam->getDouble("refTime"), simParam->getInt("refYear"), simParam->getInt("refDay")) << endl;
+                                *currentSession.outStream << "WARNING: Adding contour at t=0 because was trying to set an ignition at date "<< iso<<" before reference data date at " << simParam->FormatISODate(simParam->getDouble("refTime"), simParam->getInt("refYear"), simParam->getInt("refDay")) << endl;
                                 t=0;     
                         }
 
@@ -363,13 +376,13 @@ namespace libforefire
             size_t coordKey = geojsonText.find("\"coordinates\"");
             if (coordKey == std::string::npos)
             {
-                std::cout << "Error: \"coordinates\" key not found in GeoJSON." << std::endl;
+                *currentSession.outStream << "Error: \"coordinates\" key not found in GeoJSON." << std::endl;
                 return normal;
             }
             size_t startBracket = geojsonText.find('[', coordKey);
             if (startBracket == std::string::npos)
             {
-                std::cout << "Error: '[' after \"coordinates\" not found." << std::endl;
+                *currentSession.outStream << "Error: '[' after \"coordinates\" not found." << std::endl;
                 return normal;
             }
 
@@ -396,7 +409,7 @@ namespace libforefire
                         triple.push_back(std::stod(numbuf));
                     }
                     catch (...) { /* silently ignore bad numbers */ 
-                    cout << "Error: Invalid number in GeoJSON coordinates: " << numbuf << std::endl;
+                    *currentSession.outStream << "Error: Invalid number in GeoJSON coordinates: " << numbuf << std::endl;
                     }
                     numbuf.clear();
 
@@ -458,36 +471,34 @@ namespace libforefire
 
             if (polygons.empty())
             {
-                std::cout << "Error: No coordinates found in GeoJSON string." << std::endl;
+                *currentSession.outStream << "Error: No coordinates found in GeoJSON string." << std::endl;
                 return normal;
             }
 
-     
-            /* 3) Insert outer ring then inner rings as fire fronts.      */
-            double fdepth = currentSession.params->getDouble("initialFrontDepth");
-            double kappa  = 0.0;
-            FFVector defaultVel(0, 0);
-
-            FireFront  *contfront = currentSession.ff->getContFront();
+            if (refDomain->rasterPropagation())
+            {
+                refDomain->getRasterPropagator()->ignite(polygons, t);
+                return normal;
+            }
 
+            /* 3) Insert outer ring then inner rings as fire fronts.      */
+            /* First polygon continues from contfront, subsequent ones
+             * are nested inside the previous front.                  */
+            std::vector<double> xs, ys;
+            std::vector<size_t> offsets(1, 0);
+            std::vector<int> parents;
             for (size_t p = 0; p < polygons.size(); ++p)
             {
-                /* First polygon continues from contfront, subsequent ones
-                 * are nested inside the current front.                   */
-                if (p == 0)
-                    currentSession.ff = refDomain->addFireFront(t, contfront);
-                else
-                    currentSession.ff = refDomain->addFireFront(t, currentSession.ff);
-
-                FireNode *lastnode = nullptr;
                 for (auto it = polygons[p].rbegin(); it != polygons[p].rend(); ++it)
                 {
-                    lastnode = refDomain->addFireNode(*it, defaultVel, t,
-                                                      fdepth, kappa,
-                                                      currentSession.ff, lastnode);
+                    xs.push_back(it->getX());
+                    ys.push_back(it->getY());
                 }
-                completeFront(currentSession.ff);
+                offsets.push_back(xs.size());
+                parents.push_back((int)p - 1);
             }
+            startFireRings(t, polygons.size(), offsets.data(),
+                           xs.data(), ys.data(), parents.data());
 
             return normal;   /* GeoJSON fully handled – no fall-through. */
         }
@@ -498,21 +509,23 @@ namespace libforefire
             std::vector<FFPoint> polygon = getPoly(type, arg);
             if (polygon.empty())
                 return normal;  // Handle error or malformed input as needed.
+
+            if (refDomain->rasterPropagation())
+            {
+                std::vector<std::vector<FFPoint>> rings(1, polygon);
+                refDomain->getRasterPropagator()->ignite(rings, t);
+                return normal;
+            }
     
-            double fdepth = currentSession.params->getDouble("initialFrontDepth");
-            double kappa = 0.0;
-            FireNode *lastnode = nullptr;
-    
-            // For each point in the polygon, add a fire node.
-            // Velocity here is set to a default; adjust as needed.
-            FireFront *contfront = currentSession.ff->getContFront();
-            currentSession.ff = refDomain->addFireFront(t, contfront);
+            // Creating the front and all its nodes in one pass.
+            std::vector<double> xs, ys;
             for ( FFPoint &p : polygon)
             {
-                FFVector defaultVel(0, 0);
-                lastnode = refDomain->addFireNode(p, defaultVel, t, fdepth, kappa, currentSession.ff, lastnode);
+                xs.push_back(p.getX());
+                ys.push_back(p.getY());
             }
-            completeFront(currentSession.ff);
+            size_t offsets[2] = {0, xs.size()};
+            startFireRings(t, 1, offsets, xs.data(), ys.data());
         }
         else if (type == "lonlat" || type == "loc")
         {
@@ -522,43 +535,7 @@ namespace libforefire
                 pos = getPoint("loc", arg);
             
     
-            if (refDomain->striclyWithinDomain(pos) & !refDomain->isBurnt(pos,t))
-            {
-                // Optional: If a current fire front exists, finalize it.
-                if (currentSession.ff != 0)
-                {
-                    completeFront(currentSession.ff);
-                }
-    
-                double perimRes = refDomain->getPerimeterResolution() * 2;
-                int fdom = getInt("domain", arg);
-                if (fdom == INTERROR)
-                    fdom = 0;
-                double fdepth = currentSession.params->getDouble("initialFrontDepth");
-                double kappa = 0.0;
-                FireFront *contfront = currentSession.ff->getContFront();
-                currentSession.ff = refDomain->addFireFront(t, contfront);
-                // Build a triangle around the point.
-                FFVector vel1(0, 1), vel2(1, -1), vel3(-1, -1);
-                FFVector diffP1 = perimRes * vel1;
-                FFVector diffP2 = perimRes * vel2;
-                FFVector diffP3 = perimRes * vel3;
-
-                FFPoint pos1 = pos + diffP1.toPoint();
-                FFPoint pos2 = pos + diffP2.toPoint();
-                FFPoint pos3 = pos + diffP3.toPoint();
-    
-                // Optionally adjust the velocities.
-                vel1 *= 0.1;
-                vel2 *= 0.1;
-                vel3 *= 0.1;
-    
-                FireNode *lastnode = refDomain->addFireNode(pos1, vel1, t, fdepth, kappa, currentSession.ff, 0);
-                lastnode = refDomain->addFireNode(pos2, vel2, t, fdepth, kappa, currentSession.ff, lastnode);
-                refDomain->addFireNode(pos3, vel3, t, fdepth, kappa, currentSession.ff, lastnode);
-                completeFront(currentSession.ff);
-       
-            }
+            startFireAt(pos, t);
         }
         else
         {
@@ -755,7 +732,7 @@ namespace libforefire
                 state = "init";
             if (numTabs != currentLevel + 1)
             {
-                cout << getDomain()->getDomainID() << ": WARNING : asked for a FireNode "
+                *currentSession.outStream << getDomain()->getDomainID() << ": WARNING : asked for a FireNode "
                      << " with wrong indentation, treating it the current fire front" << endl;
             }
 
@@ -765,7 +742,7 @@ namespace libforefire
                 /* Creating a link node */
                 previousNode = getDomain()->addFireNode(pos, vel, t, fdepth, kappa, currentSession.ff, previousNode, fdom, id, FireNode::link);
                 if (getDomain()->commandOutputs)
-                    cout << getDomain()->getDomainID() << ": INIT -> added " << previousNode->toString() << endl;
+                    *currentSession.outStream << getDomain()->getDomainID() << ": INIT -> added " << previousNode->toString() << endl;
             }
             else if (state == "final")
             {
@@ -773,7 +750,7 @@ namespace libforefire
                 /* Creating a link node */
                 previousNode = getDomain()->addFireNode(pos, vel, t, fdepth, kappa, currentSession.ff, previousNode, fdom, id, FireNode::final);
                 if (getDomain()->commandOutputs)
-                    cout << getDomain()->getDomainID() << ": INIT -> added " << previousNode->toString() << endl;
+                    *currentSession.outStream << getDomain()->getDomainID() << ": INIT -> added " << previousNode->toString() << endl;
             }
             else if (getDomain()->striclyWithinDomain(pos) and getDomain()->striclyWithinDomain(*lastReadLoc))
             {
@@ -795,13 +772,13 @@ namespace libforefire
                     itime = previousNode->getTime() + timeinc;
                     previousNode = getDomain()->addFireNode(ipos, ivel, itime, fdepth, kappa, currentSession.ff, previousNode);
                     if (getDomain()->commandOutputs)
-                        cout << getDomain()->getDomainID() << ": INIT -> added inter-node "
+                        *currentSession.outStream << getDomain()->getDomainID() << ": INIT -> added inter-node "
                              << previousNode->toString() << endl;
                 }
                 // creating the firenode
                 previousNode = getDomain()->addFireNode(pos, vel, t, fdepth, kappa, currentSession.ff, previousNode, fdom, id);
                 if (getDomain()->commandOutputs)
-                    cout << getDomain()->getDomainID()
+                    *currentSession.outStream << getDomain()->getDomainID()
                          << ": INIT -> added " << previousNode->toString() << endl;
             }
             else if (!getDomain()->striclyWithinDomain(pos) and getDomain()->striclyWithinDomain(*lastReadLoc))
@@ -822,7 +799,7 @@ namespace libforefire
                         ipos = previousNode->getLoc() + posinc;
                         previousNode = getDomain()->addFireNode(ipos, vel, t, fdepth, kappa, currentSession.ff, previousNode);
                         if (getDomain()->commandOutputs)
-                            cout << getDomain()->getDomainID() << ": INIT -> added inter-node "
+                            *currentSession.outStream << getDomain()->getDomainID() << ": INIT -> added inter-node "
                                  << previousNode->toString() << endl;
                     }
                 }
@@ -839,7 +816,7 @@ namespace libforefire
                     /* First node to be created */
                     previousNode = getDomain()->addFireNode(pos, vel, t, fdepth, kappa, currentSession.ff, previousNode, fdom, id);
                     if (getDomain()->commandOutputs)
-                        cout << getDomain()->getDomainID() << ": INIT -> added " << previousNode->toString() << endl;
+                        *currentSession.outStream << getDomain()->getDomainID() << ": INIT -> added " << previousNode->toString() << endl;
                 }
                 else
                 {
@@ -871,14 +848,14 @@ namespace libforefire
                             ipos = previousNode->getLoc() + posinc;
                             previousNode = getDomain()->addFireNode(ipos, vel, t, fdepth, kappa, currentSession.ff, previousNode);
                             if (getDomain()->commandOutputs)
-                                cout << getDomain()->getDomainID() << ": INIT -> added inter-node "
+                                *currentSession.outStream << getDomain()->getDomainID() << ": INIT -> added inter-node "
                                      << previousNode->toString() << endl;
                         }
                     }
                     // creating the firenode
                     previousNode = getDomain()->addFireNode(pos, vel, t, fdepth, kappa, currentSession.ff, previousNode, fdom, id);
                     if (getDomain()->commandOutputs)
-                        cout << getDomain()->getDomainID()
+                        *currentSession.outStream << getDomain()->getDomainID()
                              << ": INIT -> added " << previousNode->toString() << endl;
                 }
             }
@@ -894,6 +871,79 @@ namespace libforefire
         }
     }
 
+    bool Command::startFireAt(FFPoint &pos, const double &t)
+    {
+        FireDomain *refDomain = getDomain();
+        if (refDomain == 0)
+            return false;
+
+        if (refDomain->rasterPropagation())
+        {
+            refDomain->getRasterPropagator()->ignite(pos, t);
+            return true;
+        }
+
+        if (!refDomain->striclyWithinDomain(pos) or refDomain->isBurnt(pos, t))
+            return false;
+
+        // Optional: If a current fire front exists, finalize it.
+        if (currentSession.ff != 0)
+        {
+            completeFront(currentSession.ff);
+        }
+
+        double perimRes = refDomain->getPerimeterResolution() * 2;
+        double fdepth = currentSession.params->getDouble("initialFrontDepth");
+        double kappa = 0.0;
+        FireFront *contfront = currentSession.ff->getContFront();
+        currentSession.ff = refDomain->addFireFront(t, contfront);
+        // Build a triangle around the point.
+        FFVector vel1(0, 1), vel2(1, -1), vel3(-1, -1);
+        FFVector diffP1 = perimRes * vel1;
+        FFVector diffP2 = perimRes * vel2;
+        FFVector diffP3 = perimRes * vel3;
+
+        FFPoint pos1 = pos + diffP1.toPoint();
+        FFPoint pos2 = pos + diffP2.toPoint();
+        FFPoint pos3 = pos + diffP3.toPoint();
+
+        // Optionally adjust the velocities.
+        vel1 *= 0.1;
+        vel2 *= 0.1;
+        vel3 *= 0.1;
+
+        FireNode *lastnode = refDomain->addFireNode(pos1, vel1, t, fdepth, kappa, currentSession.ff, 0);
+        lastnode = refDomain->addFireNode(pos2, vel2, t, fdepth, kappa, currentSession.ff, lastnode);
+        refDomain->addFireNode(pos3, vel3, t, fdepth, kappa, currentSession.ff, lastnode);
+        completeFront(currentSession.ff);
+        return true;
+    }
+
+    size_t Command::startFireRings(const double &t, const size_t &numRings,
+                                   const size_t *offsets, const double *xs, const double *ys,
+                                   const int *parents)
+    {
+        FireDomain *refDomain = getDomain();
+        if (refDomain == 0 or numRings == 0)
+            return 0;
+        /* Rings are contained in the front of their parent ring, or in
+         * the container of the current front if they have none. Each
+         * front is completed (and scanned) before the next is added. */
+        FireFront *contfront = currentSession.ff->getContFront();
+        std::vector<FireFront *> fronts(numRings, 0);
+        for (size_t r = 0; r < numRings; r++)
+        {
+            FireFront *container = contfront;
+            if (parents != 0 and parents[r] >= 0 and (size_t)parents[r] < r)
+                container = fronts[parents[r]];
+            currentSession.ff = refDomain->addFireFront(t, offsets[r + 1] - offsets[r],
+                                                        xs + offsets[r], ys + offsets[r], container);
+            fronts[r] = currentSession.ff;
+            completeFront(currentSession.ff);
+        }
+        return numRings;
+    }
+
     void Command::completeFront(FireFront *ff)
     {
         if (ff->getHead() == 0)
@@ -928,12 +978,12 @@ namespace libforefire
         }
         if (getDomain()->commandOutputs)
         {
-            cout << getDomain()->getDomainID() << ": "
+            *currentSession.outStream << getDomain()->getDomainID() << ": "
                  << "****************************************" << endl;
-            cout << getDomain()->getDomainID() << ": "
+            *currentSession.outStream << getDomain()->getDomainID() << ": "
                  << " BEFORE THE BEGINNING OF THE SIMULATION: " << endl
                  << ff->print(1);
-            cout << getDomain()->getDomainID() << ": "
+            *currentSession.outStream << getDomain()->getDomainID() << ": "
                  << "****************************************" << endl;
         }
 
@@ -991,13 +1041,13 @@ namespace libforefire
             getDomain()->setTime(startTime);
             if (getDomain()->commandOutputs)
             {
-                cout.precision(numeric_limits<double>::digits10);
-                cout << getDomain()->getDomainID() << ": "
+                currentSession.outStream->precision(numeric_limits<double>::digits10);
+                *currentSession.outStream << getDomain()->getDomainID() << ": "
                      << "***************************************************" << endl;
-                cout << getDomain()->getDomainID() << ": "
+                *currentSession.outStream << getDomain()->getDomainID() << ": "
                      << "   ADVANCING FOREFIRE SIMULATION FROM T="
                      << startTime << " to " << endTime << endl;
-                cout << getDomain()->getDomainID() << ": "
+                *currentSession.outStream << getDomain()->getDomainID() << ": "
                      << "***************************************************" << endl;
             }
 
@@ -1024,12 +1074,15 @@ namespace libforefire
 
                 startTime = endTime;
                 getDomain()->increaseNumIterationAtmoModel();
+                getDomain()->compressExtinguishedCells(endTime);
+                getDomain()->enforceMemoryBudget();
+                publishSnapshot();
 
                 /* outputs */
                 /* ******* */
                 if (getDomain()->commandOutputs)
                 {
-                    cout << getDomain()->getDomainID() << ": "
+                    *currentSession.outStream << getDomain()->getDomainID() << ": "
                          << "End of the step in domain "
                          << getDomain()->getDomainID() << endl
                          << currentSession.outStrRep->dumpStringRepresentation();
@@ -1059,10 +1112,10 @@ namespace libforefire
             }
             catch (TopologicalException &e)
             {
-                cout << getDomain()->getDomainID() << ": " << e.what() << endl;
+                *currentSession.outStream << getDomain()->getDomainID() << ": " << e.what() << endl;
                 getDomain()->restoreValidState();
                 getDomain()->setSafeTopologyMode(true);
-                cout << getDomain()->getDomainID() << ": "
+                *currentSession.outStream << getDomain()->getDomainID() << ": "
                      << "**** MAKING THIS STEP IN SAFE TOPOLOGY MODE ****" << endl;
                 try
                 {
@@ -1077,7 +1130,7 @@ namespace libforefire
                     getDomain()->increaseNumIterationAtmoModel();
                     if (getDomain()->commandOutputs)
                     {
-                        cout << getDomain()->getDomainID() << ": "
+                        *currentSession.outStream << getDomain()->getDomainID() << ": "
                              << "End of the step in domain "
                              << getDomain()->getDomainID() << endl
                              << currentSession.outStrRep->dumpStringRepresentation();
@@ -1087,7 +1140,7 @@ namespace libforefire
                     /* ******* */
                     if (getDomain()->commandOutputs)
                     {
-                        cout << getDomain()->getDomainID() << ": "
+                        *currentSession.outStream << getDomain()->getDomainID() << ": "
                              << "End of the step in domain "
                              << getDomain()->getDomainID() << endl
                              << currentSession.outStrRep->dumpStringRepresentation();
@@ -1118,7 +1171,7 @@ namespace libforefire
                 {
                     if (getDomain()->commandOutputs)
                     {
-                        cout << getDomain()->getDomainID() << ": "
+                        *currentSession.outStream << getDomain()->getDomainID() << ": "
                              << "**** ERROR IN SAFE TOPOLOGY MODE, QUITING ****" << endl;
                     }
                     // TODO supersafe mode ?
@@ -1162,11 +1215,11 @@ namespace libforefire
             simParam->setInt("count", simParam->getInt("count") + 1);
             if (currentSession.fdp != 0)
             {
-                outputfile << currentSession.outStrRepp->dumpStringRepresentation();
+                outputfile << currentSession.outStrRepp->dumpFileRepresentation();
             }
             else
             {
-                outputfile << currentSession.outStrRep->dumpStringRepresentation();
+                outputfile << currentSession.outStrRep->dumpFileRepresentation();
             }
         }
         else
@@ -1221,39 +1274,18 @@ namespace libforefire
         return status;
     }
 
-    std::vector<double> getMinMax(const std::vector<std::vector<double>> &matrix)
+    std::vector<double> getMinMax(const FFRaster<double> &raster)
     {
-        // Initialize min and max with extreme values.
-        double minVal = std::numeric_limits<double>::max();
-        double maxVal = std::numeric_limits<double>::lowest();
-
-        // Iterate over each row and each value in the row.
-        for (const auto &row : matrix)
-        {
-            for (double value : row)
-            {
-                if (value != std::numeric_limits<double>::infinity())
-                {
-                    if (value < minVal)
-                    {
-                        minVal = value;
-                    }
-                    if (value > maxVal)
-                    {
-                        maxVal = value;
-                    }
-                }
-            }
-        }
-
+        // Infinite values (outside of the domain, unburnt) are ignored.
+        double minVal, maxVal;
+        raster.minMax(minVal, maxVal);
         return std::vector<double>{minVal, maxVal};
     }
-    std::vector<double> getMinMaxFromUV(const std::vector<std::vector<double>> &matrixU,
-                                        const std::vector<std::vector<double>> &matrixV)
+    std::vector<double> getMinMaxFromUV(const FFRaster<double> &rasterU,
+                                        const FFRaster<double> &rasterV)
     {
-        // Ensure matrices have the same dimensions
-        size_t numRows = matrixU.size();
-        if (numRows != matrixV.size())
+        // Ensure rasters have the same dimensions
+        if (rasterU.sizeX() != rasterV.sizeX() || rasterU.sizeY() != rasterV.sizeY())
         {
             // Handle the error as needed, here we simply return an empty vector.
             return std::vector<double>{};
@@ -1262,19 +1294,13 @@ namespace libforefire
         double minVal = std::numeric_limits<double>::max();
         double maxVal = std::numeric_limits<double>::lowest();
 
-        for (size_t i = 0; i < numRows; ++i)
+        for (size_t i = 0; i < rasterU.sizeX(); ++i)
         {
-            size_t numCols = matrixU[i].size();
-            if (matrixV[i].size() != numCols)
+            const double *u = rasterU.row(i);
+            const double *v = rasterV.row(i);
+            for (size_t j = 0; j < rasterU.sizeY(); ++j)
             {
-                // Handle dimension mismatch, here we simply return an empty vector.
-                return std::vector<double>{};
-            }
-            for (size_t j = 0; j < numCols; ++j)
-            {
-                double u = matrixU[i][j];
-                double v = matrixV[i][j];
-                double magnitude = std::sqrt(u * u + v * v);
+                double magnitude = std::sqrt(u[j] * u[j] + v[j] * v[j]);
 
                 if (magnitude < minVal)
                 {
@@ -1448,6 +1474,27 @@ namespace libforefire
                 }
             }
 
+            // Tile pyramid: only the tiles covering changes of the burning maps are rendered again
+            if (argMap.find("tiles") != argMap.end())
+            {
+                std::string tileDir = argMap["tiles"];
+                size_t tileSize = 256;
+                int zoom = -1;
+                if (argMap.find("tileSize") != argMap.end())
+                    tileSize = std::stoul(argMap["tileSize"]);
+                if (argMap.find("zoom") != argMap.end())
+                    zoom = std::stoi(argMap["zoom"]);
+
+                TilePyramid *&pyramid = tilePyramids[tileDir];
+                if (pyramid == nullptr || !pyramid->matches(getDomain(), parameter, colormap, tileSize, zoom, minVal, maxVal))
+                {
+                    delete pyramid;
+                    pyramid = new TilePyramid(getDomain(), tileDir, parameter, colormap, tileSize, zoom, minVal, maxVal);
+                }
+                pyramid->render();
+                return normal;
+            }
+
             // Check if filename is provided
             if (!filename.empty())
             {
@@ -1461,16 +1508,16 @@ namespace libforefire
                 if (parameter == "wind" && lowerFilename.size() >= 5)
                 {
 
-                    // We want two data matrices: "windU" and "windV".
-                    // Suppose these are each std::vector<std::vector<double>>.
-                    auto matrixU = getDomain()->getDataMatrix("windU", SWB, NEB, eni, enj);
-                    auto matrixV = getDomain()->getDataMatrix("windV", SWB, NEB, eni, enj);
+                    // We want two data rasters: "windU" and "windV".
+                    FFRaster<double> matrixU, matrixV;
+                    getDomain()->getDataRaster("windU", SWB, NEB, eni, enj, matrixU);
+                    getDomain()->getDataRaster("windV", SWB, NEB, eni, enj, matrixV);
 
                     auto minMax = getMinMaxFromUV(matrixU, matrixV);
 
-                    if (matrixU.empty() || matrixV.empty())
+                    if (matrixU.empty() || matrixV.empty() || minMax.empty())
                     {
-                        std::cerr << "Error: No data available for 'windU' or 'windV'." << std::endl;
+                        *currentSession.outStream << "Error: No data available for 'windU' or 'windV'." << std::endl;
                     }
                     else if (lowerFilename.substr(lowerFilename.size() - 5) == ".json")
                     {
@@ -1480,9 +1527,9 @@ namespace libforefire
                         double southLat = getDomain()->getLatFromY(SWY);
                         double northLat = getDomain()->getLatFromY(NEY);
 
-                        // nrows = matrixU.size(), ncols = matrixU[0].size() (assuming consistent sizing)
-                        size_t ncols = matrixU.size();
-                        size_t nrows = (ncols > 0) ? matrixU[0].size() : 0;
+                        // ncols along x, nrows along y
+                        size_t ncols = matrixU.sizeX();
+                        size_t nrows = matrixU.sizeY();
 
                         double dx = (ncols > 1) ? (eastLon - westLon) / (ncols - 1) : 0.0;
                         double dy = (nrows > 1) ? (northLat - southLat) / (nrows - 1) : 0.0;
@@ -1496,7 +1543,7 @@ namespace libforefire
                         std::ofstream outFile(filename);
                         if (!outFile.is_open())
                         {
-                            std::cerr << "Error: Cannot open output file " << filename << std::endl;
+                            *currentSession.outStream << "Error: Cannot open output file " << filename << std::endl;
                         }
                         else
                         {
@@ -1531,7 +1578,7 @@ namespace libforefire
                                     {
                                         if (!firstVal)
                                             outFile << ",";
-                                        double val = matrixU[c][nrows - r - 1];
+                                        double val = matrixU(c, nrows - r - 1);
                                         if (std::isnan(val))
                                             outFile << 0.0;
                                         else
@@ -1572,7 +1619,7 @@ namespace libforefire
                                     {
                                         if (!firstVal)
                                             outFile << ",";
-                                        double val = matrixV[c][nrows - r - 1];
+                                        double val = matrixV(c, nrows - r - 1);
                                         if (std::isnan(val))
                                             outFile << 0.0;
                                         else
@@ -1591,11 +1638,13 @@ namespace libforefire
                              (lowerFilename.substr(lowerFilename.size() - 4) == ".png" ||
                               lowerFilename.substr(lowerFilename.size() - 4) == ".jpg"))
                     {
-                        for (size_t i = 0; i < matrixU.size(); ++i)
+                        for (size_t i = 0; i < matrixU.sizeX(); ++i)
                         {
-                            for (size_t j = 0; j < matrixU[i].size(); ++j)
+                            double *u = matrixU.row(i);
+                            const double *v = matrixV.row(i);
+                            for (size_t j = 0; j < matrixU.sizeY(); ++j)
                             {
-                                matrixU[i][j] = std::sqrt(matrixU[i][j] * matrixU[i][j] + matrixV[i][j] * matrixV[i][j]);
+                                u[j] = std::sqrt(u[j] * u[j] + v[j] * v[j]);
                             }
                         }
 
@@ -1659,7 +1708,7 @@ namespace libforefire
                                     kmlFile << kmlStream.str();
                                     kmlFile.close();
                                 } else {
-                                    std::cerr << "Error: Cannot open file " << projectionFormat << " for writing." << std::endl;
+                                    *currentSession.outStream << "Error: Cannot open file " << projectionFormat << " for writing." << std::endl;
                                 }
                             }else{
                                 *currentSession.outStream << kmlStream.str() << std::endl;
@@ -1676,8 +1725,9 @@ namespace libforefire
                 // --------------------------------------------------------------
                 else
                 {
-                    // Standard approach: fetch single matrix for the requested "parameter"
-                    auto matrix = getDomain()->getDataMatrix(parameter, SWB, NEB, eni, enj);
+                    // Standard approach: sample a single raster for the requested "parameter"
+                    FFRaster<double> matrix;
+                    getDomain()->getDataRaster(parameter, SWB, NEB, eni, enj, matrix);
                     auto minMax = getMinMax(matrix);
                     if (!matrix.empty())
                     {
@@ -1726,7 +1776,7 @@ namespace libforefire
                         }
                         else
                         {
-                            std::cerr << "Unsupported file extension: " << filename << std::endl;
+                            *currentSession.outStream << "Unsupported file extension: " << filename << std::endl;
                         }
 
                         // Optional projectionOut
@@ -1785,7 +1835,7 @@ namespace libforefire
                                         kmlFile << kmlStream.str();
                                         kmlFile.close();
                                     } else {
-                                        std::cerr << "Error: Cannot open file " << projectionPath << " for writing." << std::endl;
+                                        *currentSession.outStream << "Error: Cannot open file " << projectionPath << " for writing." << std::endl;
                                     }
                                 }else{
                                     *currentSession.outStream << kmlStream.str() << std::endl;
@@ -1797,13 +1847,13 @@ namespace libforefire
                     }
                     else
                     {
-                        std::cerr << "Error: No data available for parameter '" << parameter << "'." << std::endl;
+                        *currentSession.outStream << "Error: No data available for parameter '" << parameter << "'." << std::endl;
                     }
                 }
             }
             else
             {
-                std::cerr << "Error: Filename not provided in the argument." << std::endl;
+                *currentSession.outStream << "Error: Filename not provided in the argument." << std::endl;
             }
         }
 
@@ -1865,7 +1915,7 @@ namespace libforefire
 
         // 'modelName' is optional (used for flux layers)
         std::string modelName = "";
-        cout << "Adding layer: " << layerName << " of type: " << layerType << "Model: " << modelName << " ARG "<<arg<<endl;
+        *currentSession.outStream << "Adding layer: " << layerName << " of type: " << layerType << "Model: " << modelName << " ARG "<<arg<<endl;
         if (argMap.find("modelName") != argMap.end())
             modelName = argMap["modelName"];
 
@@ -1926,6 +1976,213 @@ namespace libforefire
         return normal;
     }
 
+    string Command::checkpointPath(const string &arg)
+    {
+        string path = getString("path", arg);
+        if (path != stringError)
+            return path;
+        if (!arg.empty() && arg.find('=') == string::npos)
+            return arg;
+        return currentSession.params->getParameter("ffOutputsPattern") + ".ffck";
+    }
+
+    int Command::checkpointSimulation(const string &arg, size_t &numTabs)
+    {
+        if (getDomain() == 0)
+        {
+            *currentSession.outStream << "checkpoint: no FireDomain to save" << endl;
+            return error;
+        }
+        /* pending initialization has to be part of the image */
+        if (init && !currentFrontCompleted && currentSession.ff != 0)
+            completeFront(currentSession.ff);
+
+        string path = checkpointPath(arg);
+        if (!Checkpoint::save(path, getDomain(), startTime))
+            return error;
+        if (getDomain()->commandOutputs)
+            *currentSession.outStream << "checkpoint of t=" << startTime << " written in " << path << endl;
+        return normal;
+    }
+
+    int Command::restartSimulation(const string &arg, size_t &numTabs)
+    {
+        if (getDomain() == 0)
+        {
+            *currentSession.outStream << "restart: a FireDomain with the geometry of the checkpoint has to be created first" << endl;
+            return error;
+        }
+        string path = checkpointPath(arg);
+        double t = startTime;
+        if (!Checkpoint::restore(path, getDomain(), currentSession.outStrRep, t))
+            return error;
+        /* the restored fronts are complete, continuing from the checkpoint time */
+        currentFrontCompleted = true;
+        currentSession.ff = getDomain()->getDomainFront();
+        setStartTime(t);
+        if (getDomain()->commandOutputs)
+            *currentSession.outStream << "restarted from " << path << " at t=" << t << endl;
+        return normal;
+    }
+
+    int Command::reportMemory(const string &arg, size_t &numTabs)
+    {
+        if (getDomain() == 0)
+        {
+            *currentSession.outStream << "memory: no FireDomain to account for" << endl;
+            return error;
+        }
+        map<string, size_t> usage;
+        getDomain()->getMemoryUsage(usage);
+        bool perLayer = (getInt("layers", arg) == 1);
+
+        ostringstream oss;
+        oss.precision(3);
+        oss << fixed;
+        for (map<string, size_t>::iterator it = usage.begin(); it != usage.end(); ++it)
+        {
+            bool layerEntry = (it->first.compare(0, 6, "layer.") == 0);
+            /* subsystem totals are also kept as 'memory.<subsystem>' parameters (bytes) */
+            if (!layerEntry)
+                currentSession.params->setSize("memory." + it->first, it->second);
+            if (layerEntry && !perLayer)
+                continue;
+            oss << it->first << " " << it->second/1048576. << "MB" << endl;
+        }
+        double budget = currentSession.params->getDouble("memoryBudgetMB");
+        if (budget > 0.)
+            oss << "budget " << budget << "MB" << endl;
+        *currentSession.outStream << oss.str();
+        return normal;
+    }
+
+    int Command::runEnsemble(const string &arg, size_t &numTabs)
+    {
+        if (getDomain() == 0)
+        {
+            *currentSession.outStream << "ensemble: no FireDomain to run" << endl;
+            return error;
+        }
+        string table = getString("members", arg);
+        double memberEnd = getFloat("t", arg);
+        if (table == stringError || memberEnd == FLOATERROR)
+            throw MissingOption(2);
+
+        string out = getString("out", arg);
+        if (out == stringError)
+            out = currentSession.params->getParameter("ffOutputsPattern") + ".member";
+        bool saveBmaps = (getInt("bmap", arg) == 1);
+
+        ifstream members(table.c_str());
+        if (!members)
+        {
+            *currentSession.outStream << "ensemble: unable to open member table " << table << endl;
+            return error;
+        }
+
+        vector<string> lines;
+        string overrides;
+        while (getline(members, overrides))
+        {
+            if (overrides.empty() || overrides[0] == '#')
+                continue;
+            lines.push_back(overrides);
+        }
+
+        /* members are run by forked workers, starting from the current
+           state with the landscape layers and models shared copy-on-write;
+           overrides, errors and outputs of a member stay in its worker */
+        int maxWorkers = currentSession.params->getInt("ensembleWorkers");
+        if (maxWorkers <= 0)
+            maxWorkers = max(1, (int)std::thread::hardware_concurrency());
+        string experiment = currentSession.params->getParameter("experiment");
+        string dumpMode = currentSession.params->getParameter("dumpMode");
+
+        /* no thread of the sink may hold its locks when forking */
+        Logger::quiesce();
+        cout.flush();
+        map<pid_t, size_t> running;
+        size_t next = 0;
+        size_t failed = 0;
+        bool forkError = false;
+        while (next < lines.size() || !running.empty())
+        {
+            if (next < lines.size() && !forkError && (int)running.size() < maxWorkers)
+            {
+                size_t member = next++;
+                pid_t pid = fork();
+                if (pid == 0)
+                {
+                    Logger::forked();
+                    int status = 0;
+                    try
+                    {
+                        setParameters(lines[member], numTabs);
+                        getDomain()->reloadScalarParameters();
+                        getDomain()->reloadModels();
+
+                        ostringstream etime;
+                        etime.precision(numeric_limits<double>::digits10);
+                        etime << "t=" << memberEnd;
+                        goTo(etime.str(), numTabs);
+
+                        ostringstream mname;
+                        mname << out << "." << member << "." << dumpMode;
+                        printSimulation(mname.str(), numTabs);
+                        if (saveBmaps)
+                        {
+                            currentSession.params->setParameter("experiment", experiment + ".member" + to_string(member));
+                            getDomain()->saveArrivalTimeNC();
+                        }
+                    }
+                    catch (const std::exception &e)
+                    {
+                        cout << "ensemble member " << member << ": " << e.what() << endl;
+                        status = 1;
+                    }
+                    catch (...)
+                    {
+                        cout << "ensemble member " << member << ": unknown error" << endl;
+                        status = 1;
+                    }
+                    Logger::flush();
+                    cout.flush();
+                    _exit(status);
+                }
+                if (pid < 0)
+                {
+                    *currentSession.outStream << "ensemble: unable to start a worker for member " << member << endl;
+                    forkError = true;
+                    failed += lines.size() - member;
+                    continue;
+                }
+                running[pid] = member;
+                continue;
+            }
+
+            int status = 0;
+            pid_t pid = waitpid(-1, &status, 0);
+            if (pid < 0)
+                break;
+            map<pid_t, size_t>::iterator done = running.find(pid);
+            if (done == running.end())
+                continue;
+            size_t member = done->second;
+            running.erase(done);
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            {
+                *currentSession.outStream << "ensemble member " << member << " [" << lines[member] << "] failed" << endl;
+                failed++;
+            }
+            else if (getDomain()->commandOutputs)
+            {
+                *currentSession.outStream << "ensemble member " << member << " [" << lines[member] << "] written in "
+                     << out << "." << member << "." << dumpMode << endl;
+            }
+        }
+        return (failed == 0) ? normal : error;
+    }
+
     int Command::setParameters(const string &arg, size_t &numTabs)
     {
         // Getting all the arguments, using the 'tokenize' function
@@ -2020,7 +2277,7 @@ namespace libforefire
         tokenize(arg, tmpArgs, delimiter);
         if (tmpArgs.size() > 2)
         {
-            cout << "problem in the number of arguments when setting " << arg << endl;
+            *currentSession.outStream << "problem in the number of arguments when setting " << arg << endl;
             return error;
         }
 
@@ -2031,7 +2288,7 @@ namespace libforefire
             std::string value = tmpArgs[1].substr(1);
             // Set the parameter with a protection flag (true).
             currentSession.params->setParameter(tmpArgs[0], value, true);
-            std::cout << "Parameter " << tmpArgs[0]
+            *currentSession.outStream << "Parameter " << tmpArgs[0]
                       << " set to fixed protected value " << value << std::endl;
         }
         else
@@ -2097,12 +2354,12 @@ namespace libforefire
             string param = currentSession.params->getParameter(arg);
             if (param == "1234567890")
             {
-                cout << "Parameter doesn't exist : " << arg << endl;
+                *currentSession.outStream << "Parameter doesn't exist : " << arg << endl;
                 return error;
             }
             if(param.size() > 14){
                 if (param.substr(0, 12) == "getParameter[" && param.substr(param.size() - 1) == "]"){
-                    cout << "recursive call" << param<< endl;
+                    *currentSession.outStream << "recursive call" << param<< endl;
                     return getParameter(param, numTabs);
                 }
                 *currentSession.outStream << param << std::endl;
@@ -2117,18 +2374,69 @@ namespace libforefire
 
     int Command::triggerValue(const string &arg, size_t &numTabs)
     {
+        TriggerArgs trigger;
+        compileTrigger(arg, trigger);
+        return applyTrigger(trigger);
+    }
 
+    void Command::compileTrigger(const string &arg, TriggerArgs &trigger)
+    {
         vector<string> tmpArgs;
         string delimiter = ";";
         tokenize(arg, tmpArgs, delimiter);
+        trigger.kind = TriggerArgs::none;
+        trigger.valid = false;
         if (tmpArgs.size() < 2)
         {
-            return error;
+            return;
         }
 
         if (tmpArgs[0] == "wind")
         {
-            FFVector a = getVector("vel", arg);
+            trigger.kind = TriggerArgs::wind;
+            trigger.vel = getVector("vel", arg);
+            trigger.valid = true;
+        }
+        else if (tmpArgs[0] == "fuel")
+        {
+            trigger.kind = TriggerArgs::fuel;
+            vector<string> tmpVal;
+            string delimiter = "=";
+            tokenize(tmpArgs[1], tmpVal, delimiter);
+            if (tmpVal.size() > 1)
+            {
+                trigger.key = tmpVal[0];
+                istringstream iss(tmpVal[1]);
+                if (iss >> trigger.value)
+                    trigger.valid = true;
+            }
+        }
+        else if (tmpArgs[0] == "fuelIndice")
+        {
+            trigger.kind = TriggerArgs::fuelIndice;
+            trigger.loc = getPoint("loc", arg);
+            trigger.fuelType = getInt("fuelType", arg);
+            trigger.valid = true;
+        }
+        else if (tmpArgs[0] == "resolution")
+        {
+            trigger.kind = TriggerArgs::resolution;
+            trigger.perimeterResolution = getFloat("perimeterResolution", arg);
+            trigger.spatialIncrement = getFloat("spatialIncrement", arg);
+            trigger.valid = true;
+        }
+    }
+
+    int Command::applyTrigger(const TriggerArgs &trigger)
+    {
+        if (!trigger.valid)
+        {
+            return error;
+        }
+
+        if (trigger.kind == TriggerArgs::wind)
+        {
+            FFVector a = trigger.vel;
             FFPoint b = pointError; //("loc", arg);
 
             if (getDomain() != 0)
@@ -2148,49 +2456,36 @@ namespace libforefire
             }
         }
 
-        if (tmpArgs[0] == "fuel")
+        if (trigger.kind == TriggerArgs::fuel)
         {
-
             if (getDomain()->getDataBroker() != 0)
             {
-
-                vector<string> tmpVal;
-                string delimiter = "=";
-                double val = 0;
-                tokenize(tmpArgs[1], tmpVal, delimiter);
-                istringstream iss(tmpVal[1]);
-                if (iss >> val)
-                {
-                    getDomain()->updateFuelTable(tmpVal[0], val);
-
-                    return normal;
-                }
-                return error;
+                getDomain()->updateFuelTable(trigger.key, trigger.value);
+                return normal;
             }
         }
-        if (tmpArgs[0] == "fuelIndice")
+        if (trigger.kind == TriggerArgs::fuelIndice)
         {
             if (getDomain()->getDataBroker() != 0)
             {
-                FFPoint loc = getPoint("loc", arg);
-                int fvalue = getInt("fuelType", arg);
-                getDomain()->getDataBroker()->getLayer("fuel")->setValueAt(loc, 0.0, fvalue);
+                getDomain()->getDataBroker()->getLayer("fuel")->setValueAt(trigger.loc, 0.0, trigger.fuelType);
+                FDCell::landscapeChanged();
                 return normal;
             }
         }
-        if (tmpArgs[0] == "resolution")
+        if (trigger.kind == TriggerArgs::resolution)
         {
-            double newPerimRes = getFloat("perimeterResolution", arg);
-            double newSpatialInc = getFloat("spatialIncrement", arg);
+            double newPerimRes = trigger.perimeterResolution;
+            double newSpatialInc = trigger.spatialIncrement;
 
             bool valid = true;
 
             if (newPerimRes != FLOATERROR && newPerimRes <= 0.0) {
-                cout << "Error: perimeterResolution must be greater than 0." << endl;
+                *currentSession.outStream << "Error: perimeterResolution must be greater than 0." << endl;
                 valid = false;
             }
             if (newSpatialInc != FLOATERROR && newSpatialInc <= 0.0) {
-                cout << "Error: spatialIncrement must be greater than 0." << endl;
+                *currentSession.outStream << "Error: spatialIncrement must be greater than 0." << endl;
                 valid = false;
             }
             if (!valid) return error;
@@ -2210,7 +2505,7 @@ namespace libforefire
             }
             else 
             {
-                cout << "Error: No FireDomain available to update resolution parameters." << endl;
+                *currentSession.outStream << "Error: No FireDomain available to update resolution parameters." << endl;
                 return error;
             }
         }
@@ -2287,7 +2582,7 @@ namespace libforefire
         }
         else
         {
-            cout << "wrong input file, check your settings..." << endl;
+            *currentSession.outStream << "wrong input file, check your settings..." << endl;
         }
         return normal;
     }
@@ -2297,7 +2592,7 @@ namespace libforefire
         // Check for an argument
         if (arg.empty())
         {
-            std::cout << "You have to specify the filename for saving the data" << std::endl;
+            *currentSession.outStream << "You have to specify the filename for saving the data" << std::endl;
             return error;
         }
 
@@ -2334,7 +2629,7 @@ namespace libforefire
         std::string filename = argMap["filename"];
         if (filename.empty())
         {
-            std::cout << "Filename argument is missing" << std::endl;
+            *currentSession.outStream << "Filename argument is missing" << std::endl;
             return error;
         }
 
@@ -2350,7 +2645,7 @@ namespace libforefire
                 if (!field.empty())
                 {
                     fieldsToSave.push_back(field);
-                    std::cout << "saving " << field << std::endl;
+                    *currentSession.outStream << "saving " << field << std::endl;
                 }
             }
         }
@@ -2378,6 +2673,33 @@ namespace libforefire
                 compressionLevel = 10;
         }
 
+        // --- Parse optional "chunks" and "shuffle" options ---
+        // Chunks are given as rows,cols of each (y,x) block, 0,0 for contiguous
+        // storage; compressed variables default to 256x256 chunks and shuffle.
+        size_t chunkRows = compressionLevel > 0 ? 256 : 0;
+        size_t chunkCols = chunkRows;
+        if (argMap.find("chunks") != argMap.end())
+        {
+            std::string chunkStr = argMap["chunks"];
+            chunkStr.erase(std::remove(chunkStr.begin(), chunkStr.end(), '('), chunkStr.end());
+            chunkStr.erase(std::remove(chunkStr.begin(), chunkStr.end(), ')'), chunkStr.end());
+            size_t comma = chunkStr.find(',');
+            try
+            {
+                chunkRows = std::stoul(chunkStr.substr(0, comma));
+                chunkCols = (comma == std::string::npos) ? chunkRows : std::stoul(chunkStr.substr(comma + 1));
+            }
+            catch (...)
+            {
+                *currentSession.outStream << "Warning: invalid chunks " << argMap["chunks"] << ", using default" << std::endl;
+            }
+        }
+        bool shuffle = true;
+        if (argMap.find("shuffle") != argMap.end())
+        {
+            shuffle = (argMap["shuffle"] != "0" && argMap["shuffle"] != "false");
+        }
+
         try
         {
             // Create (or replace) the NetCDF file.
@@ -2389,7 +2711,7 @@ namespace libforefire
             auto domain = getDomain();
             if (!domain)
             {
-                std::cout << "No domain available to save." << std::endl;
+                *currentSession.outStream << "No domain available to save." << std::endl;
                 return error;
             }
             SimulationParameters *simParam = SimulationParameters::GetInstance();
@@ -2429,6 +2751,8 @@ namespace libforefire
             }
 
             // --- Save Selected Data Layers ---
+            // Fields are transposed and written band by band of chunk rows
+            NCChunkWriter writer(chunkRows, chunkCols, shuffle, compressionLevel);
 
             // 1) Fuel Layer
             if (std::find(fieldsToSave.begin(), fieldsToSave.end(), "fuel") != fieldsToSave.end())
@@ -2441,23 +2765,6 @@ namespace libforefire
                     int fz = fuelLayer->getDim("z"); // expected to be 1
                     int fy = fuelLayer->getDim("y"); // e.g., 6400
                     int fx = fuelLayer->getDim("x"); // e.g., 6400
-                    size_t total_size = static_cast<size_t>(ft) * fz * fy * fx;
-                    std::vector<short> reshaped_fuel(total_size);
-                    for (int ti = 0; ti < ft; ++ti)
-                    {
-                        for (int z = 0; z < fz; ++z)
-                        {
-                            for (int y = 0; y < fy; ++y)
-                            {
-                                for (int x = 0; x < fx; ++x)
-                                {
-                                    size_t c_index = x + fx * (y + fy * (z + fz * ti));
-                                    size_t fortran_index = ti + ft * (z + fz * (y + fy * x));
-                                    reshaped_fuel[c_index] = static_cast<short>(fuelMap[fortran_index]);
-                                }
-                            }
-                        }
-                    }
                     NcDim dim_ft = dataFile.addDim("ft", ft);
                     NcDim dim_fz = dataFile.addDim("fz", fz);
                     NcDim dim_fy = dataFile.addDim("fy", fy);
@@ -2465,12 +2772,10 @@ namespace libforefire
                     std::vector<NcDim> fuelDims = {dim_ft, dim_fz, dim_fy, dim_fx};
                     NcVar fuelVar = dataFile.addVar("fuel", ncShort, fuelDims);
                     fuelVar.putAtt("type", "fuel");
-                    if (compressionLevel > 0)
-                    {
-                        // Use NetCDF-4 compression (no shuffle, deflate enabled)
-                        fuelVar.setCompression(false, true, compressionLevel);
-                    }
-                    fuelVar.putVar(reshaped_fuel.data());
+                    writer.define(fuelVar, fy, fx);
+                    writer.write<short>(fuelVar, fuelMap, ft, fz, fy, fx);
+                    // copies of lazily loaded layers are not kept
+                    fuelLayer->releaseMatrix();
                 }
             }
 
@@ -2489,60 +2794,11 @@ namespace libforefire
                     windVLayer->getMatrix(&srcWindV, 0);
                     if (srcWindU && srcWindV)
                     {
-                        // For saving wind, we force each wind component's "time" dimension to 1.
-                        // We then set the combined wind's first dimension to 2.
-                        int compDim = 1;                       // each component (windU or windV) is 1 in its "t" dimension
+                        // For saving wind, we force each wind component's "time" dimension to 1,
+                        // windU and windV being written at index 0 and 1 of "wind_dimensions".
                         int wind_dir = srcWindU->getDim("z");  // maps to wind_directions
                         int wind_rows = srcWindU->getDim("y"); // maps to wind_rows
                         int wind_cols = srcWindU->getDim("x"); // maps to wind_columns
-                        size_t comp_size = static_cast<size_t>(compDim) * wind_dir * wind_rows * wind_cols;
-
-                        // Reshape windU (using a loop similar to your existing reshaping code)
-                        double *dataU = srcWindU->getData();
-                        std::vector<float> reshaped_windU(comp_size);
-                        for (int d = 0; d < compDim; ++d)
-                        {
-                            for (int dir = 0; dir < wind_dir; ++dir)
-                            {
-                                for (int r = 0; r < wind_rows; ++r)
-                                {
-                                    for (int c = 0; c < wind_cols; ++c)
-                                    {
-                                        size_t c_index = c + wind_cols * (r + wind_rows * (dir + wind_dir * d));
-                                        size_t fortran_index = d + compDim * (dir + wind_dir * (r + wind_rows * c));
-                                        reshaped_windU[c_index] = static_cast<float>(dataU[fortran_index]);
-                                    }
-                                }
-                            }
-                        }
-
-                        // Reshape windV similarly
-                        double *dataV = srcWindV->getData();
-                        std::vector<float> reshaped_windV(comp_size);
-                        for (int d = 0; d < compDim; ++d)
-                        {
-                            for (int dir = 0; dir < wind_dir; ++dir)
-                            {
-                                for (int r = 0; r < wind_rows; ++r)
-                                {
-                                    for (int c = 0; c < wind_cols; ++c)
-                                    {
-                                        size_t c_index = c + wind_cols * (r + wind_rows * (dir + wind_dir * d));
-                                        size_t fortran_index = d + compDim * (dir + wind_dir * (r + wind_rows * c));
-                                        reshaped_windV[c_index] = static_cast<float>(dataV[fortran_index]);
-                                    }
-                                }
-                            }
-                        }
-
-                        // Combine the two components into one array.
-                        size_t total_size = 2 * comp_size;
-                        std::vector<float> combined_wind(total_size);
-                        for (size_t i = 0; i < comp_size; i++)
-                        {
-                            combined_wind[i] = reshaped_windU[i];
-                            combined_wind[i + comp_size] = reshaped_windV[i];
-                        }
 
                         // Create wind variable dimensions:
                         NcDim dim_wind_dimensions = dataFile.addDim("wind_dimensions", 2);
@@ -2555,16 +2811,16 @@ namespace libforefire
                         windVar.putAtt("type", "wind");
                         float fillValue = NAN;
                         windVar.putAtt("_FillValue", ncFloat, fillValue);
-                        if (compressionLevel > 0)
-                        {
-                            windVar.setCompression(false, true, compressionLevel);
-                        }
-                        windVar.putVar(combined_wind.data());
+                        writer.define(windVar, wind_rows, wind_cols);
+                        writer.write<float>(windVar, srcWindU->getData(), 1, wind_dir, wind_rows, wind_cols, 0);
+                        writer.write<float>(windVar, srcWindV->getData(), 1, wind_dir, wind_rows, wind_cols, 1);
                     }
+                    windULayer->releaseMatrix();
+                    windVLayer->releaseMatrix();
                 }
                 else
                 {
-                    std::cout << "Wind layers (windU/windV) not available to save." << std::endl;
+                    *currentSession.outStream << "Wind layers (windU/windV) not available to save." << std::endl;
                 }
             }
 
@@ -2578,28 +2834,10 @@ namespace libforefire
                     altLayer->getMatrix(&srcAlt, 0);
                     if (srcAlt)
                     {
-                        double *data = srcAlt->getData();
                         int nt = srcAlt->getDim("t");
                         int nz = srcAlt->getDim("z");
                         int ny = srcAlt->getDim("y");
                         int nx = srcAlt->getDim("x");
-                        size_t total_size = static_cast<size_t>(nt) * nz * ny * nx;
-                        std::vector<short> reshaped_alt(total_size);
-                        for (int ti = 0; ti < nt; ++ti)
-                        {
-                            for (int z = 0; z < nz; ++z)
-                            {
-                                for (int y = 0; y < ny; ++y)
-                                {
-                                    for (int x = 0; x < nx; ++x)
-                                    {
-                                        size_t c_index = x + nx * (y + ny * (z + nz * ti));
-                                        size_t fortran_index = ti + nt * (z + nz * (y + ny * x));
-                                        reshaped_alt[c_index] = static_cast<short>(data[fortran_index]);
-                                    }
-                                }
-                            }
-                        }
                         NcDim dim_nt = dataFile.addDim("nt", nt);
                         NcDim dim_nz = dataFile.addDim("nz", nz);
                         NcDim dim_ny = dataFile.addDim("ny", ny);
@@ -2607,21 +2845,19 @@ namespace libforefire
                         std::vector<NcDim> altDims = {dim_nt, dim_nz, dim_ny, dim_nx};
                         NcVar altVar = dataFile.addVar("altitude", ncShort, altDims);
                         altVar.putAtt("type", "data");
-                        if (compressionLevel > 0)
-                        {
-                            altVar.setCompression(false, true, compressionLevel);
-                        }
-                        altVar.putVar(reshaped_alt.data());
+                        writer.define(altVar, ny, nx);
+                        writer.write<short>(altVar, srcAlt->getData(), nt, nz, ny, nx);
                     }
+                    altLayer->releaseMatrix();
                 }
             }
 
-            std::cout << "Data successfully saved to " << filename << std::endl;
+            *currentSession.outStream << "Data successfully saved to " << filename << std::endl;
             return 0;
         }
         catch (NcException &e)
         {
-            std::cout << "NetCDF error: " << e.what() << std::endl;
+            *currentSession.outStream << "NetCDF error: " << e.what() << std::endl;
             return error;
         }
     }
@@ -2631,7 +2867,7 @@ namespace libforefire
 
         if (arg.size() == 0)
         {
-            cout << "You have to specify the path to the data" << endl;
+            *currentSession.outStream << "You have to specify the path to the data" << endl;
             return error;
         }
 
@@ -2640,7 +2876,7 @@ namespace libforefire
 
         if (args.size() > 2)
         {
-            cout << "LoadData Warning : expecting 1 or 2 arguments" << endl;
+            *currentSession.outStream << "LoadData Warning : expecting 1 or 2 arguments" << endl;
             return error;
         }
 
@@ -2649,7 +2885,7 @@ namespace libforefire
 
         if (std::ifstream(path.c_str()).fail())
         {
-            cout << "File " << path << " doesn't exist or no longer available" << endl;
+            *currentSession.outStream << "File " << path << " doesn't exist or no longer available" << endl;
             return error;
         }
         if (args.size() == 2)
@@ -2692,7 +2928,7 @@ namespace libforefire
                                 simParam->setParameter(myIter->first, std::to_string(attfVal));
                                 break;
                             default:
-                                std::cout << myIter->first << " attribute of unhandled type " << attValType.getName() << std::endl;
+                                *currentSession.outStream << myIter->first << " attribute of unhandled type " << attValType.getName() << std::endl;
                                 break;
                             }
                         }
@@ -3047,49 +3283,46 @@ namespace libforefire
 
     void Command::ExecuteCommand(string &line)
     {
-        /* The method 'ExecuteCommands' uses the 'tokenize' class
-         * to execute the command given by the user
-         * in the 'line'. If first looks at the possible options
-         * (listed in the tables 'short_options' and 'long_options')
-         * and then call the corresponding function */
+        /* The method 'ExecuteCommands' compiles the command given
+         * by the user in the 'line' and executes it (or schedules
+         * it if it is to be executed later) */
+        if (line.size() == 0)
+            return;
+        std::lock_guard<std::recursive_mutex> lock(sessionMutex);
+        CompiledCommand compiled;
+        compileCommand(line, compiled);
+        executeCompiled(compiled);
+    }
 
-        // Getting all the arguments, using the 'tokenize' function
-      
+    void Command::compileCommand(const string &line, CompiledCommand &cc)
+    {
+        /* The line is split on the *first* '[' into the name of
+         * the command and its arguments, the name is resolved in
+         * the 'translator' and the arguments of triggers decoded,
+         * so that nothing has to be parsed again at execution */
+        cc = CompiledCommand();
         if (line.size() == 0)
             return;
-        vector<string> command;
-        size_t numTabs;
+
         string scmd;
         string postcmd;
-        const string delimiter = "[";
-        // Split only on the *first* '[' delimiter:
         size_t bracketPos = line.find('[');
         if (bracketPos != std::string::npos)
-        {
-            command.push_back(line.substr(0, bracketPos));          // part before '['
-            command.push_back(line.substr(bracketPos + 1));         // part after '[' (may include ']')
-        }
-        else
-        {
-            command.push_back(line);                                // whole line, no args
-        }
-        
-        if (command.size() > 1)
         {
             // counting and removing the tabs for the level of the command
-            numTabs = tabsCount(command[0]);
-            scmd = removeTabs(command[0]);
-            if (command[1].size() > 1)
+            string before = line.substr(0, bracketPos);
+            cc.args = line.substr(bracketPos + 1);
+            cc.numTabs = tabsCount(before);
+            scmd = removeTabs(before);
+            if (cc.args.size() > 1)
             {
                 // dropping the last parenthesis ']'
-              
-                postcmd = command[1].substr(command[1].rfind("]") + 1, -1);
-                command[1] = command[1].substr(0, command[1].rfind("]"));
-               // cout << "postcmd >" << postcmd << "< \ncommand[1] >" << command[1] << "<" << endl;
+                postcmd = cc.args.substr(cc.args.rfind("]") + 1, -1);
+                cc.args = cc.args.substr(0, cc.args.rfind("]"));
             }
             else
             {
-                command[1] = "";
+                cc.args = "";
             }
         }
         else
@@ -3097,92 +3330,243 @@ namespace libforefire
             scmd = removeTabs(line);
         }
 
-        // calling the right method using the 'translator'
-        if (((scmd)[0] == '#') || ((scmd)[0] == '*') || ((scmd)[0] == '\n') || ((scmd)[0] == '\r'))
+        if (scmd.empty() || scmd[0] == '#' || scmd[0] == '*' || scmd[0] == '\n' || scmd[0] == '\r')
         {
             // this line is commented, nothing to do
+            return;
+        }
+        cc.comment = false;
+        cc.name = scmd;
+
+        if (postcmd.size() > 1)
+        {
+            cc.text = line.substr(0, line.rfind("]") + 1);
+            cc.when = line.substr(line.rfind("]") + 1, -1);
+            cc.scheduled = true;
+            cc.at = getFloat("@t", cc.when);
+            cc.nowplus = getFloat("@nowplus", cc.when);
+            cc.badSchedule = (cc.when[0] != '@' || (cc.at == FLOATERROR && cc.nowplus == FLOATERROR));
         }
         else
         {
-            if (postcmd.size() > 1)
+            cc.text = line;
+        }
+
+        commandMap::const_iterator curcmd = translator.find(scmd);
+        if (curcmd != translator.end())
+            cc.fn = curcmd->second;
+        if (cc.fn == &triggerValue)
+            compileTrigger(cc.args, cc.trigger);
+    }
+
+    void Command::executeCompiled(CompiledCommand &cc)
+    {
+        if (cc.comment)
+            return;
+
+        if (cc.scheduled)
+        {
+            double whenDouble = cc.at;
+            if (whenDouble == FLOATERROR && cc.nowplus != FLOATERROR)
             {
-                string atCommand = line.substr(0, line.rfind("]") + 1);
-                string whenCommand = line.substr(line.rfind("]") + 1, -1);
-                double whenDouble = getFloat("@t", whenCommand);
-                double whenNextDouble = getFloat("@nowplus", whenCommand);
-                if(whenDouble == FLOATERROR && whenNextDouble != FLOATERROR)
-                {
-                    whenDouble = getDomain()->getTime()+whenNextDouble;
-                }
+                whenDouble = getDomain()->getTime() + cc.nowplus;
+            }
+            if (!cc.badSchedule)
+            {
+                /* the command is scheduled as is, it will not be parsed again */
+                EventCommand *event = new EventCommand(cc, whenDouble);
+                currentSession.tt->insert(new FFEvent(event));
+            }
+            else
+            {
+                *currentSession.outStream << whenDouble << "unknown post operator  >" << cc.when << "< , press 'Tab' for command list." << endl;
+            }
+            return;
+        }
 
-                if ((whenCommand)[0] == '@' && whenDouble != FLOATERROR)
-                {
-                    currentSession.tt->insert(new FFEvent(new EventCommand(atCommand, whenDouble)));
-                }
-                else
-                {
-                    cout << whenDouble << "unknown post operator  >" << whenCommand << "< , press 'Tab' for command list." << endl;
-                }
+        if (cc.fn == 0)
+        {
+            if (cc.name.at(0) != '!')
+                *currentSession.outStream << "unknown command  >" << cc.name << "< , press 'Tab' for command list." << endl;
+            return;
+        }
+
+        try
+        {
+            // calling the right function
+            if (cc.trigger.kind != TriggerArgs::none)
+            {
+                applyTrigger(cc.trigger);
             }
             else
             {
-                commandMap::const_iterator curcmd = translator.find(scmd);
-                if (curcmd == translator.end())
-                {
-                    if (scmd.at(0) != '!')
-                        cout << "unknown command  >" << scmd << "< , press 'Tab' for command list." << endl;
-                }
-                else
-                {
-                    try
-                    {
-                        // calling the right function
-                          //            cout << "executing command '" << scmd << "' with argument(s) '" << command[1] << "'" << endl;
-                        (curcmd->second)(command[1], numTabs);
-                    }
-                    catch (BadOption &)
-                    {
-                        cout << getDomain()->getDomainID() << ": "
-                             << "argument(s) '" << command[1] << "' is (are) not fit for command '"
-                             << command[0] << "'" << endl;
-                        cout << "type 'man[" << command[0] << "]' for more information" << endl;
-                    }
-                    catch (MissingOption &mo)
-                    {
-                        cout << getDomain()->getDomainID() << ": "
-                             << "command '" << command[0] << "' misses "
-                             << mo.num << " options." << endl;
-                        cout << "type 'man[" << command[0] << "]' for more information" << endl;
-                    }
-                    catch (MissingTime &)
-                    {
-                        cout << getDomain()->getDomainID() << ": "
-                             << "you have to specify a time for that command (as in 't=0.')" << endl;
-                    }
-                    catch (...)
-                    {
-                        cout << getDomain()->getDomainID() << ": "
-                             << " PROBLEM: Command associated to " << line << " ended in error" << endl;
-                    }
-                }
+                (cc.fn)(cc.args, cc.numTabs);
             }
         }
-        command.clear();
+        catch (BadOption &)
+        {
+            *currentSession.outStream << getDomain()->getDomainID() << ": "
+                 << "argument(s) '" << cc.args << "' is (are) not fit for command '"
+                 << cc.name << "'" << endl;
+            *currentSession.outStream << "type 'man[" << cc.name << "]' for more information" << endl;
+        }
+        catch (MissingOption &mo)
+        {
+            *currentSession.outStream << getDomain()->getDomainID() << ": "
+                 << "command '" << cc.name << "' misses "
+                 << mo.num << " options." << endl;
+            *currentSession.outStream << "type 'man[" << cc.name << "]' for more information" << endl;
+        }
+        catch (MissingTime &)
+        {
+            *currentSession.outStream << getDomain()->getDomainID() << ": "
+                 << "you have to specify a time for that command (as in 't=0.')" << endl;
+        }
+        catch (...)
+        {
+            *currentSession.outStream << getDomain()->getDomainID() << ": "
+                 << " PROBLEM: Command associated to " << cc.text << " ended in error" << endl;
+        }
+    }
+
+    /* commands that only read the simulation, leaving the snapshot valid */
+    static bool readOnlyCommand(const std::string &cmd)
+    {
+        static const char *names[] = {"getParameter", "print", "save", "plot", "memory", "computeSpeed", "checkpoint"};
+        size_t start = cmd.find_first_not_of(" \t");
+        if (start == std::string::npos)
+            return true;
+        std::string name = cmd.substr(start, cmd.find_first_of("[ \t\r\n", start) - start);
+        for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+        {
+            if (name == names[i])
+                return true;
+        }
+        return false;
     }
 
     std::string Command::executeCommandAndCaptureOutput(const std::string &cmd)
     {
         // 'cmd' is assumed to be the command text after the "ff:" prefix.
-        std::streambuf *oldbuf = std::cout.rdbuf();
+        // The outputs of the command go to a stream of its own, 'cout' is left untouched.
         std::ostringstream captured;
-        std::cout.rdbuf(captured.rdbuf());
         std::string fireCommand = cmd;
-        // Execute the command. (Assuming ExecuteCommand is defined elsewhere.)
-        ExecuteCommand(fireCommand);
-
-        std::cout.rdbuf(oldbuf);
+        {
+            std::lock_guard<std::recursive_mutex> lock(sessionMutex);
+            /* queries not answered from an outdated snapshot are answered from a new one */
+            std::string answer;
+            if (snapshotStale)
+            {
+                publishSnapshot(true);
+                if (answerQuery(fireCommand, answer))
+                    return answer;
+            }
+            ostream *previous = currentSession.outStream;
+            currentSession.outStream = &captured;
+            ExecuteCommand(fireCommand);
+            currentSession.outStream = previous;
+            /* rebuilt by the next query that needs it */
+            if (!readOnlyCommand(fireCommand))
+                snapshotStale = true;
+        }
         return captured.str();
     }
+
+    void Command::publishSnapshot(bool force)
+    {
+        if (currentSession.server == 0)
+            return;
+        std::lock_guard<std::recursive_mutex> lock(sessionMutex);
+        /* steps of a running simulation are published at most every
+           'httpSnapshotPeriod' seconds, queries being queued in between */
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        double period = currentSession.params->getDouble("httpSnapshotPeriod");
+        if (!force && snapshot && std::chrono::duration<double>(now - lastPublish).count() < period)
+        {
+            snapshotStale = true;
+            return;
+        }
+        lastPublish = now;
+        std::shared_ptr<Snapshot> snap = std::make_shared<Snapshot>();
+        snap->time = (getDomain() != 0) ? getDomain()->getTime() : 0.;
+        vector<string> names = currentSession.params->getAllKeys();
+        std::string nameList;
+        for (size_t i = 0; i < names.size(); i++)
+        {
+            snap->parameters[names[i]] = currentSession.params->getParameter(names[i]);
+            nameList += names[i];
+            if (i != names.size() - 1)
+                nameList += ", ";
+        }
+        if (getDomain() != 0)
+        {
+            snap->parameters["parameterNames"] = nameList;
+            names = getDomain()->getDataBroker()->getAllLayerNames();
+            nameList = "";
+            for (size_t i = 0; i < names.size(); i++)
+            {
+                nameList += names[i];
+                if (i != names.size() - 1)
+                    nameList += ", ";
+            }
+            snap->parameters["layerNames"] = nameList;
+            StringRepresentation *rep = (currentSession.fdp != 0) ? currentSession.outStrRepp : currentSession.outStrRep;
+            if (rep != 0)
+                snap->front = rep->dumpStringRepresentation();
+
+            /* arrival time tiles, only those covering changes are rendered again */
+            string tileDir = currentSession.params->getParameter("httpTiles");
+            if (!tileDir.empty())
+            {
+                double inf = std::numeric_limits<double>::infinity();
+                string colormap = currentSession.params->getParameter("httpTilesColormap");
+                TilePyramid *&pyramid = tilePyramids[tileDir];
+                if (pyramid == nullptr || !pyramid->matches(getDomain(), "arrival_time", colormap, 256, -1, inf, -inf))
+                {
+                    delete pyramid;
+                    pyramid = new TilePyramid(getDomain(), tileDir, "arrival_time", colormap, 256, -1, inf, -inf);
+                }
+                pyramid->render();
+                ifstream description((tileDir + "/tiles.json").c_str());
+                ostringstream tiles;
+                tiles << description.rdbuf();
+                snap->tiles = tiles.str();
+            }
+        }
+        std::atomic_store(&snapshot, std::shared_ptr<const Snapshot>(snap));
+        snapshotStale = false;
+    }
+
+    bool Command::answerQuery(const string &cmd, string &answer)
+    {
+        /* only queries that do not depend on the arguments of a
+         * command run are answered here, anything else is queued */
+        std::shared_ptr<const Snapshot> snap = std::atomic_load(&snapshot);
+        if (!snap || snapshotStale)
+            return false;
+        string query = cmd;
+        while (!query.empty() && (query[query.size() - 1] == '\n' || query[query.size() - 1] == '\r' || query[query.size() - 1] == ' '))
+            query.erase(query.size() - 1);
+        if (query == "print[]" || query == "print")
+        {
+            answer = snap->front;
+            return true;
+        }
+        if ((query == "tiles[]" || query == "tiles") && !snap->tiles.empty())
+        {
+            answer = snap->tiles;
+            return true;
+        }
+        if (query.compare(0, 13, "getParameter[") == 0 && query[query.size() - 1] == ']')
+        {
+            map<string, string>::const_iterator param = snap->parameters.find(query.substr(13, query.size() - 14));
+            if (param == snap->parameters.end() || param->second.compare(0, 13, "getParameter[") == 0)
+                return false;
+            answer = param->second + "\n";
+            return true;
+        }
+        return false;
+    }
   
 
     int Command::listenHTTP(const std::string &arg, size_t &numTabs)
@@ -3215,7 +3599,7 @@ namespace libforefire
         char hostname[256];
         if (gethostname(hostname, sizeof(hostname)) != 0)
         {
-            cout << "Cannot get hostname info " << endl;
+            *currentSession.outStream << "Cannot get hostname info " << endl;
             return error;
         }
 
@@ -3228,6 +3612,8 @@ namespace libforefire
         }
 
         currentSession.server->setCallback(executeCommandAndCaptureOutput);
+        currentSession.server->setQueryCallback(answerQuery);
+        currentSession.server->setWorkers(currentSession.params->getInt("httpWorkers"));
 
         if (!currentSession.server->listenOn(address))
         {
@@ -3246,6 +3632,7 @@ namespace libforefire
             {
                 std::cerr << "Unable to open file for writing server info." << std::endl;
             }
+            publishSnapshot();
         }
 
         return normal;
@@ -3286,12 +3673,13 @@ namespace libforefire
         }
     }
 
-    void Command::writeImage(const char *filename, const std::vector<std::vector<double>> &matrix,
+    template <typename T>
+    void Command::writeImage(const char *filename, const FFRaster<T> &matrix,
                              double forced_min_val, double forced_max_val,
-                             const std::string &colormapName)
+                             const std::string &colormapName, int pngCompression)
     {
-        int width = matrix.size();                               // Transposed width (original matrix height)
-        int height = matrix[0].size();                           // Transposed height (original matrix width)
+        int width = matrix.sizeX();                              // Transposed width (original matrix height)
+        int height = matrix.sizeY();                             // Transposed height (original matrix width)
         std::vector<unsigned char> image(width * height * 4, 0); // *4 for RGBA
 
         // double minVal = std::isnan(forced_min_val) ? std::numeric_limits<double>::infinity() : forced_min_val;
@@ -3303,21 +3691,7 @@ namespace libforefire
         // Calculate dynamic min/max if needed
         if (std::isinf(minVal) && std::isinf(maxVal))
         {
-            minVal = std::numeric_limits<double>::max();
-            maxVal = std::numeric_limits<double>::lowest();
-            for (const auto &row : matrix)
-            {
-                for (double val : row)
-                {
-                    if (val != std::numeric_limits<double>::infinity())
-                    {
-                        if (val < minVal)
-                            minVal = val;
-                        if (val > maxVal)
-                            maxVal = val;
-                    }
-                }
-            }
+            matrix.minMax(minVal, maxVal);
         }
         // cout<<"image minVal "<<minVal<<" maxVal "<<maxVal<<endl;
         //  Use the predefined colormaps or default to grayscale
@@ -3338,7 +3712,7 @@ namespace libforefire
             for (int x = 0; x < width; ++x)
             {
                 // Flip vertically by accessing matrix from the bottom up
-                double val = matrix[x][height - 1 - y]; // Adjusted for vertical flip
+                double val = matrix(x, height - 1 - y); // Adjusted for vertical flip
                 int index = (y * width + x) * 4;
                 if (val == std::numeric_limits<double>::infinity())
                 {
@@ -3362,10 +3736,10 @@ namespace libforefire
                     //int colorIndex = static_cast<int>((val - minVal) / (maxVal - minVal) * (mapSize - 1));
                       //                  colorIndex = std::max(0, std::min(colorIndex, mapSize - 1));
                                         /*  if ((x % 1000 == 0) && (y % 1000 == 0)) {
-                                              std::cout << val << " : " << colorIndex << std::endl;
+                                              *currentSession.outStream << val << " : " << colorIndex << std::endl;
                                           }*/
                     /*  if ((x % 1000 == 0) && (y % 1000 == 0)) {
-                          std::cout << val << " : " << colorIndex << std::endl;
+                          *currentSession.outStream << val << " : " << colorIndex << std::endl;
                       }*/
                     const auto &color = colorMap[colorIndex];
                     image[index] = color[0];
@@ -3384,10 +3758,15 @@ namespace libforefire
         else
         {
             // Save as PNG by default
+            int defaultCompression = stbi_write_png_compression_level;
+            if (pngCompression >= 0)
+                stbi_write_png_compression_level = pngCompression;
             stbi_write_png(filename, width, height, 4, image.data(), width * 4);
+            stbi_write_png_compression_level = defaultCompression;
         }
     }
-    void Command::writeHistogram(const char *filename, const std::vector<std::vector<double>> &matrix, int bins,
+    template <typename T>
+    void Command::writeHistogram(const char *filename, const FFRaster<T> &matrix, int bins,
                                  double forced_min_val, double forced_max_val,
                                  const std::string &colormapName)
     {
@@ -3401,31 +3780,19 @@ namespace libforefire
         // Calculate dynamic min/max if needed
         if (std::isinf(minVal) && std::isinf(maxVal))
         {
-            minVal = std::numeric_limits<double>::max();
-            maxVal = std::numeric_limits<double>::lowest();
-            for (const auto &row : matrix)
-            {
-                for (double val : row)
-                {
-                    if (val != std::numeric_limits<double>::infinity())
-                    {
-                        if (val < minVal)
-                            minVal = val;
-                        if (val > maxVal)
-                            maxVal = val;
-                    }
-                }
-            }
+            matrix.minMax(minVal, maxVal);
         }
 
         std::vector<int> bin_counts(bins, 0);
         double bin_width = (maxVal - minVal) / bins;
 
         // Populate bins
-        for (const auto &row : matrix)
+        for (size_t i = 0; i < matrix.sizeX(); i++)
         {
-            for (double val : row)
+            const T *row = matrix.row(i);
+            for (size_t j = 0; j < matrix.sizeY(); j++)
             {
+                double val = row[j];
                 if (val != std::numeric_limits<double>::infinity() && val < maxVal)
                 {
                     int bin = std::min(bins - 1, static_cast<int>((val - minVal) / bin_width));
@@ -3469,7 +3836,8 @@ namespace libforefire
         stbi_write_png(hist_filename.c_str(), width, height, 4, histogram.data(), width * 4);
     }
 
-    void Command::writeNetCDF(const char *filename, const string &varName, const std::vector<std::vector<double>> &matrix, const vector<double> &latitudes, const vector<double> &longitudes)
+    template <typename T>
+    void Command::writeNetCDF(const char *filename, const string &varName, const FFRaster<T> &matrix, const vector<double> &latitudes, const vector<double> &longitudes)
     {
         try
         {
@@ -3490,20 +3858,23 @@ namespace libforefire
             latVar.putVar(latitudes.data());
             lonVar.putVar(longitudes.data());
 
-            // Create the data variable with dimensions (latitude, longitude).
+            // Create the data variable with dimensions (latitude, longitude), in the storage type of the raster.
             vector<NcDim> dims = {latDim, lonDim};
-            NcVar dataVar = dataFile.addVar(varName, ncDouble, dims);
+            NcVar dataVar = dataFile.addVar(varName, (sizeof(T) == sizeof(float)) ? ncFloat : ncDouble, dims);
 
             // Enable compression with a compression level of 6.
             dataVar.setCompression(false, true, 6);
 
-            // Flatten the matrix into a one-dimensional array.
-            vector<double> flat;
-            for (size_t i = 0; i < matrix[0].size(); i++)
+            // Transpose the raster into a (latitude, longitude) array.
+            size_t nx = matrix.sizeX();
+            size_t ny = matrix.sizeY();
+            vector<T> flat(nx * ny);
+            for (size_t j = 0; j < nx; j++)
             {
-                for (size_t j = 0; j < matrix.size(); j++)
+                const T *row = matrix.row(j);
+                for (size_t i = 0; i < ny; i++)
                 {
-                    flat.push_back(matrix[j][i]);
+                    flat[i * nx + j] = row[i];
                 }
             }
 
@@ -3515,7 +3886,8 @@ namespace libforefire
             std::cerr << "Error writing NetCDF file: " << e.what() << std::endl;
         }
     }
-    void Command::writeASCII(const char *filename, const std::vector<std::vector<double>> &matrix, double SWX, double SWY, double NEX, double NEY)
+    template <typename T>
+    void Command::writeASCII(const char *filename, const FFRaster<T> &matrix, double SWX, double SWY, double NEX, double NEY)
     {
         std::ofstream out(filename);
         if (!out)
@@ -3525,8 +3897,8 @@ namespace libforefire
         }
 
         // Determine the number of rows and columns.
-        size_t nrows = matrix.size();
-        size_t ncols = (nrows > 0) ? matrix[0].size() : 0;
+        size_t nrows = matrix.sizeX();
+        size_t ncols = matrix.sizeY();
 
         // Compute the cell size.
         // Here we assume that (NEX - SWX) corresponds to the total width of the matrix.
@@ -3543,9 +3915,10 @@ namespace libforefire
         // Write the matrix data row by row.
         for (size_t i = 0; i < nrows; i++)
         {
+            const T *row = matrix.row(i);
             for (size_t j = 0; j < ncols; j++)
             {
-                out << matrix[i][j];
+                out << row[j];
                 if (j < ncols - 1)
                     out << " ";
             }
@@ -3555,4 +3928,14 @@ namespace libforefire
         out.close();
     }
 
+    // Rasters are written either in double or in single precision.
+    template void Command::writeImage<double>(const char *, const FFRaster<double> &, double, double, const std::string &, int);
+    template void Command::writeImage<float>(const char *, const FFRaster<float> &, double, double, const std::string &, int);
+    template void Command::writeHistogram<double>(const char *, const FFRaster<double> &, int, double, double, const std::string &);
+    template void Command::writeHistogram<float>(const char *, const FFRaster<float> &, int, double, double, const std::string &);
+    template void Command::writeASCII<double>(const char *, const FFRaster<double> &, double, double, double, double);
+    template void Command::writeASCII<float>(const char *, const FFRaster<float> &, double, double, double, double);
+    template void Command::writeNetCDF<double>(const char *, const string &, const FFRaster<double> &, const vector<double> &, const vector<double> &);
+    template void Command::writeNetCDF<float>(const char *, const string &, const FFRaster<float> &, const vector<double> &, const vector<double> &);
+
 }
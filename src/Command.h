@@ -20,8 +20,13 @@
 #include "FireNode.h"
 #include "include/Futils.h"
 #include "EventCommand.h"
+#include "CompiledCommand.h"
 #include <vector>
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
 #include "HttpCommandServer.hpp"
 
 #ifndef COMMAND_DEBUG
@@ -34,6 +39,8 @@
 
 namespace libforefire {
 
+class TilePyramid;
+
 /*! \class Command
  * \brief Commands for driving a ForeFire simulation (singleton class)
  *
@@ -44,6 +51,8 @@ namespace libforefire {
 
 class Command {
 
+	friend class TilePyramid; /*!< tiles are written by the image writer */
+
 	/*! \class BadOption
 	 * \brief dummy class for exception handling
 	 * in case of a bad option inside the command */
@@ -72,7 +81,7 @@ class Command {
 	// Definition of the command map alias
 	typedef int (*cmd)(const string&, size_t&);
 	typedef map<string,cmd> commandMap;  /*!< map of aliases between strings and functions to be called */
-	static const int numberCommands = 21; /*!< number of possible commands */
+	static const int numberCommands = 25; /*!< number of possible commands */
 	static commandMap makeCmds(){
 		// Construction of the command translator
 		commandMap trans;
@@ -84,6 +93,10 @@ class Command {
 		trans["goTo"] = &goTo;
 		trans["print"] = &printSimulation;
 		trans["save"] = &saveSimulation;
+		trans["checkpoint"] = &checkpointSimulation;
+		trans["restart"] = &restartSimulation;
+		trans["ensemble"] = &runEnsemble;
+		trans["memory"] = &reportMemory;
 		trans["plot"] = &plotSimulation;
 		trans["computeSpeed"] = &computeModelSpeed;
 		trans["addLayer"] = &addLayer;
@@ -147,6 +160,14 @@ class Command {
 	static int printSimulation(const string&, size_t&);
 	/*! \brief command to save in print format the simulation */
 	static int saveSimulation(const string&, size_t&);
+	/*! \brief command to write a binary checkpoint of the simulation */
+	static int checkpointSimulation(const string&, size_t&);
+	/*! \brief command to restart the simulation from a binary checkpoint */
+	static int restartSimulation(const string&, size_t&);
+	/*! \brief command to run an ensemble of perturbed members from the current state */
+	static int runEnsemble(const string&, size_t&);
+	/*! \brief command to report the memory held by each subsystem */
+	static int reportMemory(const string&, size_t&);
 	/*! \brief command to load in print format the simulation */
 	static int addLayer(const string&, size_t&);
 	/*! \brief command to plot in png/jpg format the simulation */
@@ -161,6 +182,10 @@ class Command {
 	static int getParameter(const string&, size_t&);
 	/*! \brief command to include a file */
 	static int triggerValue(const string&, size_t&);
+	/*! \brief decoding the arguments of a trigger */
+	static void compileTrigger(const string&, TriggerArgs&);
+	/*! \brief applying a decoded trigger */
+	static int applyTrigger(const TriggerArgs&);
 	/*! \brief command to trigger values that will modifie runtime model parameterisation */
 	static int include(const string&, size_t&);
 
@@ -181,11 +206,34 @@ class Command {
     static int listenHTTP(const string&, size_t &) ;
 
 	static string executeCommandAndCaptureOutput(const std::string &cmd);
+
+	/*! \struct Snapshot
+	 * \brief immutable state of the simulation, published after each step
+	 * for the read-only queries of the HTTP server */
+	struct Snapshot {
+		double time;
+		string front; /*!< fronts in the current dump mode */
+		map<string, string> parameters; /*!< parameters, 'layerNames' and 'parameterNames' */
+		string tiles; /*!< description of the arrival time tiles, empty if not rendered */
+	};
+	static std::shared_ptr<const Snapshot> snapshot; /*!< last published snapshot */
+	static std::atomic<bool> snapshotStale; /*!< the simulation went on since the last snapshot */
+	static std::chrono::steady_clock::time_point lastPublish; /*!< time of the last snapshot */
+	static std::recursive_mutex sessionMutex; /*!< serializes the execution of commands */
+	/*! \brief publishing a snapshot of the simulation (if served over HTTP),
+	 * at most every 'httpSnapshotPeriod' seconds unless forced */
+	static void publishSnapshot(bool = false);
+	/*! \brief answering a read-only query from the last snapshot */
+	static bool answerQuery(const string&, string&);
+
+	static map<string, TilePyramid*> tilePyramids; /*!< tile pyramids rendered by 'plot', by directory */
     
 	/*! \brief splits the command into the desired options */
 	static void tokenize(const string&, vector<string>&, const string&);
 	/*! \brief reads the value of the desired string */
 	static string getString(string, string);
+	/*! \brief path of the checkpoint given in argument (or default one) */
+	static string checkpointPath(const string&);
 	/*! \brief reads the value of the desired int */
 	static int getInt(string, string);
 	/*! \brief reads the value of the desired double */
@@ -204,13 +252,16 @@ class Command {
 	/*! \brief remove the tabs in the commands */
 	static string removeTabs(string);
 
-    static void writeImage(const char* filename, const std::vector<std::vector<double>>& matrix,
+    template <typename T>
+    static void writeImage(const char* filename, const FFRaster<T>& matrix,
                            double forced_min_val = std::numeric_limits<double>::quiet_NaN(),
                            double forced_max_val = std::numeric_limits<double>::quiet_NaN(),
-                           const std::string& colormap = "grayscale"); // Default to grayscale if no colormap is specified.
+                           const std::string& colormap = "grayscale", // Default to grayscale if no colormap is specified.
+                           int pngCompression = -1); // zlib level of PNG files, -1 for the default one.
 
 
-    static void writeHistogram(const char* filename, const std::vector<std::vector<double>>& matrix,   int bins = 100,                        
+    template <typename T>
+    static void writeHistogram(const char* filename, const FFRaster<T>& matrix,   int bins = 100,                        
 							double forced_min_val = std::numeric_limits<double>::quiet_NaN(),
                             double forced_max_val = std::numeric_limits<double>::quiet_NaN(),
 							
@@ -218,8 +269,10 @@ class Command {
 
     static void parseColorMap(const std::string& , std::vector<std::array<unsigned char, 4>>& ) ;
 
-	static void writeASCII(const char *, const std::vector<std::vector<double>>& , double , double , double , double );
-    static void writeNetCDF(const char *, const string& , const std::vector<std::vector<double>>& , const vector<double> &, const vector<double> &);
+	template <typename T>
+	static void writeASCII(const char *, const FFRaster<T>& , double , double , double , double );
+	template <typename T>
+    static void writeNetCDF(const char *, const string& , const FFRaster<T>& , const vector<double> &, const vector<double> &);
 	
 
 
@@ -283,6 +336,17 @@ public:
 
 	/*! \brief execute the desired command */
 	static void ExecuteCommand(string&);
+	/*! \brief starting fires from rings of coordinates (in meters, clockwise);
+	 *  ring 'r' is made of points 'offsets[r]' to 'offsets[r+1]-1' and
+	 *  is nested in ring 'parents[r]' if positive (and lower than 'r') */
+	static size_t startFireRings(const double&, const size_t&, const size_t*
+			, const double*, const double*, const int* = 0);
+	/*! \brief starting a fire at a location (if within the domain and not burnt) */
+	static bool startFireAt(FFPoint&, const double&);
+	/*! \brief parse a command line once for all */
+	static void compileCommand(const string&, CompiledCommand&);
+	/*! \brief execute (or schedule) a compiled command */
+	static void executeCompiled(CompiledCommand&);
 	static void executeLoop(ifstream* inputStream);
 
 	/*! \brief complete the last front */
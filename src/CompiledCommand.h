@@ -0,0 +1,82 @@
+/**
+ * @file CompiledCommand.h
+ * @brief Pre-parsed form of an interpreter command, executed or scheduled without being parsed again.
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#ifndef COMPILEDCOMMAND_H_
+#define COMPILEDCOMMAND_H_
+
+#include "FFPoint.h"
+#include "FFVector.h"
+#include "include/Futils.h"
+
+using namespace std;
+
+namespace libforefire {
+
+/*! \struct TriggerArgs
+ * \brief Typed arguments of a 'trigger[]' command
+ *
+ *  Triggers are by far the most numerous commands of forcing
+ *  scripts, their arguments are decoded once when the line is
+ *  compiled and applied directly when the command is executed.
+ */
+struct TriggerArgs {
+
+	enum Kind {
+		none = 0, wind = 1, fuel = 2, fuelIndice = 3, resolution = 4
+	};
+
+	Kind kind; /*!< kind of trigger, 'none' if not a trigger */
+	bool valid; /*!< false if the arguments could not be decoded */
+
+	FFVector vel; /*!< wind: projection vector of the wind layers */
+	string key; /*!< fuel: name of the fuel property */
+	double value; /*!< fuel: new value of the fuel property */
+	FFPoint loc; /*!< fuelIndice: location of the fuel cell */
+	int fuelType; /*!< fuelIndice: new fuel index of the cell */
+	double perimeterResolution; /*!< resolution: new perimeter resolution */
+	double spatialIncrement; /*!< resolution: new spatial increment */
+
+	TriggerArgs() : kind(none), valid(false), value(0.), fuelType(0)
+		, perimeterResolution(0.), spatialIncrement(0.) {}
+};
+
+/*! \struct CompiledCommand
+ * \brief Command line split, resolved and decoded once
+ *
+ *  A compiled command holds the function the command name
+ *  resolves to, its raw argument string, its level of
+ *  indentation and, for scheduled commands ('@t=' or
+ *  '@nowplus='), the scheduling information. Scheduled
+ *  commands are put in the timetable in their compiled form.
+ */
+struct CompiledCommand {
+
+	typedef int (*handler)(const string&, size_t&);
+
+	string text; /*!< command as written, without scheduling suffix */
+	string name; /*!< name of the command */
+	string args; /*!< arguments of the command, without brackets */
+	handler fn; /*!< function executing the command, NULL if unknown */
+	size_t numTabs; /*!< level of indentation of the command */
+	bool comment; /*!< commented or empty line, nothing to execute */
+
+	bool scheduled; /*!< the command is to be put in the timetable */
+	bool badSchedule; /*!< the scheduling suffix could not be read */
+	string when; /*!< scheduling suffix as written */
+	double at; /*!< absolute scheduling time ('@t=') */
+	double nowplus; /*!< delay from the current time ('@nowplus=') */
+
+	TriggerArgs trigger; /*!< decoded arguments of a 'trigger[]' */
+
+	CompiledCommand() : fn(0), numTabs(0), comment(true)
+		, scheduled(false), badSchedule(false), at(0.), nowplus(0.) {}
+};
+
+}
+
+#endif /* COMPILEDCOMMAND_H_ */
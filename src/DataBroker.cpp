@@ -255,6 +255,24 @@ namespace libforefire
 			extractFuelProperties(fuelPropertiesTable, model);
 	}
 
+	void DataBroker::unregisterPropagationModel(const size_t &index)
+	{
+		if (index >= FireDomain::NUM_MAX_PROPMODELS)
+			return;
+		propDataGetters[index].clear();
+		numPropDataGetters[index] = 0;
+		optimizedPropDataBroker[index] = true;
+	}
+
+	void DataBroker::unregisterFluxModel(const size_t &index)
+	{
+		if (index >= FireDomain::NUM_MAX_FLUXMODELS)
+			return;
+		fluxDataGetters[index].clear();
+		numFluxDataGetters[index] = 0;
+		optimizedFluxDataBroker[index] = true;
+	}
+
 	void DataBroker::extractFuelProperties(vector<map<string, double>> propsTable,
 										   ForeFireModel *model)
 	{
@@ -321,6 +339,20 @@ namespace libforefire
 
 		layersMap.insert(make_pair(name, layer));
 		layers.push_back(layer);
+		/* indices looked up on the previous layers are outdated */
+		FDCell::landscapeChanged();
+
+		/* keeping the values of the listed layers in single precision */
+		vector<string> compactLayers = params->getParameterArray("singlePrecisionLayers");
+		for (size_t k = 0; k < compactLayers.size(); k++)
+		{
+			if (compactLayers[k] != name and compactLayers[k] != "all")
+				continue;
+			XYZTDataLayer<double> *xyztLayer = dynamic_cast<XYZTDataLayer<double> *>(layer);
+			if (xyztLayer != NULL)
+				xyztLayer->setSinglePrecision();
+			break;
+		}
 
 		/* looking for possible match with predefined layers */
 		if (name.find("altitude") != string::npos)
@@ -730,6 +762,22 @@ namespace libforefire
 		return names;
 	}
 
+	void DataBroker::getLayersMemory(map<string, size_t> &usage)
+	{
+		for (const auto &entry : layersMap)
+			usage[entry.first] = entry.second->getMemorySize();
+		for (const auto &entry : fluxLayersMap)
+			usage[entry.first] = entry.second->getMemorySize();
+	}
+
+	size_t DataBroker::releaseLayerCaches()
+	{
+		size_t freed = 0;
+		for (const auto &entry : layersMap)
+			freed += entry.second->releaseCache();
+		return freed;
+	}
+
 	DataLayer<double> *DataBroker::getLayer(const string &property)
 	{
 		// Scanning the scalar layers
@@ -1225,6 +1273,11 @@ namespace libforefire
 				}
 			}
 
+			/* very large landscapes are only read where the fire goes */
+			lazyNCFile = "";
+			if (params->getInt("lazyLayerLoading") != 0)
+				lazyNCFile = filename;
+
 			std::multimap<std::string, NcVar> allVariables = dataFile.getVars();
 
 			// Loop through all variables in the file
@@ -1360,6 +1413,7 @@ namespace libforefire
 					}
 				}
 			} // End of variable loop
+			lazyNCFile = "";
 
 			// Ensure propagative layer is present
 			if (domain->getPropagativeLayer() == 0)
@@ -1377,10 +1431,30 @@ namespace libforefire
 		}
 		catch (NcException &e)
 		{
+			lazyNCFile = "";
 			cout << "Problem Loading data from NetCDF file " << filename << ": " << e.what() << endl;
 		}
 	}
 
+	template <typename T>
+	NCTileCache<T> *DataBroker::lazyTiles(NcVar &values, size_t &nx, size_t &ny, size_t &nz, size_t &nt, int dimTSelected)
+	{
+		if (lazyNCFile.empty() || values.getDimCount() != 4)
+			return NULL;
+		size_t maxMB = (size_t)params->getInt("lazyLayerCacheMB");
+		size_t tileSize = (size_t)params->getInt("lazyLayerTileSize");
+		/* not worth it if the whole variable fits in a few tiles */
+		if (nx * ny <= 4 * tileSize * tileSize)
+			return NULL;
+		NCTileCache<T> *tiles = new NCTileCache<T>(lazyNCFile, values.getName(), nx, ny, nz, nt, dimTSelected, maxMB, tileSize);
+		if (tiles->isNull())
+		{
+			delete tiles;
+			return NULL;
+		}
+		return tiles;
+	}
+
 	XYZTDataLayer<double> *DataBroker::constructXYZTLayer(NcVar &values, FFPoint &SWCorner, FFPoint &spatialExtent,
 														  double timeOrigin, double Lt, int dimTSelected /* = -1 */)
 	{
@@ -1400,10 +1474,18 @@ namespace libforefire
 		if (dimTSelected > -1)
 			nt = 1;
 
-		double *data = readAndTransposeFortranProjectedField(&values, nt, nz, ny, nx, true, dimTSelected);
-
 		std::string property = values.getName();
 
+		NCTileCache<double> *tiles = lazyTiles<double>(values, nx, ny, nz, nt, dimTSelected);
+		if (tiles != NULL)
+		{
+			if (isRelevantData(SWCorner, spatialExtent))
+				return new XYZTDataLayer<double>(property, SWCorner, timeOrigin, spatialExtent, Lt, nx, ny, nz, nt, tiles);
+			delete tiles;
+		}
+
+		double *data = readAndTransposeFortranProjectedField(&values, nt, nz, ny, nx, true, dimTSelected);
+
 		if (isRelevantData(SWCorner, spatialExtent))
 		{
 			XYZTDataLayer<double> *newlayer = new XYZTDataLayer<double>(property, SWCorner, timeOrigin, spatialExtent, Lt,
@@ -1452,6 +1534,10 @@ namespace libforefire
 		}
 		std::string property = values.getName();
 
+		NCTileCache<int> *tiles = lazyTiles<int>(values, nx, ny, nz, nt, -1);
+		if (tiles != NULL)
+			return new FuelDataLayer<double>(property, SWCorner, timeOrigin, spatialExtent, Lt, nx, ny, nz, nt, tiles);
+
 		int *fuelMap = readAndTransposeIntFortranProjectedField(&values, nt, nz, ny, nx, true, -1);
 
 		if (isRelevantData(SWCorner, spatialExtent))
@@ -211,6 +211,10 @@ class DataBroker {
 	PropagativeLayer<double>* constructPropagativeLayer(NcVar&, FFPoint&, FFPoint&,double , double , int );
 	/*! \brief loading a FluxLayer from an NcFile */
 	FluxLayer<double>* constructFluxLayer(NcVar&, FFPoint&, FFPoint&,double , double , int );
+	/*! \brief file currently loaded, if its layers are to be read lazily by tiles */
+	string lazyNCFile;
+	/*! \brief tiled access to a variable of the loaded file (NULL if not relevant) */
+	template<typename T> NCTileCache<T>* lazyTiles(NcVar&, size_t&, size_t&, size_t&, size_t&, int);
 	/*! \transpose data from fortran netcdf*/
 	double* readAndTransposeFortranProjectedField(NcVar* , const size_t& ,const size_t&  , const size_t& ,const size_t& ,bool  ,  int );
 	int*    readAndTransposeIntFortranProjectedField(NcVar* , const size_t& ,const size_t&  , const size_t& ,const size_t&, bool ,  int );
@@ -231,11 +235,19 @@ public:
 
 	/*! \brief registering a propagation model */
 	void registerPropagationModel(PropagationModel*);
+	/*! \brief forgetting the property getters of a propagation model index */
+	void unregisterPropagationModel(const size_t&);
 	vector<string> getAllLayerNames() ;
+	/*! \brief memory held by each layer (bytes), by name */
+	void getLayersMemory(map<string, size_t>&);
+	/*! \brief releasing the data that the layers can read again, returns the bytes freed */
+	size_t releaseLayerCaches();
 	void updateFuelValues(PropagationModel*, string key, double value );
 
 	/*! \brief registering a flux model */
 	void registerFluxModel(FluxModel*);
+	/*! \brief forgetting the property getters of a flux model index */
+	void unregisterFluxModel(const size_t&);
 
 	/*! \brief registering a layer in the data broker */
 	void registerLayer(string, DataLayer<double>*);
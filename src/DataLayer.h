@@ -75,6 +75,22 @@ public:
 	virtual void dumpAsBinary(string, const double&
 			, FFPoint&, FFPoint&, size_t&, size_t&) = 0;
 
+	/*! \brief true if getValueAt(FFPoint, double) may be called by several threads at once */
+	virtual bool concurrentReads(){ return false; }
+
+	/*! \brief memory held by the layer (bytes), 0 for layers computed on the fly */
+	virtual size_t getMemorySize(){ return 0; }
+	/*! \brief releasing the data that can be read again on demand, returns the bytes freed */
+	virtual size_t releaseCache(){ return 0; }
+	/*! \brief releasing the copy of the whole field made by getMatrix, if any, returns the bytes freed */
+	virtual size_t releaseMatrix(){ return 0; }
+
+protected:
+	/*! \brief memory of an array held by the layer (bytes) */
+	template<typename U> static size_t arrayMemory(FFArray<U>* a){
+		return a ? a->getSize()*sizeof(U) : 0;
+	}
+
 
 };
 
@@ -18,8 +18,13 @@ namespace libforefire{
 
 
 EventCommand::EventCommand(string scommand, double schedueledTime) : ForeFireAtom(schedueledTime) {
-	schedueledCommand = scommand;
+	Command::compileCommand(scommand, schedueledCommand);
+};
 
+EventCommand::EventCommand(const CompiledCommand& ccommand, double schedueledTime)
+	: ForeFireAtom(schedueledTime), schedueledCommand(ccommand) {
+	/* the event executes the command itself, not its scheduling */
+	schedueledCommand.scheduled = false;
 };
 
 EventCommand::~EventCommand() {};
@@ -29,7 +34,7 @@ EventCommand::~EventCommand() {};
 
 
 void EventCommand::update(){
-	Command::ExecuteCommand(schedueledCommand);
+	Command::executeCompiled(schedueledCommand);
 }
 void EventCommand::timeAdvance(){
 	setUpdateTime(numeric_limits<double>::infinity());
@@ -37,10 +42,14 @@ void EventCommand::timeAdvance(){
 void EventCommand::input(){};
 
 void EventCommand::output(){};
+string EventCommand::getCommand(){
+	return schedueledCommand.text;
+}
+
 string  EventCommand::toString(){
 	ostringstream oss;
 
-	oss<<schedueledCommand<<"@"<<getTime();
+	oss<<schedueledCommand.text<<"@"<<getTime();
 	return		oss.str();
 }
 };
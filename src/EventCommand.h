@@ -12,6 +12,7 @@
 #include "Command.h"
 #include "include/Futils.h"
 #include "ForeFireAtom.h"
+#include "CompiledCommand.h"
 
 using namespace std;
 
@@ -24,13 +25,15 @@ namespace libforefire{
  */
 class EventCommand: public ForeFireAtom {
 
-	string schedueledCommand;
+	CompiledCommand schedueledCommand; /*!< command, parsed when scheduled */
 
 public:
 	/*! \brief Default constructor */
 	EventCommand() : ForeFireAtom(0.) {};
 	/*! \brief standard constructor */
 	EventCommand( string, double ) ;
+	/*! \brief constructor from an already compiled command */
+	EventCommand( const CompiledCommand&, double ) ;
 	/*! \brief Default destructor */
 	~EventCommand();
 
@@ -42,6 +45,9 @@ public:
 	void timeAdvance();
 	void output();
 
+	/*! \brief accessor to the scheduled command */
+	string getCommand();
+
 	string  toString();
 };
 
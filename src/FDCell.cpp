@@ -9,14 +9,19 @@
 #include "FDCell.h"
 #include "Visitor.h"
 #include "FluxLayer.h"
+#include "Logger.h"
 
 namespace libforefire {
 
 const double FDCell::infinity = numeric_limits<double>::infinity();
 bool FDCell::outputs = false;
+size_t FDCell::revisionCounter = 0;
+size_t FDCell::landscapeCounter = 0;
 
 FDCell::FDCell(FireDomain* fd, size_t nx, size_t ny) :
-		domain(fd), mapSizeX(nx), mapSizeY(ny) {
+		domain(fd), mapSizeX(nx), mapSizeY(ny), revision(0),
+		lastArrival(-infinity), lastArrivalI(0), lastArrivalJ(0),
+		lastArrivalValid(false), binLandscape(0) {
 	FFPoint defaultPoint = FFPoint();
 	SWCorner = defaultPoint;
 	NECorner = defaultPoint;
@@ -73,40 +78,72 @@ void FDCell::setMatrixSize(const size_t& nx, const size_t& ny){
 
 void FDCell::setArrivalTime(const size_t& i, const size_t& j, double time){
 	if ( !allocated ){
-		arrivalTimes = new BurningMap(SWCorner, NECorner, mapSizeX, mapSizeY);
+		arrivalTimes = newBurningMap();
 		allocated = true;
 	}
-	if ( time < (*arrivalTimes)(i,j) ) (*arrivalTimes)(i,j) = time;
+	if ( time < (*arrivalTimes)(i,j) ) {
+		arrivalTimes->set(i, j, time);
+		touch();
+	}
 }
 
 double FDCell::getArrivalTime(const size_t& i, const size_t& j){
 	if ( arrivalTimes == 0 ) return infinity;
 	return (*arrivalTimes)(i,j);
 }
+
+double FDCell::getLastArrivalTime(size_t& li, size_t& lj){
+	if ( !lastArrivalValid ){
+		lastArrival = -infinity;
+		lastArrivalI = 0;
+		lastArrivalJ = 0;
+		if ( arrivalTimes != 0 ){
+			/* an unburnt point is the latest one, no need to look further */
+			for ( size_t i = 0; i < arrivalTimes->getSizeX() and lastArrival < infinity; i++ ){
+				for ( size_t j = 0; j < arrivalTimes->getSizeY(); j++ ){
+					double at = (*arrivalTimes)(i,j);
+					if ( at > lastArrival ){
+						lastArrival = at;
+						lastArrivalI = i;
+						lastArrivalJ = j;
+						if ( at == infinity ) break;
+					}
+				}
+			}
+		}
+		lastArrivalValid = true;
+	}
+	li = lastArrivalI;
+	lj = lastArrivalJ;
+	return lastArrival;
+}
 void FDCell::loadBin(std::ifstream&  FileIn){
 	if ( !allocated ){
-		arrivalTimes = new BurningMap(SWCorner, NECorner, mapSizeX, mapSizeY);
+		arrivalTimes = newBurningMap();
 		allocated = true;
 	}
 				
 	arrivalTimes->loadBin(FileIn);
+	touch();
 }
 
 void FDCell::setBMapValues(const double* newVals){
 	if ( !allocated ){
-		arrivalTimes = new BurningMap(SWCorner, NECorner, mapSizeX, mapSizeY);
+		arrivalTimes = newBurningMap();
 		allocated = true;
 	}
 				
-	arrivalTimes->getMap()->setVal(newVals);
+	arrivalTimes->setVal(newVals);
+	touch();
 }
 
 FireDomain* FDCell::getDomain(){
 	return domain;
 }
 
-FFArray<double>* FDCell::getBurningMatrix(){
-	return arrivalTimes->getMap();
+BurningMap* FDCell::newBurningMap(){
+	bool single = domain != 0 and domain->getSinglePrecisionBurningMaps();
+	return new BurningMap(SWCorner, NECorner, mapSizeX, mapSizeY, single);
 }
 
 size_t FDCell::getBMapSizeX(){
@@ -256,7 +293,7 @@ int FDCell::activeModelsOnBmap(string layername,const double& t, int* modelCount
 }
 
 
-double FDCell::applyModelsOnBmap(string layername, const double& bt, const double& et,int* modelCount){
+double FDCell::applyModelsOnBmap(string layername, const double& bt, const double& et,int* modelCount, double* binningError){
 	/* if the burning map is not allocated */
 	if ( arrivalTimes == 0 ){ 
 		return 0.;
@@ -265,6 +302,9 @@ double FDCell::applyModelsOnBmap(string layername, const double& bt, const doubl
 	/* loading the flux layer */
 	FluxLayer<double>* layer = domain->getFluxLayer(layername);
 
+	if ( domain->getFluxBinningTolerance() > 0. )
+		return applyModelsOnBins(layer, bt, et, modelCount, binningError);
+
 	 
 	/* else getting the ratio and checking
 	 * that there is still something burning*/
@@ -297,15 +337,119 @@ double FDCell::applyModelsOnBmap(string layername, const double& bt, const doubl
 	return cellFlux/mapSize;
 }
 
+double FDCell::applyModelsOnBins(FluxLayer<double>* layer, const double& bt, const double& et
+		, int* modelCount, double* binningError){
+	/* Sub-pixels sharing a flux model, a fuel and an arrival time bin
+	 * of 'fluxBinningTolerance' seconds are evaluated once, at the
+	 * location of the first of them and at their mean arrival time,
+	 * the value being weighted by their number. Other properties of
+	 * the models are thus taken at that location. The error is
+	 * estimated from the values at the earliest and latest arrival
+	 * times of each bin. The model and fuel indices of the points are
+	 * looked up once, and again after a change of the landscape. */
+	struct FluxBin {
+		int model, fuel;
+		long bin;
+		size_t count;
+		double sumAt, minAt, maxAt;
+		FFPoint loc;
+	};
+	/* bins are few and neighbouring pixels mostly fall in the same
+	 * one, the last bin found is thus checked first */
+	vector<FluxBin> bins;
+	size_t last = 0;
+	double tolerance = domain->getFluxBinningTolerance();
+
+	if ( binLandscape != landscapeCounter ){
+		binModels.clear();
+		binFuels.clear();
+		binLandscape = landscapeCounter;
+	}
+	vector<int>& models = binModels[layer];
+	if ( models.size() != mapSize or binFuels.size() != mapSize ){
+		DataLayer<double>* fuelLayer = domain->getDataLayer("fuel");
+		models.resize(mapSize);
+		binFuels.resize(mapSize);
+		FFPoint center;
+		center.setX(SWCorner.getX()+0.5*dx);
+		for ( size_t i = 0; i < mapSizeX; i++ ){
+			center.setY(SWCorner.getY()+0.5*dy);
+			for ( size_t j = 0; j < mapSizeY; j++ ){
+				models[i*mapSizeY+j] = layer->getFunctionIndexAt(center, bt);
+				binFuels[i*mapSizeY+j] = ( fuelLayer != 0 ) ? (int) fuelLayer->getValueAt(center, bt) : 0;
+				center.setY(center.getY()+dy);
+			}
+			center.setX(center.getX()+dx);
+		}
+	}
+
+	FFPoint center;
+	center.setX(SWCorner.getX()+0.5*dx);
+	for ( size_t i = 0; i < mapSizeX; i++ ){
+		center.setY(SWCorner.getY()+0.5*dy);
+		for ( size_t j = 0; j < mapSizeY; j++ ){
+			double arrivalTime = (*arrivalTimes)(i,j);
+			if ( arrivalTime < et ) {
+				int modelIndex = models[i*mapSizeY+j];
+				// no model defined in the area, nothing released
+				if ( modelIndex >= 0 ){
+					int fuel = binFuels[i*mapSizeY+j];
+					long bin = (long) floor(arrivalTime/tolerance);
+					if ( last >= bins.size() or bins[last].model != modelIndex
+							or bins[last].fuel != fuel or bins[last].bin != bin ){
+						for ( last = 0; last < bins.size(); last++ ){
+							if ( bins[last].model == modelIndex and bins[last].fuel == fuel
+									and bins[last].bin == bin ) break;
+						}
+					}
+					if ( last == bins.size() ){
+						FluxBin nb = {modelIndex, fuel, bin, 1, arrivalTime, arrivalTime, arrivalTime, center};
+						bins.push_back(nb);
+					} else {
+						FluxBin& b = bins[last];
+						b.count++;
+						b.sumAt += arrivalTime;
+						b.minAt = min(b.minAt, arrivalTime);
+						b.maxAt = max(b.maxAt, arrivalTime);
+					}
+				}
+			}
+			center.setY(center.getY()+dy);
+		}
+		center.setX(center.getX()+dx);
+	}
+
+	double cellFlux = 0.;
+	double cellError = 0.;
+	for ( size_t k = 0; k < bins.size(); k++ ){
+		FluxBin& b = bins[k];
+		int modelIndex = b.model;
+		double meanAt = b.sumAt/b.count;
+		double value = domain->getModelValueAt(modelIndex, b.loc, bt, et, meanAt);
+		if ( std::isnan(value) ) continue;
+		cellFlux += b.count*value;
+		if ( value > 0 ) modelCount[modelIndex] += b.count;
+		if ( binningError != 0 and b.maxAt > b.minAt ){
+			double vmin = domain->getModelValueAt(modelIndex, b.loc, bt, et, b.minAt);
+			double vmax = domain->getModelValueAt(modelIndex, b.loc, bt, et, b.maxAt);
+			double err = max(abs(vmin - value), abs(vmax - value));
+			if ( !std::isnan(err) ) cellError += b.count*err;
+		}
+	}
+	if ( binningError != 0 ) *binningError = max(*binningError, cellError/mapSize);
+	/* taking the mean */
+	return cellFlux/mapSize;
+}
+
 void FDCell::interpolateArrivalTimes(Array2DdataLayer<double>* bmap
 		, const int& year, const int& day, const int& time){
 	if ( arrivalTimes != 0 ) delete arrivalTimes;
-	arrivalTimes = new BurningMap(SWCorner, NECorner, mapSizeX, mapSizeY);
+	arrivalTimes = newBurningMap();
 	bool relevant = false;
 	double stubTime = 0.;
 	for ( size_t i = 0; i < mapSizeX; i++ ){
 		for ( size_t j = 0; j < mapSizeY; j++ ){
-			(*arrivalTimes)(i,j) = bmap->getValueAt(arrivalTimes->getCenter(i, j), stubTime);
+			arrivalTimes->set(i, j, bmap->getValueAt(arrivalTimes->getCenter(i, j), stubTime));
 			if ( (*arrivalTimes)(i,j) != infinity ) relevant = true;
 		}
 	}
@@ -313,6 +457,7 @@ void FDCell::interpolateArrivalTimes(Array2DdataLayer<double>* bmap
 		delete arrivalTimes;
 		arrivalTimes = 0;
 	}
+	touch();
 }
 
 FireNode* FDCell::getFirenodeByID(const long& sid){
@@ -409,7 +554,7 @@ void FDCell::validateTopology(string call){
 		domain->addToTrashNodes(toBeTrashed.back());
 		toBeTrashed.pop_back();
 	}
-	if ( outputs ) cout<<debugOutput.str();
+	FF_DEBUG(cell, debugOutput.str());
 }
 
 void FDCell::makeTrash(){
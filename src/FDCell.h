@@ -22,6 +22,7 @@ using namespace std;
 namespace libforefire {
 
 class FireDomain;
+template<typename T> class FluxLayer;
 
 class FDCell {
 
@@ -35,10 +36,28 @@ class FDCell {
 
 	BurningMap* arrivalTimes; /*!< Burning map inside the cell */
 	bool allocated; /*!< boolean for the allocation of the burning map */
+	size_t revision; /*!< value of 'revisionCounter' at the last change of the burning map */
+	double lastArrival; /*!< latest arrival time of the burning map */
+	size_t lastArrivalI, lastArrivalJ; /*!< location of the latest arrival time */
+	bool lastArrivalValid; /*!< boolean for the latest arrival time being up to date */
 
 	list<FireNode*>::iterator ifn;
 
 	static const double infinity;
+	static size_t revisionCounter; /*!< number of changes of all the burning maps */
+	static size_t landscapeCounter; /*!< number of changes of the landscape layers */
+
+	/* flux model and fuel indices of the points of the burning map,
+	 * looked up once for the binned flux integration */
+	map<FluxLayer<double>*, vector<int> > binModels; /*!< model indices by flux layer */
+	vector<int> binFuels; /*!< fuel indices */
+	size_t binLandscape; /*!< value of 'landscapeCounter' when the indices were looked up */
+
+	/*! \brief allocating a burning map with the precision of the domain */
+	BurningMap* newBurningMap();
+
+	/*! \brief computing a flux on the cell by bins of sub-pixels */
+	double applyModelsOnBins(FluxLayer<double>*, const double&, const double&, int*, double*);
 
 public:
 
@@ -92,13 +111,24 @@ public:
 	FFPoint& getSWCorner();
 	FFPoint& getNECorner();
 
-	/*! \brief accessors to the burning matrix and properties */
-	FFArray<double>* getBurningMatrix();
+	/*! \brief accessors to the burning matrix properties */
 	size_t getBMapSizeX();
 	size_t getBMapSizeY();
 
 	/*! \brief accessor to the burning matrix */
 	double getArrivalTime(const size_t&, const size_t&);
+	/*! \brief latest arrival time of the burning matrix and its location,
+	 *  only searched for again after a change of the matrix */
+	double getLastArrivalTime(size_t&, size_t&);
+
+	/*! \brief marking the burning map as changed */
+	void touch(){ revision = ++revisionCounter; lastArrivalValid = false; }
+	/*! \brief value of the counter at the last change of the burning map */
+	size_t getRevision(){ return revision; }
+	/*! \brief current value of the counter of changes */
+	static size_t getRevisionCounter(){ return revisionCounter; }
+	/*! \brief marking the landscape (fuels, flux model maps) as changed */
+	static void landscapeChanged(){ landscapeCounter++; }
 
 	/*! \brief number of firenodes */
 	size_t getNumFN();
@@ -109,6 +139,8 @@ public:
 
 	/*! \brief adding a firenode into that cell */
 	void addFireNode(FireNode*);
+	/*! \brief adding a new firenode, not checking whether it is already in the cell */
+	void appendFireNode(FireNode* fn){ fireNodes.push_back(fn); }
 	/*! \brief removing a firenode into that cell */
 	void removeFireNode(FireNode*);
 
@@ -125,8 +157,9 @@ public:
 	/*! \brief computing the max ROS of the cell */
 	double getMaxSpeed(const double&);
 
-	/*! \brief computing a specified flux on the cell */
-	double applyModelsOnBmap(string, const double&, const double&,int* );
+	/*! \brief computing a specified flux on the cell, with an estimate
+	 *  of the error due to the binning of arrival times (if any) */
+	double applyModelsOnBmap(string, const double&, const double&,int*, double* = 0);
 
 	/*! \brief computes a count of each model active on a layer*/
 	int activeModelsOnBmap(string  , const double& , int*);
@@ -0,0 +1,135 @@
+/**
+ * @file FFRaster.h
+ * @brief Contiguous, strided 2d rasters of type T values for LibForeFire
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#ifndef FFRASTER_H_
+#define FFRASTER_H_
+
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <utility>
+
+using namespace std;
+
+namespace libforefire {
+
+/*! \class FFRaster
+ * \brief 2d rasters of type T values stored in one contiguous block
+ *
+ *  FFRaster holds the data extracted on a regular grid of 'nx'
+ *  columns along the x axis and 'ny' values along the y axis,
+ *  with the same [i][j] indexing as the matrices returned by
+ *  FireDomain::getDataMatrix. Values of a same 'i' are contiguous,
+ *  and consecutive 'i' are 'stride' values apart, the stride being
+ *  padded to a cache line so that rows filled by different threads
+ *  never share one. The raster also keeps the location of the
+ *  center of its first cell and its resolution.
+ */
+template<typename T> class FFRaster {
+
+	size_t nx; /*!< number of values along the x axis */
+	size_t ny; /*!< number of values along the y axis */
+	size_t stride; /*!< distance between two consecutive 'i' */
+	vector<T> values; /*!< contained data */
+
+	double x0; /*!< x coordinate of the center of cell (0,0) */
+	double y0; /*!< y coordinate of the center of cell (0,0) */
+	double dx; /*!< resolution along the x axis */
+	double dy; /*!< resolution along the y axis */
+
+public:
+
+	/*! \brief Default constructor, empty raster */
+	FFRaster() : nx(0), ny(0), stride(0), x0(0.), y0(0.), dx(0.), dy(0.) {}
+	/*! \brief Constructor with dimensions and initial value */
+	FFRaster(size_t ni, size_t nj, T val = 0) : x0(0.), y0(0.), dx(0.), dy(0.) {
+		resize(ni, nj, val);
+	}
+
+	/*! \brief re-dimensioning the raster, all values are reset */
+	void resize(size_t ni, size_t nj, T val = 0){
+		size_t pad = 64/sizeof(T);
+		if ( pad < 1 ) pad = 1;
+		nx = ni;
+		ny = nj;
+		stride = ((ny + pad - 1)/pad)*pad;
+		values.assign(nx*stride, val);
+	}
+
+	/*! \brief setting the location of the first cell and the resolution */
+	void setGeometry(double cx, double cy, double resX, double resY){
+		x0 = cx;
+		y0 = cy;
+		dx = resX;
+		dy = resY;
+	}
+
+	/*!  \brief accessor of the value at position (i,j) */
+	const T& operator() (size_t i, size_t j) const { return values[i*stride + j]; }
+	/*!  \brief mutator of the value at position (i,j) */
+	T& operator() (size_t i, size_t j) { return values[i*stride + j]; }
+
+	/*!  \brief pointer to the 'ny' contiguous values of column 'i' */
+	T* row(size_t i) { return &values[i*stride]; }
+	const T* row(size_t i) const { return &values[i*stride]; }
+	/*!  \brief pointer to the first element */
+	T* data() { return values.empty() ? 0 : &values[0]; }
+	const T* data() const { return values.empty() ? 0 : &values[0]; }
+
+	size_t sizeX() const { return nx; }
+	size_t sizeY() const { return ny; }
+	size_t getStride() const { return stride; }
+	bool empty() const { return nx == 0 || ny == 0; }
+
+	double getX0() const { return x0; }
+	double getY0() const { return y0; }
+	double getDx() const { return dx; }
+	double getDy() const { return dy; }
+
+	/*! \brief minimum and maximum of the values, infinite values being ignored */
+	void minMax(double& minVal, double& maxVal) const {
+		minVal = numeric_limits<double>::max();
+		maxVal = numeric_limits<double>::lowest();
+		for ( size_t i = 0; i < nx; i++ ){
+			const T* col = row(i);
+			for ( size_t j = 0; j < ny; j++ ){
+				double val = (double) col[j];
+				if ( val == numeric_limits<double>::infinity() ) continue;
+				if ( val < minVal ) minVal = val;
+				if ( val > maxVal ) maxVal = val;
+			}
+		}
+	}
+
+	/*! \brief copy of the raster as a matrix of vectors */
+	vector<vector<double> > toMatrix() const {
+		vector<vector<double> > matrix(nx, vector<double>(ny));
+		for ( size_t i = 0; i < nx; i++ ){
+			const T* col = row(i);
+			for ( size_t j = 0; j < ny; j++ ) matrix[i][j] = (double) col[j];
+		}
+		return matrix;
+	}
+
+	/*! \brief exchanging the content of two rasters */
+	void swap(FFRaster<T>& other){
+		std::swap(nx, other.nx);
+		std::swap(ny, other.ny);
+		std::swap(stride, other.stride);
+		values.swap(other.values);
+		std::swap(x0, other.x0);
+		std::swap(y0, other.y0);
+		std::swap(dx, other.dx);
+		std::swap(dy, other.dy);
+	}
+
+};
+
+}
+
+#endif /* FFRASTER_H_ */
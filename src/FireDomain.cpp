@@ -8,8 +8,13 @@
 
  #include "FireDomain.h"
  #include "BurningMapLayer.h"
+ #include "ArrivalTimeSeries.h"
+ #include "FrontDepthField.h"
+ #include "RasterPropagator.h"
+ #include "Logger.h"
  
  #include <sys/stat.h>
+ #include <thread>
  #include "RosLayer.h"
  
  namespace libforefire{
@@ -337,6 +342,9 @@
 		}
 	
 		if ( mainFrontBackup != 0 ) delete mainFrontBackup;
+		if ( atimeSeries != 0 ) delete atimeSeries;
+		if ( depthField != 0 ) delete depthField;
+		if ( rasterEngine != 0 ) delete rasterEngine;
 	}
  
 	 void FireDomain::backupState(){
@@ -357,6 +365,33 @@
  void FireDomain::setSpatialIncrement(double inc) {
 	 this->spatialIncrement = inc;
  }
+ void FireDomain::reloadScalarParameters() {
+	 /* only the values that can change during a run, sizes of the
+	  * burning matrices and models stay as they were initialized */
+	 burningTresholdFlux = params->getDouble("burningTresholdFlux");
+	 fluxBinningTolerance = params->getDouble("fluxBinningTolerance");
+	 maxFrontDepth = params->getDouble("maxFrontDepth");
+	 propagationSpeedAdjustmentFactor = params->getDouble("propagationSpeedAdjustmentFactor");
+ }
+ void FireDomain::reloadModels() {
+	 /* models cache their coefficients when constructed, new instances
+	  * are registered at the same indices; previous instances are not
+	  * freed as layers may still refer to them */
+	 for ( size_t i = 0; i < NUM_MAX_PROPMODELS; i++ ){
+		 if ( propModelsTable[i] == 0 ) continue;
+		 string name = propModelsTable[i]->getName();
+		 dataBroker->unregisterPropagationModel(i);
+		 if ( propModelInstanciation(i, name) == 0 )
+			 FF_WARNING(model, "could not reload propagation model " << name);
+	 }
+	 for ( size_t i = 0; i < NUM_MAX_FLUXMODELS; i++ ){
+		 if ( fluxModelsTable[i] == 0 ) continue;
+		 string name = fluxModelsTable[i]->getName();
+		 dataBroker->unregisterFluxModel(i);
+		 if ( fluxModelInstanciation(i, name) == 0 )
+			 FF_WARNING(model, "could not reload flux model " << name);
+	 }
+ }
  void FireDomain::pushMultiDomainMetadataInList(size_t id, double lastTime, size_t atmoNX, size_t atmoNY, double nswx, double nswy, double nnex, double nney) {
 	 distributedDomainInfo *currentInfo = new distributedDomainInfo;
 	 currentInfo->ID = id;
@@ -411,11 +446,12 @@
 	 void FireDomain::restoreValidState(){
 		 /* Restoring a previously saved valid state */
 		 if ( mainFrontBackup == 0 ){
-			 debugOutput<<getDomainID()<<": PROBLEM, tried to return to a valid state"
-			 <<" while no backup state is available"<<endl;
-		 } else {
-			 debugOutput<<getDomainID()<<": RECONSTRUCTING STATE"<<endl;
+			 /* the backup may have been dropped to meet the memory budget */
+			 FF_WARNING(domain, getDomainID()<<": PROBLEM, tried to return to a valid state"
+			 <<" while no backup state is available, keeping the current state");
+			 return;
 		 }
+		 debugOutput<<getDomainID()<<": RECONSTRUCTING STATE"<<endl;
 		 /* Trashing the current state */
 		 trashFrontsAndNodes();
 		 /* Restoring the valid state */
@@ -508,6 +544,24 @@
 	 double& FireDomain::getPerimeterResolution(){
 		 return perimeterResolution;
 	 }
+
+	 double FireDomain::getLocalPerimeterResolution(FireNode* fn){
+		 /* The chord between two nodes distant of d on a front of
+		  * curvature kappa lies at most d^2.kappa/8 away from it, the
+		  * distance between nodes is thus kept under sqrt(8.tol/kappa).
+		  * Firenodes slower than 'adaptiveResolutionSpeed' are allowed
+		  * a coarser resolution in proportion of their slowness. The
+		  * result lies between the perimeter resolution and
+		  * 'maxPerimeterResolution'. */
+		 if ( !adaptiveResolution or fn->getPrev() == 0 or fn->getNext() == 0 )
+			 return perimeterResolution;
+		 double res = maxPerimeterResolution;
+		 double speed = fn->getSpeed();
+		 if ( speed > EPSILONV ) res = min(res, perimeterResolution*resolutionSpeed/speed);
+		 double kappa = abs(fn->computeCurvature());
+		 if ( kappa > 0. ) res = min(res, sqrt(8.*sagittaTolerance/kappa));
+		 return max(perimeterResolution, res);
+	 }
  
 	 double& FireDomain::getSpatialIncrement(){
 		 return spatialIncrement;
@@ -577,6 +631,153 @@
 	 void FireDomain::deleteAtomOfSimulation(ForeFireAtom* atom){
 		 schedule->dropAtomEvents(atom);
 	 }
+
+	 bool FireDomain::rasterPropagation(){
+		 return params->getParameter("propagationEngine") == "raster";
+	 }
+
+	 void FireDomain::getMemoryUsage(map<string, size_t>& usage){
+		 /* burning maps of the cells */
+		 size_t bmaps = 0;
+		 for ( size_t i = 0; i < atmoNX; i++ ){
+			 for ( size_t j = 0; j < atmoNY; j++ ){
+				 BurningMap* bmap = cells[i][j].getBurningMap();
+				 if ( cells[i][j].isActive() and bmap != 0 ) bmaps += sizeof(BurningMap) + bmap->getStorageSize();
+			 }
+		 }
+		 usage["burningMaps"] = bmaps;
+		 /* data layers, by name */
+		 map<string, size_t> layers;
+		 dataBroker->getLayersMemory(layers);
+		 size_t allLayers = 0;
+		 for ( map<string, size_t>::iterator layer = layers.begin(); layer != layers.end(); ++layer ){
+			 usage["layer." + layer->first] = layer->second;
+			 allLayers += layer->second;
+		 }
+		 usage["layers"] = allLayers;
+		 /* firenodes are never deleted during a run, trashed ones being recycled */
+		 usage["fireNodes"] = (createdNodes.size() - trashNodes.size())*sizeof(FireNode);
+		 usage["trashNodes"] = trashNodes.size()*sizeof(FireNode);
+		 usage["events"] = ( schedule != 0 ) ? schedule->getMemorySize() : 0;
+		 usage["backups"] = ( mainFrontBackup != 0 ) ? mainFrontBackup->getMemorySize() : 0;
+		 usage["frontDepth"] = ( depthField != 0 ) ? depthField->getMemorySize() : 0;
+		 usage["rasterBand"] = ( rasterEngine != 0 ) ? rasterEngine->getMemorySize() : 0;
+		 usage["total"] = bmaps + allLayers + usage["fireNodes"] + usage["trashNodes"]
+				 + usage["events"] + usage["backups"] + usage["frontDepth"] + usage["rasterBand"];
+	 }
+
+	 bool FireDomain::overMemoryBudget(){
+		 double budget = params->getDouble("memoryBudgetMB");
+		 if ( !(budget > 0.) ) return false;
+		 map<string, size_t> usage;
+		 getMemoryUsage(usage);
+		 return usage["total"] > budget*1048576.;
+	 }
+
+	 bool FireDomain::enforceMemoryBudget(){
+		 if ( !overMemoryBudget() ) return false;
+		 /* dropping first what can be read or computed again */
+		 FF_WARNING(domain, getDomainID() << ": memory budget exceeded, releasing the layer caches"
+				 << " and the front depth field");
+		 dataBroker->releaseLayerCaches();
+		 if ( depthField != 0 ) depthField->clear();
+		 if ( !overMemoryBudget() ) return false;
+		 /* then the recycled firenodes */
+		 size_t numPurged = purgeTrashNodes();
+		 FF_WARNING(domain, getDomainID() << ": memory budget exceeded, freed "
+				 << numPurged << " trashed firenodes");
+		 if ( !overMemoryBudget() ) return false;
+		 /* lossy steps only when allowed */
+		 if ( params->getInt("memoryBudgetLossy") != 0 ){
+			 double q = params->getDouble("extinguishedCellsQuantum");
+			 size_t numCompressed = compressExtinguishedCells(getTime(), ( q > 0. ) ? q : 1.);
+			 FF_WARNING(domain, getDomainID() << ": memory budget exceeded, compressed "
+					 << numCompressed << " extinguished cells");
+			 if ( !overMemoryBudget() ) return false;
+			 if ( mainFrontBackup != 0 ){
+				 delete mainFrontBackup;
+				 mainFrontBackup = 0;
+				 FF_WARNING(domain, getDomainID() << ": memory budget exceeded, dropped the backup"
+						 << " of the fronts, topological errors can no longer be recovered from");
+			 }
+			 if ( !overMemoryBudget() ) return false;
+		 }
+		 map<string, size_t> usage;
+		 getMemoryUsage(usage);
+		 FF_WARNING(domain, getDomainID() << ": memory budget of "
+				 << params->getDouble("memoryBudgetMB") << "MB exceeded ("
+				 << usage["total"]/1048576. << "MB), new layers will be refused");
+		 return true;
+	 }
+
+	 size_t FireDomain::purgeTrashNodes(){
+		 if ( trashNodes.empty() ) return 0;
+		 /* a node may have been trashed twice, and trashed nodes
+		  * can still have events at infinity in the timetable */
+		 set<ForeFireAtom*> trashed(trashNodes.begin(), trashNodes.end());
+		 if ( schedule != 0 ) schedule->dropAtomEvents(trashed);
+		 list<FireNode*>::iterator node = createdNodes.begin();
+		 while ( node != createdNodes.end() ){
+			 if ( trashed.count(*node) > 0 ){
+				 node = createdNodes.erase(node);
+			 } else {
+				 ++node;
+			 }
+		 }
+		 for ( set<ForeFireAtom*>::iterator atom = trashed.begin(); atom != trashed.end(); ++atom ){
+			 delete (FireNode*) *atom;
+		 }
+		 trashNodes.clear();
+		 return trashed.size();
+	 }
+
+	 size_t FireDomain::compressExtinguishedCells(const double& t, double q){
+		 if ( !(q > 0.) ) q = params->getDouble("extinguishedCellsQuantum");
+		 if ( !(q > 0.) ) return 0;
+		 /* residence time of the fire, as in the 'heatFluxBasic' model */
+		 double duration = 300.;
+		 if ( params->isValued("burningDuration") ) duration = params->getDouble("burningDuration");
+		 size_t numCompressed = 0;
+		 size_t numCells = 0;
+		 for ( size_t i = 0; i < atmoNX; i++ ){
+			 for ( size_t j = 0; j < atmoNY; j++ ){
+				 BurningMap* bmap = cells[i][j].getBurningMap();
+				 if ( !cells[i][j].isActive() or bmap == 0 ) continue;
+				 if ( bmap->compressed() ){
+					 numCells++;
+					 continue;
+				 }
+				 if ( !cells[i][j].fireNodes.empty() ) continue;
+				 /* the cell is extinguished once all its points are burnt
+				  * and the last one to burn has burnt for longer than the
+				  * residence time (the latest arrival time is cached by
+				  * the cell until its map changes) */
+				 size_t li = 0;
+				 size_t lj = 0;
+				 double last = cells[i][j].getLastArrivalTime(li, lj);
+				 if ( !(last < t) or !(last + duration < t) ) continue;
+				 /* flux models may burn longer than the nominal residence time */
+				 if ( dataBroker->heatFluxLayer != 0 ){
+					 FFPoint loc = bmap->getCenter(li, lj);
+					 if ( isBurning(loc, t) ) continue;
+				 }
+				 if ( bmap->compress(q) ){
+					 numCompressed++;
+					 numCells++;
+				 }
+			 }
+		 }
+		 params->setSize("compressedCells", numCells);
+		 return numCompressed;
+	 }
+
+	 RasterPropagator* FireDomain::getRasterPropagator(){
+		 if ( rasterEngine == 0 ){
+			 rasterEngine = new RasterPropagator(this, getTime());
+			 addNewAtomToSimulation(rasterEngine);
+		 }
+		 return rasterEngine;
+	 }
  
 	 // Searching for an atom in the entire domain
 	 FireNode* FireDomain::getFireNodeByID(const long& sid){
@@ -758,6 +959,10 @@
 	 bool FireDomain::addScalarLayer(string type, string name, double &x0, double &y0, double& t0, double& width, double& height, double& timespan, size_t& nnx,	size_t& nny, size_t& nnz, size_t& nnk, double* values){
 		 FFPoint origin = FFPoint(x0, y0,0);
 		 FFPoint span = FFPoint(width, height,0);
+		 if ( overMemoryBudget() ){
+			 FF_WARNING(domain, "Memory budget exceeded, refusing layer " << name);
+			 return false;
+		 }
  
 		 XYZTDataLayer<double>* newLayer = new XYZTDataLayer<double>(name, origin,t0, span, timespan, nnx, nny, nnz, nnk, values);
 		 dataBroker->registerLayer(name, newLayer);
@@ -803,6 +1008,10 @@
 				 return true;
 			 }
 			 if ( type == "table" ){
+				 if ( overMemoryBudget() ){
+					 FF_WARNING(domain, "Memory budget exceeded, refusing layer " << name);
+					 return false;
+				 }
  
 					 FuelDataLayer<double>* newlayer = new FuelDataLayer<double>(name,	origin, t0, span, timespan, nnx, nny, nnz, nnk,				values);
 				 
@@ -1084,7 +1293,7 @@
 		 px.push_back(pInter.getX());
 		 py.push_back(pInter.getY());
 		 }else{
-			 cout << getDomainID()<<" have a problem for burning scan"<<endl;
+			 FF_WARNING(domain, getDomainID()<<" have a problem for burning scan");
 		 }
 		 delete [] xpoly;
 		 delete [] ypoly;
@@ -1110,13 +1319,19 @@
 		 if ( maxJ > globalBMapSizeY - 1 ) maxJ = globalBMapSizeY - 1;
  
 		 // II/ Scanning the region
-		 FFPoint node;
+		 bool indexed = ( params->getInt("frontPolygonIndex") != 0 );
+		 PolygonIndex polygon;
+		 if ( indexed ) polygon.build(nvert, vertx, verty);
+		 double x, y;
 		 for ( size_t i = minI; i <= maxI; i++ ){
 			 for ( size_t j = minJ; j <= maxJ; j++ ){
-				 node.setX(SWCornerX()+i*burningMatrixResX);
-				 node.setY(SWCornerY()+j*burningMatrixResY);
-				 if ( burnCheck(i,j,t) and
-					 node.pointInPolygon(nvert, vertx, verty) == expanding ){
+				 x = SWCornerX()+i*burningMatrixResX;
+				 y = SWCornerY()+j*burningMatrixResY;
+				 if ( !burnCheck(i,j,t) ) continue;
+				 FFPoint loc(x, y, 0.);
+				 bool inside = indexed ? polygon.contains(x, y)
+						 : loc.pointInPolygon(nvert, vertx, verty);
+				 if ( inside == expanding ){
 					 setArrivalTime(i-1, j-1, t);
 					 setArrivalTime(i-1, j, t);
 					 setArrivalTime(i, j-1, t);
@@ -1199,14 +1414,24 @@
 		 size_t maxJ = (size_t) ((nec.getY() - SWCornerY())/burningMatrixResY) + 1;
 		 if ( maxJ > globalBMapSizeY - 1 ) maxJ = globalBMapSizeY - 1;
  
-		 // III/ Scanning the region
+		 // III/ Scanning the region, one column of the matrix at a time
 		 double dist, at;
 		 FFPoint node;
+		 size_t numJ = ( maxJ >= minJ ) ? maxJ - minJ + 1 : 0;
+		 vector<double> colx(numJ), coly(numJ);
+		 vector<char> burning(numJ);
 		 node.setX(SWCornerX()+minI*burningMatrixResX);
-		 for ( size_t i = minI; i <= maxI; i++ ){
+		 for ( size_t i = minI; i <= maxI and numJ > 0; i++ ){
+			 node.setY(SWCornerY()+minJ*burningMatrixResY);
+			 for ( size_t j = minJ; j <= maxJ; j++ ){
+				 colx[j-minJ] = node.getX();
+				 coly[j-minJ] = node.getY();
+				 node.setY(node.getY()+burningMatrixResY);
+			 }
+			 domainFront->checkForBurningStatus(numJ, &colx[0], &coly[0], &burning[0]);
 			 node.setY(SWCornerY()+minJ*burningMatrixResY);
 			 for ( size_t j = minJ; j <= maxJ; j++ ){
-				 if ( checkForBurningStatus(node) ){
+				 if ( burning[j-minJ] ){
 					 if ( constantTimeInit ){
 						 setArrivalTime(i-1, j-1, t);
 						 setArrivalTime(i-1, j, t);
@@ -1292,6 +1517,13 @@
 	 bool FireDomain::checkForBurningStatus(FFPoint& loc){
 		 return domainFront->checkForBurningStatus(loc);
 	 }
+
+	 void FireDomain::checkForBurningStatus(const size_t& n, const double* xs
+			 , const double* ys, char* burning){
+		 domainFront->constructVerticesVectors();
+		 domainFront->checkForBurningStatus(n, xs, ys, burning);
+		 domainFront->deleteVerticesVectors();
+	 }
  
 	 // testing if a point is within the domain
 	 bool FireDomain::striclyWithinDomain(FFPoint& p){
@@ -1366,7 +1598,7 @@
 	 double FireDomain::getModelValueAt(int& modelIndex
 										, FFPoint& loc, const double& bt, const double& et, const double& at){
 		 if(fluxModelsTable[0] == NULL){
-			 cout <<"Warning, no  flux layer registered"<<endl;
+			 FF_WARNING(domain, "Warning, no  flux layer registered");
 			 return 0;
 		 }
 		 return fluxModelsTable[modelIndex]->getValueAt(loc, bt, et, at);
@@ -1403,6 +1635,7 @@
 	 void FireDomain::setFrontDepthScheme(string scheme){
 		 if ( scheme == "normalDir" or scheme == "normalDirection" ) fdScheme = normalDir;
 		 if ( scheme == "closest" ) fdScheme = closest;
+		 if ( scheme == "residenceTime" ) fdScheme = residenceTime;
 	 }
  
 	 // Computing the front depth from a firenode
@@ -1447,18 +1680,28 @@
 			 double dist = min(maxFrontDepth, fn->getLoc().distance(C));
 			 return dist;
  
+		 } else if ( fdScheme == residenceTime ) {
+			 /* same interface as 'normalDir', looked up in the cached
+			  * extinction times of the burning map instead of the flux models */
+			 if ( depthField == 0 ) depthField = new FrontDepthField(this);
+			 return depthField->getFrontDepth(fn);
+
 		 } else if ( fdScheme == closest ) {
 			 // TODO
 			 return fn->getFrontDepth();
 		 } else {
-			 cout<<"WARNING: unknown front depth scheme"<<endl;
+			 FF_WARNING(domain, "unknown front depth scheme");
 			 return fn->getFrontDepth();
 		 }
 	 }
  
 	 // Adding a firenode in the right cell
 	 void FireDomain::addFireNodeInCell(FireNode* fn){
-		 getCell(fn)->addFireNode(fn);
+		 if ( bulkInsertion ){
+			 getCell(fn)->appendFireNode(fn);
+		 } else {
+			 getCell(fn)->addFireNode(fn);
+		 }
 	 }
  
 	 // Removing a firenode from a cell
@@ -1689,7 +1932,7 @@
 													 
 													 FileOut.write(reinterpret_cast<const char*>(&localx), sizeof(size_t));
 													 FileOut.write(reinterpret_cast<const char*>(&localy), sizeof(size_t));
-													 cells[i][j].getBurningMap()->getMap()->dumpBin(FileOut);
+													 cells[i][j].getBurningMap()->dumpBin(FileOut);
 													 cells[i][j].setIfAllDumped();
 													 cntCell++;
 												 }
@@ -1794,17 +2037,17 @@
 							 cell.localy = localy;
  
 							 // Retrieve burning map information
-							 FFArray<double>* burningMap = cells[i][j].getBurningMap()->getMap();
-							 cell.nx = burningMap->getDim("x");
-							 cell.ny = burningMap->getDim("y");
-							 cell.nz = burningMap->getDim("z");
-							 cell.nt = burningMap->getDim("t");
- 
-							 // Copy data from FFArray
-							 size_t dataSize = burningMap->getSize();
+							 BurningMap* burningMap = cells[i][j].getBurningMap();
+							 cell.nx = burningMap->getSizeX();
+							 cell.ny = burningMap->getSizeY();
+							 cell.nz = 1;
+							 cell.nt = 1;
+ 
+							 // Copy data from the burning map
+							 size_t dataSize = cell.nx*cell.ny;
 							 
 							 cell.data.resize(dataSize);
-							 std::copy(burningMap->getData(), burningMap->getData() + dataSize, cell.data.begin());
+							 burningMap->copyTo(cell.data.data());
  
 							 // Add to the domain's cell list
 							 domainBCellList.cells.push_back(cell);
@@ -1917,6 +2160,24 @@
  
 	 }
  
+	 size_t FireDomain::getBurningRevision(FFPoint& sw, FFPoint& ne){
+		 if ( ne.getX() <= SWCornerX() or sw.getX() >= NECornerX()
+				 or ne.getY() <= SWCornerY() or sw.getY() >= NECornerY() ) return 0;
+		 double di0 = (sw.getX()-SWCornerX())*inverseCellSizeX;
+		 double dj0 = (sw.getY()-SWCornerY())*inverseCellSizeY;
+		 double di1 = (ne.getX()-SWCornerX())*inverseCellSizeX;
+		 double dj1 = (ne.getY()-SWCornerY())*inverseCellSizeY;
+		 size_t i0 = ( di0 < 0 ) ? 0 : (size_t) di0;
+		 size_t j0 = ( dj0 < 0 ) ? 0 : (size_t) dj0;
+		 size_t i1 = ( di1 > atmoNX - 1 ) ? atmoNX - 1 : (size_t) di1;
+		 size_t j1 = ( dj1 > atmoNY - 1 ) ? atmoNY - 1 : (size_t) dj1;
+		 size_t revision = 0;
+		 for ( size_t i = i0; i <= i1; i++ )
+			 for ( size_t j = j0; j <= j1; j++ )
+				 if ( cells[i][j].getRevision() > revision ) revision = cells[i][j].getRevision();
+		 return revision;
+	 }
+ 
 	 list<FDCell*> FireDomain::getProxCells(FDCell* cell, int range){
 		 list<FDCell*> proxCells;
 		 int i = cell->getI();
@@ -2147,16 +2408,38 @@
 				 where<<"FireDomain::checkTopology for processor "<<getDomainID()<<endl;
 				 throw TopologicalException(debugOutput.str(), where.str());
 			 }
+			 /* resolution of the front on each side of the firenode */
+			 double dloc = d;
+			 double dnext = d;
+			 double dprev = d;
+			 if ( adaptiveResolution ){
+				 dloc = getLocalPerimeterResolution(fn);
+				 dnext = min(dloc, getLocalPerimeterResolution(fn->getNext()));
+				 dprev = min(dloc, getLocalPerimeterResolution(fn->getPrev()));
+				 /* coarsening: the firenode is dropped when its neighbors
+				  * are close enough to be linked directly, with a margin
+				  * so that the new segment is not split again */
+				 if ( min(dprev, dnext) > d and coarseningAllowed(fn) ){
+					 double dlink = min(dprev, dnext);
+					 double distPrevNext = fn->getPrev()->distance(
+							 fn->getNext()->locAtTime(fn->getPrev()->getTime()));
+					 if ( distPrevNext < 1.5*dlink ){
+						 fn->setMerging(fn->getNext());
+						 return;
+					 }
+				 }
+			 }
+
 			 if ( fn->splitAllowed() or( fn->getState() == FireNode::final
 							  and fn->getNext()->splitAllowed() )){
 				 double distToNext = fn->distance(fn->getNext()->locAtTime(fn->getTime()));
-				 if ( distToNext > 2.*d ) fn->setSplitting();
+				 if ( distToNext > 2.*dnext ) fn->setSplitting();
 			 }
  
 			 if ( (fn->getPrev()->getState() == FireNode::final or
 							   fn->getPrev()->splitAllowed()) and fn->splitAllowed() ){
 				 double distToPrev = fn->getPrev()->distance(fn->getLoc());
-				 if ( distToPrev > 2.*d ){
+				 if ( distToPrev > 2.*dprev ){
 					 fn->getFront()->split(fn->getPrev(), fn->getTime());
 				 }
 			 }
@@ -2164,6 +2447,23 @@
 		 }
 	 }
  
+	 bool FireDomain::coarseningAllowed(FireNode* fn){
+		 /* only moving firenodes between moving firenodes of the same
+		  * front are dropped, and never in fronts of less than 8 nodes */
+		 if ( fn->getState() != FireNode::moving ) return false;
+		 FireNode* prev = fn->getPrev();
+		 FireNode* next = fn->getNext();
+		 if ( prev == 0 or next == 0 ) return false;
+		 if ( prev->getState() != FireNode::moving or next->getState() != FireNode::moving ) return false;
+		 if ( prev->getFront() != fn->getFront() or next->getFront() != fn->getFront() ) return false;
+		 FireNode* tmpfn = next;
+		 for ( size_t k = 0; k < 7; k++ ){
+			 if ( tmpfn == 0 or tmpfn == fn ) return false;
+			 tmpfn = tmpfn->getNext();
+		 }
+		 return true;
+	 }
+
 	 void FireDomain::merge(FireNode* fna, FireNode* fnb){
 	 
 		 if ( fna->getFront() == fnb->getFront() ) {
@@ -2284,6 +2584,53 @@
 		 return newff;
 	 }
  
+	 FireFront* FireDomain::addFireFront(const double& t, const size_t& numNodes
+			 , const double* xs, const double* ys, FireFront* container){
+		 /* The nodes are linked in the order of the points and, as in
+		  * Command::completeFront, the gap between the last and first
+		  * points is filled with nodes every two perimeter resolutions.
+		  * Nodes are new and appended to their cells without checking
+		  * for duplicates, and all the events are inserted at once
+		  * instead of searching the schedule for each node. */
+		 double tnodes = t;
+		 double fdepth = params->getDouble("initialFrontDepth");
+		 double kappa = 0.;
+		 FFVector vel;
+		 FFPoint loc;
+		 vector<FFEvent*> events;
+		 events.reserve(numNodes);
+		 FireFront* ff = addFireFront(tnodes, container);
+		 FireNode* prevNode = 0;
+		 FireNode* firstNode = 0;
+		 bulkInsertion = true;
+		 for ( size_t k = 0; k < numNodes; k++ ){
+			 loc.setX(xs[k]);
+			 loc.setY(ys[k]);
+			 FireNode* newfn = FireNodeFactory();
+			 newfn->initialize(loc, vel, tnodes, fdepth, kappa, this, ff, prevNode);
+			 events.push_back(new FFEvent(newfn));
+			 if ( firstNode == 0 ) firstNode = newfn;
+			 prevNode = newfn;
+		 }
+		 if ( firstNode != 0 and firstNode != prevNode ){
+			 /* closing the ring */
+			 int numNewNodes = (int) floor(prevNode->distance2D(firstNode)/(2.*perimeterResolution));
+			 FireNode* lastNode = prevNode;
+			 FFPoint posinc = (1./(numNewNodes + 1))*(firstNode->getLoc() - lastNode->getLoc());
+			 for ( int k = 0; k < numNewNodes; k++ ){
+				 loc = lastNode->getLoc() + (k + 1)*posinc;
+				 FireNode* newfn = FireNodeFactory();
+				 newfn->initialize(loc, vel, tnodes, fdepth, kappa, this, ff, prevNode);
+				 newfn->computeNormal();
+				 events.push_back(new FFEvent(newfn));
+				 prevNode = newfn;
+			 }
+		 }
+		 bulkInsertion = false;
+		 schedule->insertBefore(events);
+		 return ff;
+	 }
+
 	 // Inserting a new event for an existing atom
 	 FFEvent* FireDomain::addNewEvent(ForeFireAtom* atom
 									  , double time, string type){
@@ -2356,7 +2703,7 @@
 			 seg = 3;
 		 }
 		 if ( inter == outPoint ){
-			 cout<<getDomainID()<<": WARNING, did not find intersection with a bounding box"<<endl;
+			 FF_WARNING(domain, getDomainID()<<": did not find intersection with a bounding box");
 		 }
 		 return inter;
 	 }
@@ -2488,6 +2835,7 @@
 		 /* Handling the outputs for debugging */
 		 /*------------------------------------*/
  
+		 Logger::configure(params);
 		 if ( getDomainID()==params->getInt("watchedProc")
 			 or params->getInt("watchedProc") == -1 ) {
 			 if ( params->getInt("CommandOutputs") != 0 ) commandOutputs = true;
@@ -2495,6 +2843,11 @@
 			 if ( params->getInt("FireFrontOutputs") != 0 ) FireFront::outputs = true;
 			 if ( params->getInt("FireNodeOutputs") != 0 ) FireNode::outputs = true;
 			 if ( params->getInt("FDCellOutputs") != 0 ) FDCell::outputs = true;
+			 /* debugging outputs of the watched domain are debug messages */
+			 if ( outputs ) Logger::setLevel(Logger::domain, Logger::debug);
+			 if ( FireFront::outputs ) Logger::setLevel(Logger::front, Logger::debug);
+			 if ( FireNode::outputs ) Logger::setLevel(Logger::node, Logger::debug);
+			 if ( FDCell::outputs ) Logger::setLevel(Logger::cell, Logger::debug);
 		 }
 		// std::cout<<"ID"<<getID()<< " la:"<< refLatitude<<" lo:"<<refLongitude<<" SOUTH:"<<params->getParameter("SOUTH")<<" WEST:"<<params->getParameter("WEST")<<" NORTH:"<<params->getParameter("NORTH")<<" EAST:"<<params->getParameter("EAST")<<endl;
  
@@ -2548,6 +2901,10 @@
 		 /* domain front */
 		 domainFront = FireFrontFactory();
 		 mainFrontBackup = 0;
+		 atimeSeries = 0;
+		 depthField = 0;
+		 rasterEngine = 0;
+		 bulkInsertion = false;
 		 /* timetable */
 		 schedule = 0;
 		 /* boolean of parallel simulations */
@@ -2557,6 +2914,10 @@
 		 numIterationAtmoModel = 0;
 		 /* heat flux treshold for considering a location burning */
 		 burningTresholdFlux = params->getDouble("burningTresholdFlux");
+		 /* arrival time tolerance for the binned integration of the fluxes */
+		 fluxBinningTolerance = params->getDouble("fluxBinningTolerance");
+		 /* storage precision of the burning maps allocated from now on */
+		 singlePrecisionBMaps = params->getParameter("burningMapPrecision") == "float";
 		 /* trigger distance for the computation of front depth */
  
 		 maxFrontDepth = params->getDouble("maxFrontDepth");
@@ -2630,6 +2991,10 @@
 			 cout<<"WARNING: very high spatial increment "
 			 <<spatialIncrement<<" given perimeter resolution "<< perimeterResolution<<endl;
 		 }
+		 adaptiveResolution = ( params->getInt("adaptivePerimeterResolution") != 0 );
+		 maxPerimeterResolution = max(perimeterResolution, params->getDouble("maxPerimeterResolution"));
+		 sagittaTolerance = params->getDouble("perimeterSagittaTolerance");
+		 resolutionSpeed = params->getDouble("adaptiveResolutionSpeed");
  
 		 // Burning map resolution
 		 BMapsResolution = getBurningMapResolution(spatialIncrement
@@ -3297,6 +3662,62 @@
 		return getDataMatrix(name, SWCorner ,NECorner,eni,enj);
 	}
 	std::vector<std::vector<double>> FireDomain::getDataMatrix(const std::string& name, FFPoint& SWbound, FFPoint& NEbound, size_t& eni, size_t& enj) {
+		FFRaster<double> raster;
+		if ( !getDataRaster(name, SWbound, NEbound, eni, enj, raster) ) {
+			// Return a default 1x1 matrix with a placeholder value
+			return std::vector<std::vector<double>>(1, std::vector<double>(1, -9999));
+		}
+		return raster.toMatrix();
+	}
+
+	bool FireDomain::getDataRaster(const std::string& name, FFRaster<double>& raster) {
+		size_t eni = 0;
+		size_t enj = 0;
+		return sampleDataRaster(name, SWCorner, NECorner, eni, enj, raster);
+	}
+	bool FireDomain::getDataRaster(const std::string& name, FFRaster<float>& raster) {
+		size_t eni = 0;
+		size_t enj = 0;
+		return sampleDataRaster(name, SWCorner, NECorner, eni, enj, raster);
+	}
+	bool FireDomain::getDataRaster(const std::string& name, FFPoint& SWbound, FFPoint& NEbound
+			, size_t& eni, size_t& enj, FFRaster<double>& raster) {
+		return sampleDataRaster(name, SWbound, NEbound, eni, enj, raster);
+	}
+	bool FireDomain::getDataRaster(const std::string& name, FFPoint& SWbound, FFPoint& NEbound
+			, size_t& eni, size_t& enj, FFRaster<float>& raster) {
+		return sampleDataRaster(name, SWbound, NEbound, eni, enj, raster);
+	}
+
+	/* kinds of data sampled by getDataRaster */
+	static const int rasterSpeed = 0;
+	static const int rasterArrivalTime = 1;
+	static const int rasterLayer = 2;
+
+	template<typename T>
+	void FireDomain::sampleRasterRows(const int& kind, DataLayer<double>* dataLayer
+			, const double& lTime, FFRaster<T>& raster, size_t i0, size_t i1) {
+		FFPoint itp(raster.getX0(), raster.getY0(), 0.0);
+		size_t enj = raster.sizeY();
+		for (size_t i = i0; i < i1; i++) {
+			itp.setX(raster.getX0() + i*raster.getDx());
+			T* col = raster.row(i);
+			for (size_t j = 0; j < enj; j++) {
+				itp.setY(raster.getY0() + j*raster.getDy());
+				if ( kind == rasterSpeed ) {
+					col[j] = (T) getMaxSpeed(itp);
+				} else if ( kind == rasterArrivalTime ) {
+					col[j] = (T) getArrivalTime(itp);
+				} else {
+					col[j] = (T) dataLayer->getValueAt(itp, lTime);
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	bool FireDomain::sampleDataRaster(const std::string& name, FFPoint& SWbound, FFPoint& NEbound
+			, size_t& eni, size_t& enj, FFRaster<T>& raster) {
 		double extractWidth = NEbound.getX() - SWbound.getX();
 		double extractHeight = NEbound.getY() - SWbound.getY();
 		double domainWidth = NECornerX() - SWCornerX();
@@ -3304,84 +3725,75 @@
 
 		if((extractWidth <= 0) || (extractHeight <= 0)) {
 			std::cerr << "Error: Invalid bounding box " << std::endl;
-			return std::vector<std::vector<double>>(1, std::vector<double>(1, -9999));
+			return false;
 		}
 
-
 		double resX = 0.0;
 		double resY = 0.0;
 		double lTime = getSimulationTime();
-		// Case 1: "speed" data
-		if ((name == "speed") || (name == "arrival_time")) {
+		int kind = rasterLayer;
+		DataLayer<double>* dataLayer = 0;
 
-			// Create a matrix with dimensions (globalBMapSizeX x globalBMapSizeY), initialized to -9999
+		if ((name == "speed") || (name == "arrival_time")) {
+			kind = (name == "speed") ? rasterSpeed : rasterArrivalTime;
+			// Default resolution is the one of the burning matrix
 			if ((eni == 0)||(enj == 0)) {
 				resX = domainWidth/globalBMapSizeX;
-				resY = domainHeight/globalBMapSizeY;		
+				resY = domainHeight/globalBMapSizeY;
 				eni = extractWidth/resX;
 				enj = extractHeight/resY;
 			}else{
 				resX = extractWidth/eni;
 				resY = extractHeight/enj;
 			}
-
-			std::vector<std::vector<double>> matrix(eni, std::vector<double>(enj, -9999));
-
-			FFPoint itp = FFPoint(SWbound.getX()+resX/2, SWbound.getY()+resY/2, 0.0);
-			if (name == "speed") {
-				for (size_t i = 0; i < eni; i++) {
-					itp.setX(SWbound.getX()+resX/2 + i*resX);
-					for (size_t j = 0; j < enj; j++) {
-						itp.setY(SWbound.getY()+resY/2 + j*resY);
-						matrix[i][j] = getMaxSpeed(itp);  
-					}
-				}
+		} else {
+			// Data available from a data or a flux layer
+			dataLayer = getDataLayer(name);
+			if (dataLayer == 0) {
+				cout << "DataLayer is null from data" << endl;
+				dataLayer = getFluxLayer(name);
 			}
-			if (name == "arrival_time") {
-				for (size_t i = 0; i < eni; i++) {
-					itp.setX(SWbound.getX()+resX/2 + i*resX);
-					for (size_t j = 0; j < enj; j++) {
-						itp.setY(SWbound.getY()+resY/2 + j*resY);
-						matrix[i][j] = getArrivalTime(itp);  
-					}
-				}
+			if (dataLayer == 0) {
+				std::cerr << "Error: Data name '" << name << "' not recognized." << std::endl;
+				return false;
 			}
-			return matrix;
-		}
-		// Case 3: Data available from a FluxLayer
-		DataLayer<double>* dataLayer = getDataLayer(name);
-		if (dataLayer == 0) {
-			cout << "DataLayer is null from data" << endl;
-			dataLayer = getFluxLayer(name);
-		
-		}
-	 	if (dataLayer != 0) {
-			
 			if ((eni == 0)||(enj == 0)) {
 				resX = dataLayer->getDx();
-				resY = dataLayer->getDy();	
+				resY = dataLayer->getDy();
 				eni = extractWidth/resX;
 				enj = extractHeight/resY;
 			}else{
 				resX = extractWidth/eni;
 				resY = extractHeight/enj;
 			}
-			FFPoint itp = FFPoint(SWbound.getX()+resX/2, SWbound.getY()+resY/2, 0.0);
-			std::vector<std::vector<double>> matrix(eni, std::vector<double>(enj, -9999));
-			for (size_t i = 0; i < eni; i++) {
-				itp.setX(SWbound.getX()+resX/2 + i*resX);
-				for (size_t j = 0; j < enj; j++) {
-					itp.setY(SWbound.getY()+resY/2 + j*resY);
-					matrix[i][j] = dataLayer->getValueAt(itp,lTime);  
-				}
-			}
-			return matrix;
 		}
 
-		// Error case: Unrecognized data name
-		std::cerr << "Error: Data name '" << name << "' not recognized." << std::endl;
-		// Return a default 1x1 matrix with a placeholder value
-		return std::vector<std::vector<double>>(1, std::vector<double>(1, -9999));
+		raster.resize(eni, enj, (T) -9999);
+		raster.setGeometry(SWbound.getX()+resX/2, SWbound.getY()+resY/2, resX, resY);
+
+		/* rows are shared in contiguous blocks between threads, layers
+		 * that are not safe for concurrent reads are sampled serially */
+		size_t numThreads = 1;
+		int maxThreads = params->getInt("rasterThreads");
+		if ( maxThreads <= 0 ) maxThreads = (int) std::thread::hardware_concurrency();
+		if ( maxThreads > 1 && eni*enj >= 4096
+				&& ( dataLayer == 0 || dataLayer->concurrentReads() ) ) {
+			numThreads = std::min((size_t) maxThreads, eni);
+		}
+		if ( numThreads < 2 ) {
+			sampleRasterRows(kind, dataLayer, lTime, raster, 0, eni);
+			return true;
+		}
+		size_t block = (eni + numThreads - 1)/numThreads;
+		std::vector<std::thread> workers;
+		for ( size_t i0 = block; i0 < eni; i0 += block ) {
+			size_t i1 = std::min(i0 + block, eni);
+			workers.push_back(std::thread(&FireDomain::sampleRasterRows<T>, this
+					, kind, dataLayer, lTime, std::ref(raster), i0, i1));
+		}
+		sampleRasterRows(kind, dataLayer, lTime, raster, 0, std::min(block, eni));
+		for ( size_t n = 0; n < workers.size(); n++ ) workers[n].join();
+		return true;
 	}
  
  
@@ -3491,7 +3903,20 @@
 		 ostringstream oss;
 		 oss << params->getParameter("caseDirectory") << '/'
 			 << params->getParameter("fireOutputDirectory") << '/'
-			 << params->getParameter("experiment") << "." << getDomainID() << ".nc";
+			 << params->getParameter("experiment") << "." << getDomainID();
+
+		 if ( params->getParameter("bmapOutputMode") == "series" ) {
+			 // Appending the tiles changed since the previous output
+			 oss << ".series.nc";
+			 if ( atimeSeries != 0 and atimeSeries->getPath() != oss.str() ) {
+				 delete atimeSeries;
+				 atimeSeries = 0;
+			 }
+			 if ( atimeSeries == 0 ) atimeSeries = new ArrivalTimeSeries(this, oss.str());
+			 atimeSeries->record();
+			 return;
+		 }
+		 oss << ".nc";
  
 		 // Create and configure the NetCDF file
 		 NcFile dataFile(oss.str(), NcFile::replace);
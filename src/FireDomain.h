@@ -26,6 +26,7 @@
 #include "DataLayer.h"
 #include "FluxLayer.h"
 #include "FFArrays.h"
+#include "FFRaster.h"
 #include "FireNodeData.h"
 #include "FireFrontData.h"
 #include "ParallelException.h"
@@ -35,6 +36,10 @@ using namespace std;
 
 namespace libforefire{
 
+class ArrivalTimeSeries;
+class FrontDepthField;
+class RasterPropagator;
+
 /*! \class FireDomain
  * \brief Class describing the "world" of the simulation
  *
@@ -86,6 +91,10 @@ class FireDomain: public ForeFireAtom, Visitable {
 	/* Spatial parameters */
     /*--------------------*/
 	double perimeterResolution; /*!< perimeter resolution of the fronts */
+	bool adaptiveResolution; /*!< resolution of the fronts adapted to their curvature and speed */
+	double maxPerimeterResolution; /*!< coarsest resolution of the adaptive fronts */
+	double sagittaTolerance; /*!< largest distance between the adaptive fronts and their chords */
+	double resolutionSpeed; /*!< speed under which adaptive fronts are coarsened */
 	double propagationSpeedAdjustmentFactor;/*!< adjustment factor for propagation speed */
 	double spatialCFL; /*!< spatial CFL-like coefficient */
 	double spatialCFLMax; /*!< maximum spatial CFL admitted */
@@ -108,12 +117,15 @@ class FireDomain: public ForeFireAtom, Visitable {
 
 	enum FrontDepthScheme {
 		normalDir = 0,
-		closest = 1
+		closest = 1,
+		residenceTime = 2
 	} ;
 	static FrontDepthScheme fdScheme; /*!< front depth scheme scheme */
 	void setFrontDepthScheme(string);
 
 	double burningTresholdFlux;
+	double fluxBinningTolerance; /*!< arrival time bins of the flux integration (s), 0 for per-pixel */
+	bool singlePrecisionBMaps; /*!< burning maps stored in single precision */
 	double maxFrontDepth;
 	double BMapsResolution;
 
@@ -151,6 +163,18 @@ class FireDomain: public ForeFireAtom, Visitable {
     /*--------------------------*/
 	static FireFrontData* mainFrontBackup;
 
+	/*! \brief change-only series of the arrival time outputs */
+	ArrivalTimeSeries* atimeSeries;
+
+	/*! \brief nodes being added are new, skipping the duplicate checks of the cells */
+	bool bulkInsertion;
+
+	/*! \brief cached residence times for the 'residenceTime' front depth scheme */
+	FrontDepthField* depthField;
+
+	/*! \brief raster propagation engine, when 'propagationEngine' is 'raster' */
+	RasterPropagator* rasterEngine;
+
 	/*---------------------------------------------------*/
 	/* VARIABLES AND ALGORITHMS FOR PARALLEL SIMULATIONS */
 	/*---------------------------------------------------*/
@@ -257,6 +281,11 @@ class FireDomain: public ForeFireAtom, Visitable {
 	/*! \brief Trashing all the fronts of the simulation */
 	void trashFrontsAndNodes();
 
+	friend class Checkpoint;
+	friend class ArrivalTimeSeries;
+	friend class FrontDepthField;
+	friend class RasterPropagator;
+
 	/*! \brief getting the number of the day since the 1st of January */
 	int getDayNumber(const int& = 2012, const int& = 1, const int& = 1);
 
@@ -328,6 +357,10 @@ public:
 
 	void setPerimeterResolution(double res);
 	void setSpatialIncrement(double inc);
+	/*! \brief re-reading the scalar parameters cached at initialization */
+	void reloadScalarParameters();
+	/*! \brief re-instantiating the models, reading their coefficients again */
+	void reloadModels();
 
     // Getter for the reference latitude.
     double getRefLatitude()  ;
@@ -396,8 +429,25 @@ public:
 	FDCell** getCells();
 	list<FDCell*> getProxCells(FDCell*, int = 1);
 	double& getPerimeterResolution();
+	/*! \brief resolution of the front around a firenode, given its curvature and speed */
+	double getLocalPerimeterResolution(FireNode*);
 	double& getSpatialIncrement();
 	double& getMaxTimeStep();
+	double getFluxBinningTolerance(){ return fluxBinningTolerance; }
+	bool getSinglePrecisionBurningMaps(){ return singlePrecisionBMaps; }
+
+	/*! \brief memory held by each subsystem of the domain (bytes) */
+	void getMemoryUsage(map<string, size_t>&);
+	/*! \brief checking whether the memory budget ('memoryBudgetMB') is exceeded */
+	bool overMemoryBudget();
+	/*! \brief releasing caches, compressing extinguished cells and freeing trashed
+	 *  firenodes when over the memory budget, returns whether it is still exceeded */
+	bool enforceMemoryBudget();
+	/*! \brief deleting the trashed firenodes instead of keeping them for recycling */
+	size_t purgeTrashNodes();
+	/*! \brief compressing the burning maps of the cells that are no longer burning,
+	 *  with the given time quantum or 'extinguishedCellsQuantum' */
+	size_t compressExtinguishedCells(const double&, double = 0.);
 	double getArrivalTime(FFPoint&);
 	double getArrivalTime(const size_t&, const size_t&);
 	double getMaxSpeed(FFPoint&);
@@ -458,6 +508,11 @@ public:
 	/*! \brief deleting an atom in the simulation */
 	void deleteAtomOfSimulation(ForeFireAtom*);
 
+	/*! \brief checking whether fires are propagated on the burning map instead of by firenodes */
+	bool rasterPropagation();
+	/*! \brief raster propagation engine, created and scheduled at first call */
+	RasterPropagator* getRasterPropagator();
+
 	/*! \brief getting the layer associated with a property */
 	DataLayer<double>* getDataLayer(const string&);
 
@@ -546,6 +601,8 @@ public:
 
 	/*! \brief callback function from a firenode to check the topology */
 	void checkTopology(FireNode*);
+	/*! \brief checking whether a firenode can be dropped to coarsen its front */
+	bool coarseningAllowed(FireNode*);
 
 	/*! \brief handling the merges in the domain */
 	void merge(FireNode*, FireNode*);
@@ -573,6 +630,10 @@ public:
 	FireNode* addFireNode(FireNodeData*, FireFront* = 0, FireNode* = 0);
 	FireNode* addLinkNode(FFPoint&, FireFront* = 0, FireNode* = 0);
 	FireFront* addFireFront(double, FireFront* = 0);
+	/*! \brief creating a front and all the nodes of a ring of coordinates
+	 *  in one pass, the nodes being scheduled at once */
+	FireFront* addFireFront(const double&, const size_t&
+			, const double*, const double*, FireFront* = 0);
 	FFEvent* addNewEvent(ForeFireAtom*, double, string = "all");
 
 	/*! \brief listing all the firenodes close to a given one */
@@ -629,8 +690,24 @@ public:
     /*! \brief retrun a diag matrix */
 	std::vector<std::vector<double>> getDataMatrix(const std::string& ) ;
 	std::vector<std::vector<double>> getDataMatrix(const std::string& , FFPoint& , FFPoint& , size_t& , size_t& ) ;
+	/*! \brief last change of the burning maps of the cells intersecting a box, 0 if none */
+	size_t getBurningRevision(FFPoint&, FFPoint&);
+	/*! \brief samples the desired data on a regular grid into a contiguous raster */
+	bool getDataRaster(const std::string&, FFPoint&, FFPoint&, size_t&, size_t&, FFRaster<double>&);
+	bool getDataRaster(const std::string&, FFPoint&, FFPoint&, size_t&, size_t&, FFRaster<float>&);
+	/*! \brief samples the desired data on the whole domain at the default resolution */
+	bool getDataRaster(const std::string&, FFRaster<double>&);
+	bool getDataRaster(const std::string&, FFRaster<float>&);
+	/*! \brief samples rows [i0, i1[ of a raster, by one thread of getDataRaster */
+	template<typename T> void sampleRasterRows(const int&, DataLayer<double>*
+			, const double&, FFRaster<T>&, size_t, size_t);
+	/*! \brief common implementation of getDataRaster for all storage types */
+	template<typename T> bool sampleDataRaster(const std::string&, FFPoint&, FFPoint&
+			, size_t&, size_t&, FFRaster<T>&);
 	/*! \brief checking the burning status of a given location */
 	bool checkForBurningStatus(FFPoint&);
+	/*! \brief burning status of a batch of locations, stored as 0 or 1 */
+	void checkForBurningStatus(const size_t&, const double*, const double*, char*);
 
 };
 
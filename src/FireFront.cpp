@@ -8,6 +8,7 @@
 
 #include "FireFront.h"
 #include "Visitor.h"
+#include "Logger.h"
 
 namespace libforefire{
 
@@ -70,6 +71,7 @@ FireFront::~FireFront() {
 	if ( u!=NULL ) delete [] u;
 	if ( z!=NULL ) delete [] z;
 	if ( gamma!=NULL ) delete [] gamma;
+	if ( vertIndex!=NULL ) delete vertIndex;
 }
 
 void FireFront::commonInitialization(){
@@ -95,6 +97,8 @@ void FireFront::commonInitialization(){
 	vertx = 0;
 	verty = 0;
 	nvert = 0;
+	vertIndex = 0;
+	indexVertices = ( SimulationParameters::GetInstance()->getInt("frontPolygonIndex") != 0 );
 	max_inner_front_nodes_filter = 	SimulationParameters::GetInstance()->getInt("max_inner_front_nodes_filter");
 }
 
@@ -203,9 +207,9 @@ size_t FireFront::getNumFN(FireNode* startfn){
 			numFirenodes = numFN;
 			return numFN;
 		} catch ( const logic_error & e ) {
-			cout<<"Domain :"<<getDomainID()<<"error getting numFN from "<<startfn<<","<<startfn->toString()<<endl;
+			FF_WARNING(front, "Domain :"<<getDomainID()<<"error getting numFN from "<<startfn<<","<<startfn->toString());
 			if(startfn->getLoc().distance(FFPoint(0,0,0))<0.000001) {
-				cout<<" last node from nowhere, returning no node in front - likely out of physical domain "<<endl;
+				FF_WARNING(front, " last node from nowhere, returning no node in front - likely out of physical domain ");
 				domain->addToTrashFronts(this);
 				return 1;
 			}
@@ -216,30 +220,30 @@ size_t FireFront::getNumFN(FireNode* startfn){
 			list<FireNode*>::iterator node;
 			while ( fn->getNext() != startfn ){
 				if ( fn->getNext() == 0 ){
-					cout<<toString()<<endl
+					FF_WARNING(front, toString()<<endl
 							<<getDomainID()<<": At position "<<numfn<<": "<<fn->toString()
-							<<" has no next ";
+							<<" has no next");
 					if ( numfn == 1 ){
 						domain->addToTrashFronts(this);
 					} else {
-						cout<<"throwing topological exception"<<endl;
+						FF_WARNING(front, "throwing topological exception");
 						throw TopologicalException("", "FireFront::getNumFN()");
 					}
 				}
 				if ( numfn > LOOPLIMIT ){
-					cout<<toString()<<endl
-							<<getDomainID()<<": infinite loop in the front";
-					cout<<"throwing topological exception"<<endl;
+					FF_WARNING(front, toString()<<endl
+							<<getDomainID()<<": infinite loop in the front"
+							<<", throwing topological exception");
 					throw TopologicalException("", "FireFront::getNumFN()");
 				}
 				node = find(alreadyVisitedNodes.begin(), alreadyVisitedNodes.end(), fn);
 				if ( node != alreadyVisitedNodes.end() ){
-					cout<<toString()<<endl
+					FF_WARNING(front, toString()<<endl
 							<<getDomainID()<<": problem at position "<<numfn
-							<<" with an already present firenode: "<<fn->toString()<<endl;
-					cout<<getDomainID()<<":"<<'\t'<<"previous is "<<fn->getPrev()->toShort()
-							<<", startfn is "<<startfn->toShort();
-					cout<<"throwing topological exception"<<endl;
+							<<" with an already present firenode: "<<fn->toString()<<endl
+							<<getDomainID()<<":"<<'\t'<<"previous is "<<fn->getPrev()->toShort()
+							<<", startfn is "<<startfn->toShort()
+							<<", throwing topological exception");
 					throw TopologicalException("", "FireFront::getNumFN()");
 				} else {
 					alreadyVisitedNodes.push_back(fn);
@@ -413,8 +417,8 @@ void FireFront::solveTridiagonalSystem(double* a, double* b
 
 	double beta;
 	if ( b[0] == 0. ){
-		cout<<"PROBLEM: Spline interpolation for "<<toString()
-			<<" resulted in an ill-posed linear problem"<<endl;
+		FF_WARNING(front, "PROBLEM: Spline interpolation for "<<toString()
+			<<" resulted in an ill-posed linear problem");
 		return;
 	}
 	beta = b[0];
@@ -424,8 +428,8 @@ void FireFront::solveTridiagonalSystem(double* a, double* b
 		gamma[j] = c[j-1]/beta;
 		beta = b[j]-a[j]*gamma[j];
 		if ( beta == 0. ){
-			cout<<"PROBLEM: Spline interpolation for "<<toString()
-				<<" resulted in an ill-posed linear problem"<<endl;
+			FF_WARNING(front, "PROBLEM: Spline interpolation for "<<toString()
+				<<" resulted in an ill-posed linear problem");
 			return;
 		}
 		u[j] = (r[j]-a[j]*u[j-1])/beta;
@@ -533,8 +537,8 @@ void FireFront::split(FireNode* fna, const double& t){
 	 * Otherwise taking the middle of the arc passing through the two
 	 * locations and with radius as the mean of the two curvature radius */
 
-	if (outputs) cout<<domain->getDomainID()<<": split between "
-			<<fna->toShort()<<" and "<<fna->getNext()->toShort()<<endl;
+	FF_DEBUG(front, domain->getDomainID()<<": split between "
+			<<fna->toShort()<<" and "<<fna->getNext()->toShort());
 
 	/* Common part for all normal schemes */
 	FireNode* fnb = fna->getNext();
@@ -573,9 +577,9 @@ void FireFront::split(FireNode* fna, const double& t){
 	}
 
 	if ( !domain->withinPhysicalDomain(splitLoc) ){
-		if (outputs) cout<<domain->getDomainID()
+		FF_DEBUG(front, domain->getDomainID()
 				<<": "<<'\t'<<"split is not physical"
-				<<" (location is "<<splitLoc.print()<<")"<<endl;
+				<<" (location is "<<splitLoc.print()<<")");
 		/* the split node shouldn't be created */
 		//if (fna->getState() == FireNode::splitting ) fna->setState(FireNode::moving);
 		return;
@@ -603,32 +607,32 @@ void FireFront::merge(FireNode* fna, FireNode* fnb){
 
 		/* test to see if merging successive nodes */
 		if ( fna == fnb->getNext() or fnb == fna->getNext() ){
-			if (outputs) cout<<getDomainID()
-					<<": merging successive nodes"<<endl;
+			FF_DEBUG(front, getDomainID()
+					<<": merging successive nodes");
 			if ( fnb->getDomainID() != getDomainID() ){
-				if ( outputs ) cout<<"trashing in FireFront::merge : "<<fnb->toString()<<endl;
+				FF_DEBUG(front, "trashing in FireFront::merge : "<<fnb->toString());
 				domain->addToTrashNodes(fnb);
 				fna->setState(FireNode::moving);
 			} else {
-				if ( outputs ) cout<<"trashing in FireFront::merge : "<<fna->toString()<<endl;
+				FF_DEBUG(front, "trashing in FireFront::merge : "<<fna->toString());
 				domain->addToTrashNodes(fna);
 				fnb->setState(FireNode::moving);
 			}
 			// less than 5 nodes total... I need to trash my front, it is too small
 			if ( getNumFN() < 5 ){
-				if (outputs) cout<<getDomainID()
+				FF_DEBUG(front, getDomainID()
 						<<": not enough nodes left in "<<toString()<<" ("
-						<<getNumFN()<<"), trashing it"<<endl;
+						<<getNumFN()<<"), trashing it");
 				FireNode* curfn = headNode;
 				FireNode* next;
 				for ( int numfn = getNumFN()-1; numfn > 0; numfn-- ){
 					next = curfn->getNext();
-					if ( outputs ) cout<<"trashing in FireFront::merge : "<<curfn->toString()<<endl;
+					FF_DEBUG(front, "trashing in FireFront::merge : "<<curfn->toString());
 					domain->addToTrashNodes(curfn);
 					curfn = next;
 				}
 				if ( curfn != 0 ){
-					if ( outputs ) cout<<"trashing in FireFront::merge : "<<curfn->toString()<<endl;
+					FF_DEBUG(front, "trashing in FireFront::merge : "<<curfn->toString());
 					domain->addToTrashNodes(curfn);
 				}
 				domain->addToTrashFronts(this);
@@ -642,21 +646,21 @@ void FireFront::merge(FireNode* fna, FireNode* fnb){
 		/* If there is only one node between the two
 		 * merging nodes, I just trash this node */
 		if ( fna->getPrev() == fnb->getNext() ){
-			if (outputs) cout<<getDomainID()
-					<<": merging quasi-successive nodes"<<endl;
-			if ( outputs ) cout<<"trashing in FireFront::merge : "<<fna->getPrev()->toString()<<endl;
+			FF_DEBUG(front, getDomainID()
+					<<": merging quasi-successive nodes");
+			FF_DEBUG(front, "trashing in FireFront::merge : "<<fna->getPrev()->toString());
 			domain->addToTrashNodes(fna->getPrev());
 			if ( getNumFN() < 5 ){
 				FireNode* curfn = headNode;
 				FireNode* next;
 				for ( int numfn = getNumFN()-1; numfn > 0; numfn-- ){
 					next = curfn->getNext();
-					if ( outputs ) cout<<"trashing in FireFront::merge : "<<curfn->toString()<<endl;
+					FF_DEBUG(front, "trashing in FireFront::merge : "<<curfn->toString());
 					domain->addToTrashNodes(curfn);
 					curfn = next;
 				}
 				if ( curfn != 0 ){
-					if ( outputs ) cout<<"trashing in FireFront::merge : "<<curfn->toString()<<endl;
+					FF_DEBUG(front, "trashing in FireFront::merge : "<<curfn->toString());
 					domain->addToTrashNodes(curfn);
 				}
 				domain->addToTrashFronts(this);
@@ -666,21 +670,21 @@ void FireFront::merge(FireNode* fna, FireNode* fnb){
 			return;
 		}
 		if ( fna->getNext() == fnb->getPrev() ){
-			if (outputs) cout<<getDomainID()
-					<<": merging quasi-successive nodes"<<endl;
-			if ( outputs ) cout<<"trashing in FireFront::merge : "<<fna->getNext()->toString()<<endl;
+			FF_DEBUG(front, getDomainID()
+					<<": merging quasi-successive nodes");
+			FF_DEBUG(front, "trashing in FireFront::merge : "<<fna->getNext()->toString());
 			domain->addToTrashNodes(fna->getNext());
 			if ( getNumFN() < 5 ){
 				FireNode* curfn = headNode;
 				FireNode* next;
 				for ( int numfn = getNumFN()-1; numfn > 0; numfn-- ){
 					next = curfn->getNext();
-					if ( outputs ) cout<<"trashing in FireFront::merge : "<<curfn->toString()<<endl;
+					FF_DEBUG(front, "trashing in FireFront::merge : "<<curfn->toString());
 					domain->addToTrashNodes(curfn);
 					curfn = next;
 				}
 				if ( curfn != 0 ){
-					if ( outputs ) cout<<"trashing in FireFront::merge : "<<curfn->toString()<<endl;
+					FF_DEBUG(front, "trashing in FireFront::merge : "<<curfn->toString());
 					domain->addToTrashNodes(curfn);
 				}
 				domain->addToTrashFronts(this);
@@ -699,8 +703,8 @@ void FireFront::merge(FireNode* fna, FireNode* fnb){
 		/* Otherwise that means that i am merging with myself,
 		 * with an inner front.I start by imagine that the
 		 * node i'm merging with is in the outer, original front */
-		if (outputs) cout<<getDomainID()
-				<<": creating an inner front at "<<fna->getTime()<<endl;
+		FF_DEBUG(front, getDomainID()
+				<<": creating an inner front at "<<fna->getTime());
 		FireNode* pa = fna->getPrev();
 		FireNode* b = fnb;
 		FireNode* nb = fnb->getNext();
@@ -715,15 +719,13 @@ void FireFront::merge(FireNode* fna, FireNode* fnb){
 		setHead(fnb);
 
 		/* everyone is linked I can trash me now */
-		if ( outputs ) cout<<"trashing in FireFront::merge : "<<fna->toString()<<endl;
+		FF_DEBUG(front, "trashing in FireFront::merge : "<<fna->toString());
 		domain->addToTrashNodes(fna);
 		fnb->setState(FireNode::moving);
                 /* /!\ Debug  part /!\ */
-                if ( outputs ){
-                  cout<<"Debug part : "<<fnb->toString()<<endl;
-                  cout<<"Previous : "<<fnb->getPrev()->toString()<<endl;
-                  cout<<"Next : "<<fnb->getNext()->toString()<<endl;
-                }
+                FF_DEBUG(front, "Debug part : "<<fnb->toString()<<endl
+                  <<"Previous : "<<fnb->getPrev()->toString()<<endl
+                  <<"Next : "<<fnb->getNext()->toString());
                 /* /!\ /!\ /!\ /!\ /!\ */
 
 		/* bad luck, the other node was inside.
@@ -731,8 +733,8 @@ void FireFront::merge(FireNode* fna, FireNode* fnb){
 		double areaA = getLocalArea(fnb);
 		double areaB = getLocalArea(nb);
 		if( abs(areaA) < abs(areaB) ){
-			if (outputs) cout<<getDomainID()
-					<<": inverting the inner and outer fronts"<<endl;
+			FF_DEBUG(front, getDomainID()
+					<<": inverting the inner and outer fronts");
 			fnC = b;
 			b = pa;
 			pa = fnC;
@@ -742,19 +744,19 @@ void FireFront::merge(FireNode* fna, FireNode* fnb){
 		/* If I have not enough nodes left I need to trash them */
 		
 		if ( getNumFN() < 5 ){
-			cout<<getDomainID()
+			FF_DEBUG(front, getDomainID()
 					<<": trashing "<<toString()<<" because of lack of nodes ("
-					<<getNumFN()<<" nodes in the front)"<<endl;
+					<<getNumFN()<<" nodes in the front)");
 			FireNode* curfn = headNode;
 			FireNode* next;
 			for ( int numfn = getNumFN()-1; numfn > 0; numfn-- ){
 				next = curfn->getNext();
-				if ( outputs ) cout<<"trashing in FireFront::merge : "<<curfn->toString()<<endl;
+				FF_DEBUG(front, "trashing in FireFront::merge : "<<curfn->toString());
 				domain->addToTrashNodes(curfn);
 				curfn = next;
 			}
 			if ( curfn != 0 ){
-				if ( outputs ) cout<<"trashing in FireFront::merge : "<<curfn->toString()<<endl;
+				FF_DEBUG(front, "trashing in FireFront::merge : "<<curfn->toString());
 				domain->addToTrashNodes(curfn);
 			}
 			domain->addToTrashFronts(this);
@@ -765,8 +767,8 @@ void FireFront::merge(FireNode* fna, FireNode* fnb){
 		}
 
 		/* Otherwise I need to dispatch the nodes in a new inner front */
-		if ( outputs ) cout<<getDomainID()
-				<<": creating a new inner front"<<endl;
+		FF_DEBUG(front, getDomainID()
+				<<": creating a new inner front");
                 FireFront* tmpFront = domain->addFireFront(mergeTime,this);
 		fnC = pa;
 		tmpFront->setHead(fnC);
@@ -776,19 +778,19 @@ void FireFront::merge(FireNode* fna, FireNode* fnb){
 		}
 		/* If I have not enough nodes in the inner front I need to trash it */
 		if ( tmpFront->getNumFN() < max_inner_front_nodes_filter ){
-			if (outputs) cout<<getDomainID()
+			FF_DEBUG(front, getDomainID()
 					<<": trashing inner front "<<tmpFront->toString()<<" because of lack of nodes ("
-					<<tmpFront->getNumFN()<<" nodes in the front)"<<endl;
+					<<tmpFront->getNumFN()<<" nodes in the front)");
 			FireNode* curfn = tmpFront->getHead();
 			FireNode* next;
 			for ( int numfn = tmpFront->getNumFN()-1; numfn > 0; numfn-- ){
 				next = curfn->getNext();
-				if ( outputs ) cout<<"trashing in FireFront::merge : "<<curfn->toString()<<endl;
+				FF_DEBUG(front, "trashing in FireFront::merge : "<<curfn->toString());
 				domain->addToTrashNodes(curfn);
 				curfn = next;
 			}
 			if ( curfn != 0 ){
-				if ( outputs ) cout<<"trashing in FireFront::merge : "<<curfn->toString()<<endl;
+				FF_DEBUG(front, "trashing in FireFront::merge : "<<curfn->toString());
 				domain->addToTrashNodes(curfn);
 			}
 			domain->addToTrashFronts(tmpFront);
@@ -798,8 +800,8 @@ void FireFront::merge(FireNode* fna, FireNode* fnb){
                 else{
                   // Firstly, we do the same as in Case 1. This will split
                   // the polygon in 2 parts.
-                  if (outputs) cout<<getDomainID()
-                                   <<": creating an inner front at "<<fna->getTime()<<endl;
+                  FF_DEBUG(front, getDomainID()
+                                   <<": creating an inner front at "<<fna->getTime());
                   FireNode* pa = fna->getPrev();
                   FireNode* b = fnb;
                   FireNode* nb = fnb->getNext();
@@ -814,7 +816,7 @@ void FireFront::merge(FireNode* fna, FireNode* fnb){
                   setHead(fnb);
 
                   /* everyone is linked I can trash me now */
-                  if ( outputs ) cout<<"trashing in FireFront::merge : "<<fna->toString()<<endl;
+                  FF_DEBUG(front, "trashing in FireFront::merge : "<<fna->toString());
                   domain->addToTrashNodes(fna);
                   fnb->setState(FireNode::moving);
 
@@ -823,16 +825,16 @@ void FireFront::merge(FireNode* fna, FireNode* fnb){
                   double areaA = getLocalArea(fnb);
                   double areaB = getLocalArea(nb);
                   if( abs(areaA) < abs(areaB) ){
-                    if (outputs) cout<<getDomainID()
-                                     <<": inverting the inner and outer fronts"<<endl;
+                    FF_DEBUG(front, getDomainID()
+                                     <<": inverting the inner and outer fronts");
                     fnC = b;
                     b = pa;
                     pa = fnC;
                     setHead(b);
                   }
                   // One of the 2 parts will belong to another FireFront
-                  if ( outputs ) cout<<getDomainID()
-                                     <<": creating a new inner front"<<endl;
+                  FF_DEBUG(front, getDomainID()
+                                     <<": creating a new inner front");
                   FireFront* tmpFront = domain->addFireFront(mergeTime,this);
                   fnC = pa;
                   tmpFront->setHead(fnC);
@@ -843,19 +845,19 @@ void FireFront::merge(FireNode* fna, FireNode* fnb){
 
                   // Same for the second part
                   if ( tmpFront->getNumFN() < 5 ){
-                    if (outputs) cout<<getDomainID()
+                    FF_DEBUG(front, getDomainID()
                                      <<": trashing inner front "<<tmpFront->toString()<<" because of lack of nodes ("
-                                     <<tmpFront->getNumFN()<<" nodes in the front)"<<endl;
+                                     <<tmpFront->getNumFN()<<" nodes in the front)");
                     FireNode* curfn = tmpFront->getHead();
                     FireNode* next;
                     for ( int numfn = tmpFront->getNumFN()-1; numfn > 0; numfn-- ){
                       next = curfn->getNext();
-                      if ( outputs ) cout<<"trashing in FireFront::merge : "<<curfn->toString()<<endl;
+                      FF_DEBUG(front, "trashing in FireFront::merge : "<<curfn->toString());
                       domain->addToTrashNodes(curfn);
                       curfn = next;
                     }
                     if ( curfn != 0 ){
-                      if ( outputs ) cout<<"trashing in FireFront::merge : "<<curfn->toString()<<endl;
+                      FF_DEBUG(front, "trashing in FireFront::merge : "<<curfn->toString());
                       domain->addToTrashNodes(curfn);
                     }
                     domain->addToTrashFronts(tmpFront);
@@ -878,11 +880,11 @@ void FireFront::mergeInnerFronts(FireNode* fna, FireNode* fnb){
 		/* merging two inner firefronts, this should create
 		 * a new firefront with all the firenodes */
 		// affecting all the firenodes of front b to front a
-		if (outputs) cout<<domain->getDomainID()<<": "<<"merging firenode "
+		FF_DEBUG(front, domain->getDomainID()<<": "<<"merging firenode "
 				<<fna->toShort()<<" from front "<<fna->getFront()
 				<<" ("<<fna->getFront()->getNumFN()<<" firenodes)"<<endl<<"with firenode "
 				<<fnb->toShort()<<" with front "<<fnb->getFront()
-				<<" ("<<fnb->getFront()->getNumFN()<< " firenodes)"<< endl;
+				<<" ("<<fnb->getFront()->getNumFN()<< " firenodes)");
 
 		// Computing the region to be scanned if needed
 		double minX = min(fna->getX(),fnb->getX()) - 2.*domain->getPerimeterResolution();
@@ -912,14 +914,14 @@ void FireFront::mergeInnerFronts(FireNode* fna, FireNode* fnb){
 		tmpFront->extend();
 		// adding the merging firenodes to the trash nodes
 		fna->setFront(0);
-		if (outputs) cout<<domain->getDomainID()
-				<<": FireFront::mergeInnerFronts -> ";
-		if ( outputs ) cout<<"trashing in FireFront::mergeInnerFronts : "<<fna->toString()<<endl;
+		FF_DEBUG(front, domain->getDomainID()
+				<<": FireFront::mergeInnerFronts -> "
+				<<"trashing in FireFront::mergeInnerFronts : "<<fna->toString());
 		domain->addToTrashNodes(fna);
 		fnb->setFront(0);
-		if (outputs) cout<<domain->getDomainID()
-				<<": FireFront::mergeInnerFronts -> ";
-		if ( outputs ) cout<<"trashing in FireFront::mergeInnerFronts : "<<fnb->toString()<<endl;
+		FF_DEBUG(front, domain->getDomainID()
+				<<": FireFront::mergeInnerFronts -> "
+				<<"trashing in FireFront::mergeInnerFronts : "<<fnb->toString());
 		domain->addToTrashNodes(fnb);
 
 		// Scanning the region for burning status
@@ -957,7 +959,9 @@ double FireFront::getArea(){
 bool FireFront::checkForBurningStatus(FFPoint& loc){
 	bool burning = false;
 	if ( this != domain->getDomainFront() ){
-		if ( loc.pointInPolygon(nvert, vertx, verty) ) burning = not burning;
+		if ( vertIndex != 0 ){
+			if ( vertIndex->contains(loc.getX(), loc.getY()) ) burning = not burning;
+		} else if ( loc.pointInPolygon(nvert, vertx, verty) ) burning = not burning;
 	}
 	for ( innerFront = innerFronts.begin();
 			innerFront != innerFronts.end(); ++innerFront ){
@@ -966,6 +970,27 @@ bool FireFront::checkForBurningStatus(FFPoint& loc){
 	return burning;
 }
 
+void FireFront::checkForBurningStatus(const size_t& n, const double* xs, const double* ys, char* burning){
+	if ( this == domain->getDomainFront() ){
+		for ( size_t p = 0; p < n; p++ ) burning[p] = 0;
+	} else if ( vertIndex == 0 ){
+		for ( size_t p = 0; p < n; p++ ){
+			FFPoint loc(xs[p], ys[p], 0.);
+			burning[p] = loc.pointInPolygon(nvert, vertx, verty) ? 1 : 0;
+		}
+	} else {
+		vertIndex->contains(n, xs, ys, burning);
+	}
+	if ( innerFronts.empty() ) return;
+	/* each inner front containing a location switches its status */
+	vector<char> inner(n);
+	for ( innerFront = innerFronts.begin();
+			innerFront != innerFronts.end(); ++innerFront ){
+		(*innerFront)->checkForBurningStatus(n, xs, ys, &inner[0]);
+		for ( size_t p = 0; p < n; p++ ) burning[p] ^= inner[p];
+	}
+}
+
 // Visitor function
 void FireFront::accept(Visitor* v) {
 	if ( this != domain->getDomainFront() ) v->increaseLevel();
@@ -973,31 +998,31 @@ void FireFront::accept(Visitor* v) {
 		v->visit(this);
 		FireNode* fntmp = headNode;
 		if ( fntmp == 0 ) {
-			cout<<getDomainID()
+			FF_WARNING(front, getDomainID()
 					<<": PROBLEM in FireFront::accept, no headnode found for front"
-					<<toString()<<endl;
+					<<toString());
 			return;
 		}
 		fntmp->accept(v);
 		for ( size_t fncount = getNumFN()-1; fncount > 0; fncount-- ){
 			if ( fntmp->getFront() != this ){
-				cout<<getDomainID()
-						<<": PROBLEM with the front of a node in FireFront::accept"<<endl;
-				cout<<getDomainID()<<": "<<fntmp->toString()
+				FF_WARNING(front, getDomainID()
+						<<": PROBLEM with the front of a node in FireFront::accept"<<endl
+						<<getDomainID()<<": "<<fntmp->toString()
 						<<" has front "<<fntmp->getFront()->toString()<<fntmp->getFront()
-						<<" instead of "<<this->toString()<<endl;
+						<<" instead of "<<this->toString());
 				fntmp->setFront(this);
 			}
 			if (fntmp->getNext() == fntmp){
-				cout<<getDomainID()<<": PROBLEM with the next of node "
-						<<fntmp->toString()<<" which is itself"<<endl;
+				FF_WARNING(front, getDomainID()<<": PROBLEM with the next of node "
+						<<fntmp->toString()<<" which is itself");
 			}
 			fntmp = fntmp->getNext();
 			if ( fntmp == 0 ){
-				cout<<getDomainID()
+				FF_WARNING(front, getDomainID()
 						<<": PROBLEM in FireFront::accept"
 						<<", Incomplete front with no next for a firenode in front"
-						<<toString()<<endl;
+						<<toString());
 				return;
 			}
 			fntmp->accept(v);
@@ -1058,7 +1083,7 @@ void FireFront::computeBoundingBox(FFPoint& swc, FFPoint& nec){
 			fn = fn->getNext();
 		}
 	} catch (...) {
-		cout<<"PROBLEM in FireFront::computeBoundingBox"<<endl;
+		FF_WARNING(front, "PROBLEM in FireFront::computeBoundingBox");
 	}
 }
 
@@ -1068,6 +1093,10 @@ void FireFront::constructVerticesVectors(){
 		vertx = new double[nvert];
 		verty = new double[nvert];
 		storeVertices(vertx, verty, nvert);
+		if ( indexVertices ){
+			if ( vertIndex == 0 ) vertIndex = new PolygonIndex();
+			vertIndex->build(nvert, vertx, verty);
+		}
 	}
 	for ( innerFront = innerFronts.begin();
 			innerFront != innerFronts.end(); ++innerFront ){
@@ -1088,6 +1117,10 @@ void FireFront::deleteVerticesVectors(){
 	if ( this != domain->getDomainFront() ){
 		if ( vertx != 0 ) delete [] vertx;
 		if ( verty != 0 ) delete [] verty;
+		vertx = 0;
+		verty = 0;
+		nvert = 0;
+		if ( vertIndex != 0 ) vertIndex->build(0, 0, 0);
 	}
 	for ( innerFront = innerFronts.begin();
 			innerFront != innerFronts.end(); ++innerFront ){
@@ -1097,7 +1130,7 @@ void FireFront::deleteVerticesVectors(){
 
 void FireFront::makeTrash(){
 	if ( innerFronts.size() != 0 )
-		cout<<"WARNING: trashing a fire front with inner fronts"<<endl;
+		FF_WARNING(front, "trashing a fire front with inner fronts");
 	headNode = 0;
 	numFirenodes = 0;
 	if ( containingFront != 0 ){
@@ -13,6 +13,7 @@
 #include "Visitable.h"
 #include "FireNode.h"
 #include "ParallelException.h"
+#include "PolygonIndex.h"
 #include "include/FFConstants.h"
 #include "include/Futils.h"
 
@@ -43,9 +44,13 @@ class FireFront: public ForeFireAtom, Visitable {
 	list<FireFront*> innerFronts; /*!< inner fire fronts */
 	list<FireFront*>::iterator innerFront;
 
+	friend class Checkpoint;
+
 	/*!  \brief local variables for vertices storage */
 	size_t nvert;
 	double *vertx, *verty;
+	PolygonIndex* vertIndex; /*!< index of the stored vertices for containment queries */
+	bool indexVertices; /*!< indexing the stored vertices, or walking them in queries */
 
 	/*!  \brief local variables in case of spline interpolation */
 	size_t nspl;
@@ -165,6 +170,9 @@ public:
 
 	/*! \brief checking the burning status of a given location */
 	bool checkForBurningStatus(FFPoint&);
+	/*! \brief checking the burning status of a batch of locations,
+	 * stored as 0 or 1 (vertices vectors have to be constructed) */
+	void checkForBurningStatus(const size_t&, const double*, const double*, char*);
 
 	/*! \brief computes a rectangle containing the entire front */
 	void computeBoundingBox(FFPoint&, FFPoint&);
@@ -89,4 +89,13 @@ double FireFrontData::getTime(){
 	return time;
 }
 
+size_t FireFrontData::getMemorySize(){
+	size_t bytes = sizeof(FireFrontData) + nodes.size()*(sizeof(FireNodeData) + sizeof(FireNodeData*));
+	list<FireFrontData*>::iterator front;
+	for ( front = innerFronts.begin(); front != innerFronts.end(); ++front ){
+		bytes += (*front)->getMemorySize();
+	}
+	return bytes;
+}
+
 }
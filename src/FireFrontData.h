@@ -44,6 +44,9 @@ public:
 
 	void reconstructState(FireFront*);
 
+	/*! \brief memory held by the backup of the front and its inner fronts (bytes) */
+	size_t getMemorySize();
+
 };
 
 }
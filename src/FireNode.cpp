@@ -8,6 +8,7 @@
 
 #include "FireNode.h"
 #include "Visitor.h"
+#include "Logger.h"
 #include <math.h>
 
 namespace libforefire{
@@ -166,14 +167,11 @@ void FireNode::timeAdvance(){
 			if( assertCompatibleTopology() ){
 				computeLocalFrontProperties();
 			} else {
-				if ( outputs ){
-					cout<<domain->getDomainID()
-							<<": PROBLEM, bad configuration for normal computing with:"<<endl;
-					getPrev() != 0 ? cout<<'\t'<<getPrev()->toShort() : cout<<'\t'<<getPrev();
-					cout<<"->"<<toShort()<<"->";
-					getNext() != 0 ? cout<<'\t'<<getNext()->toShort() : cout<<'\t'<<getNext();
-					cout<<endl;
-				}
+				FF_DEBUG(node, domain->getDomainID()
+						<<": PROBLEM, bad configuration for normal computing with:"<<endl
+						<<'\t'<<( getPrev() != 0 ? getPrev()->toShort() : "0" )
+						<<"->"<<toShort()<<"->"
+						<<'\t'<<( getNext() != 0 ? getNext()->toShort() : "0" ));
 			}
 			if ( fdepth ) {
 				double newFrontDepth = domain->computeFrontDepth(this);
@@ -221,9 +219,9 @@ void FireNode::timeAdvance(){
 	/*	if ( domain->isInOuterHalo(nextloc)
 				and !domain->isInActiveOuterHalo(nextloc) ){
 			setNextLoc(location);
-			if (outputs) cout<<domain->getDomainID()
+			FF_DEBUG(node, domain->getDomainID()
 					<<": stopping "<<toShort()
-					<<" at limit of a non-active outer halo"<<endl;
+					<<" at limit of a non-active outer halo");
 			setState(final);
 		}*/
 
@@ -234,7 +232,7 @@ void FireNode::timeAdvance(){
 	}
 
 	if ( currentState == link ){
-		cout<<"WARNING: A link node has been advanced in time !! Its address is "<<this<<endl;
+		FF_WARNING(node, "A link node has been advanced in time !! Its address is "<<this);
 		setUpdateTime(numeric_limits<double>::infinity());
 	}
 
@@ -275,7 +273,7 @@ size_t FireNode::getPosInFront(){
 string FireNode::getStateString(FireNode::State state){
 	isttostr = sttostr.find(state);
 	if ( isttostr == sttostr.end() ) {
-		cout << "unknown state." << endl;
+		FF_WARNING(node, "unknown state.");
 		return "unknown state";
 	} else {
 		return isttostr->second;
@@ -68,6 +68,8 @@ class FireNode : public ForeFireAtom, Visitable {
 	static double minSpeed; /*!< minimum speed allowed */
 	static double minFrontDepth;
 
+	friend class Checkpoint;
+
 public:
 
 	static bool outputs; /*! boolean for outputs */
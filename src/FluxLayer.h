@@ -65,6 +65,7 @@ template<typename T> class FluxLayer : public DataLayer<T> {
 
 	double latestCallGetMatrix; /*!< time of the latest call to getMatrix() */
 	double latestCallInstantaneousFlux; /*!< time of the latest call to getInstantaneousFlux() */
+	size_t numComputations; /*!< number of flux computations, sampling the binning error */
 
 
 	SimulationParameters* params;
@@ -74,6 +75,9 @@ template<typename T> class FluxLayer : public DataLayer<T> {
 
 	T getNearestData(FFPoint, double);
 
+	/*! \brief where to estimate the binning error of a computation, if it is sampled */
+	double* binningErrorEstimate(double&);
+
 public:
 	/*! \brief Default constructor */
 	FluxLayer() : DataLayer<T>() {};
@@ -107,6 +111,7 @@ public:
 
 		latestCallGetMatrix = -1.;
 		latestCallInstantaneousFlux = -1.;
+		numComputations = 0;
 
 		params = SimulationParameters::GetInstance();
 	}
@@ -142,6 +147,7 @@ public:
 
 		latestCallGetMatrix = -1.;
 		latestCallInstantaneousFlux = -1.;
+		numComputations = 0;
 
 		params = SimulationParameters::GetInstance();
 	};
@@ -166,6 +172,8 @@ public:
 	void setFirstCall(const double&);
 	/*! \brief getter to the pointer on the FFArray */
 	void getMatrix(FFArray<T>**, const double&);
+	/*! \brief memory held by the layer (bytes) */
+	size_t getMemorySize(){ return this->arrayMemory(flux); }
 	/*! \brief stores data from a fortran array into the FFArray */
 	void setMatrix(string&, double*, const size_t&, size_t&, const double&);
 
@@ -307,6 +315,9 @@ void FluxLayer<T>::getMatrix(FFArray<T>** matrix, const double& t){
 
 	   	for (int i = 0; i < numFluxModelsMax; i++) modelCount[i]= 0;
 	   	int totalcount = 0;
+	   	/* the binning error is only estimated with binning, on the final pass */
+	   	double binningError = 0.;
+	   	double* errorEstimate = binningErrorEstimate(binningError);
  
 
 	   	for ( size_t i = 0; i < nx; i++ ){
@@ -325,12 +336,15 @@ void FluxLayer<T>::getMatrix(FFArray<T>** matrix, const double& t){
 
 	   	for ( size_t i = 0; i < nx; i++ ){
 			for ( size_t j = 0; j < ny; j++ ){
-				(*flux)(i,j) = cells[i][j].applyModelsOnBmap(fluxName, latestCallGetMatrix, t, modelCount);
+				(*flux)(i,j) = cells[i][j].applyModelsOnBmap(fluxName, latestCallGetMatrix, t, modelCount, errorEstimate);
 			}
 		}
 
 	    params->setDouble(fluxName+".activeArea",totalcount*cells[0][0].getBmapElementArea());
-		latestCallGetMatrix = t;
+	    if ( errorEstimate != 0 ){
+	    	params->setDouble(fluxName+".binningError", binningError);
+	    }
+	    latestCallGetMatrix = t;
 
 	}
 	// Affecting the computed matrix to the desired array
@@ -344,6 +358,15 @@ void FluxLayer<T>::getMatrix(FFArray<T>** matrix, const double& t){
 	}
 }
 
+template<typename T>
+double* FluxLayer<T>::binningErrorEstimate(double& error){
+	/* estimating the error costs two model evaluations per bin,
+	 * it is only done every 'fluxBinningErrorCheck' computations */
+	int period = params->getInt("fluxBinningErrorCheck");
+	if ( !(params->getDouble("fluxBinningTolerance") > 0.) or period <= 0 ) return 0;
+	return ( numComputations++ % period == 0 ) ? &error : 0;
+}
+
 template<typename T>
 void FluxLayer<T>::getInstantaneousFlux(FFArray<T>** matrix, const double& t){
 	string fluxName = this->getKey();
@@ -351,13 +374,16 @@ void FluxLayer<T>::getInstantaneousFlux(FFArray<T>** matrix, const double& t){
 	int modelCount[numFluxModelsMax];
    	int totalcount = 0;
    	for (int i = 0; i < numFluxModelsMax; i++) modelCount[i]= 0;
+   	double binningError = 0.;
+   	double* errorEstimate = 0;
 
 	if ( t != latestCallInstantaneousFlux ){
+		errorEstimate = binningErrorEstimate(binningError);
 		// computing the instantaneous flux
 		string fluxName = this->getKey();
 		for ( size_t i = 0; i < nx; i++ ){
 			for ( size_t j = 0; j < ny; j++ ){
-				(*flux)(i,j) = cells[i][j].applyModelsOnBmap(fluxName, t, t, modelCount);
+				(*flux)(i,j) = cells[i][j].applyModelsOnBmap(fluxName, t, t, modelCount, errorEstimate);
 			}
 		}
 
@@ -369,6 +395,9 @@ void FluxLayer<T>::getInstantaneousFlux(FFArray<T>** matrix, const double& t){
 			    	}
 			    }
 			    params->setDouble(fluxName+".activeArea",totalcount*cells[0][0].getBmapElementArea());
+			    if ( errorEstimate != 0 ){
+			    	params->setDouble(fluxName+".binningError", binningError);
+			    }
 
 		latestCallInstantaneousFlux = t;
 	}
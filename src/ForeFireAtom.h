@@ -105,6 +105,10 @@ public:
 	void getNewID(const long& domainId){
 		numID = getIDfromLongs(domainId,instanceNRCount++);
 	}
+	/*! \brief short ID the next new atom will get */
+	static long getNextShortID(){ return instanceNRCount; }
+	/*! \brief setting the short ID of the next new atoms (e.g. after restoring atoms) */
+	static void setNextShortID(const long& sid){ instanceNRCount = sid; }
 
 	/*! \brief Pure virtual function for inpus */
 	virtual void input() = 0;
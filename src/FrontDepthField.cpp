@@ -0,0 +1,150 @@
+/**
+ * @file FrontDepthField.cpp
+ * @brief Implements the residence time field used for front depth computations
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#include "FrontDepthField.h"
+#include "FireDomain.h"
+#include <cmath>
+
+namespace libforefire {
+
+const double FrontDepthField::timeTolerance = 0.1;
+const double FrontDepthField::maxResidenceTime = 1.e7;
+
+FrontDepthField::FrontDepthField(FireDomain* fd) : domain(fd)
+	, numSearches(0), numLookups(0) {
+	tiles.resize(domain->atmoNX*domain->atmoNY);
+}
+
+FrontDepthField::~FrontDepthField() {
+}
+
+void FrontDepthField::clear(){
+	/* swapping with empty vectors to give the memory back */
+	for ( size_t t = 0; t < tiles.size(); t++ ){
+		vector<double>().swap(tiles[t].arrival);
+		vector<double>().swap(tiles[t].extinction);
+	}
+}
+
+size_t FrontDepthField::getMemorySize(){
+	size_t bytes = tiles.capacity()*sizeof(Tile);
+	for ( size_t t = 0; t < tiles.size(); t++ ){
+		bytes += (tiles[t].arrival.capacity() + tiles[t].extinction.capacity())*sizeof(double);
+	}
+	return bytes;
+}
+
+bool FrontDepthField::fluxAboveTreshold(FFPoint& loc, const double& t, const double& at){
+	int mind = domain->dataBroker->heatFluxLayer->getFunctionIndexAt(loc, t);
+	return domain->getModelValueAt(mind, loc, t, t, at) > domain->burningTresholdFlux;
+}
+
+double FrontDepthField::searchExtinctionTime(const size_t& ii, const size_t& jj, const double& at){
+	numSearches++;
+	/* the flux is evaluated at the center of the point of the burning map */
+	FFPoint loc(domain->SWCornerX() + (ii + 0.5)*domain->burningMatrixResX
+			, domain->SWCornerY() + (jj + 0.5)*domain->burningMatrixResY, 0.);
+	if ( !fluxAboveTreshold(loc, at, at) ) return at;
+
+	/* bracketing the extinction time by doubling the residence time */
+	double lo = at;
+	double hi = at;
+	double dt = timeTolerance;
+	while ( dt < maxResidenceTime ){
+		hi = at + dt;
+		if ( !fluxAboveTreshold(loc, hi, at) ) break;
+		lo = hi;
+		dt *= 2.;
+	}
+	if ( dt >= maxResidenceTime ) return numeric_limits<double>::infinity();
+
+	/* finishing the search by dichotomy */
+	while ( hi - lo > timeTolerance ){
+		double mid = 0.5*(lo + hi);
+		if ( fluxAboveTreshold(loc, mid, at) ){
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+	return 0.5*(lo + hi);
+}
+
+double FrontDepthField::getExtinctionTime(const size_t& ii, const size_t& jj){
+	double at = domain->getArrivalTime(ii, jj);
+	if ( at == numeric_limits<double>::infinity() ) return at;
+	size_t lx = domain->localBMapSizeX;
+	size_t ly = domain->localBMapSizeY;
+	Tile& tile = tiles[(ii/lx)*domain->atmoNY + jj/ly];
+	if ( tile.arrival.empty() ){
+		tile.arrival.assign(lx*ly, numeric_limits<double>::quiet_NaN());
+		tile.extinction.assign(lx*ly, 0.);
+	}
+	size_t k = (jj%ly)*lx + ii%lx;
+	/* extinction times are kept as long as the arrival time does not change */
+	if ( tile.arrival[k] != at ){
+		tile.extinction[k] = searchExtinctionTime(ii, jj, at);
+		tile.arrival[k] = at;
+	}
+	return tile.extinction[k];
+}
+
+bool FrontDepthField::isBurning(FFPoint& loc, const double& t){
+	numLookups++;
+	if ( !domain->striclyWithinDomain(loc) ) return false;
+	size_t ii = (size_t) ((loc.getX()-domain->SWCornerX())/domain->burningMatrixResX);
+	size_t jj = (size_t) ((loc.getY()-domain->SWCornerY())/domain->burningMatrixResY);
+	if ( ii > domain->globalBMapSizeX-1 or jj > domain->globalBMapSizeY-1 ) return false;
+	if ( t < domain->getArrivalTime(ii, jj) ) return false;
+	return t < getExtinctionTime(ii, jj);
+}
+
+double FrontDepthField::getFrontDepth(FireNode* fn){
+	/* the burning map is walked by steps of half its resolution
+	 * along the inward normal, starting from the depth of the previous
+	 * step, the depth being located between the last burning step
+	 * and the first one that is not burning. The firenode itself
+	 * is considered as burning. */
+	double t = fn->getTime();
+	double maxDepth = domain->maxFrontDepth;
+	double step = 0.5*domain->burningMatrixRes;
+	FFPoint spatialInc = -step*(fn->getNormal().toPoint());
+	FFPoint origin = fn->getLoc();
+	size_t maxStep = (size_t) ceil(maxDepth/step);
+
+	size_t k = (size_t) floor(fn->getFrontDepth()/step);
+	if ( k < 1 ) k = 1;
+	if ( k > maxStep ) k = maxStep;
+	FFPoint loc = origin + ((double) k)*spatialInc;
+	if ( isBurning(loc, t) ){
+		/* deeper: the boundary is after k */
+		loc = loc + spatialInc;
+		while ( k < maxStep and isBurning(loc, t) ){
+			k++;
+			loc = loc + spatialInc;
+		}
+		if ( k >= maxStep ) return maxDepth;
+	} else {
+		/* shallower: the boundary is before k */
+		k--;
+		loc = loc - spatialInc;
+		while ( k > 0 and !isBurning(loc, t) ){
+			k--;
+			loc = loc - spatialInc;
+		}
+	}
+
+	/* the interface lies in the middle of the last step */
+	FFPoint C = origin + (k + 0.5)*spatialInc;
+	/* Getting the altitude into consideration */
+	double alt = domain->getDataLayer(FireDomain::altitude)->getValueAt(C, t);
+	C.setZ(alt);
+	return min(maxDepth, origin.distance(C));
+}
+
+}
@@ -0,0 +1,101 @@
+/**
+ * @file FrontDepthField.h
+ * @brief Cached extinction times of the burning map, answering front depth queries with a few lookups.
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#ifndef FRONTDEPTHFIELD_H_
+#define FRONTDEPTHFIELD_H_
+
+#include <vector>
+#include <cstddef>
+#include "FFPoint.h"
+
+using namespace std;
+
+namespace libforefire {
+
+class FireDomain;
+class FireNode;
+
+/*! \class FrontDepthField
+ * \brief Residence time field of the burning map
+ *
+ *  A point of the burning map is burning between its arrival time
+ *  and its extinction time, time at which the heat flux released
+ *  there falls below 'burningTresholdFlux'. The extinction time of
+ *  a point only depends on its arrival time and on the local flux
+ *  model, it is thus searched once, by dichotomy on the flux model,
+ *  when the point is first queried and kept until its arrival time
+ *  changes. Extinction times are stored by tiles matching the
+ *  FDCells, tiles being only allocated for the cells where front
+ *  depths are queried, i.e. along the active fronts.
+ *
+ *  Checking whether a point is burning then costs two lookups
+ *  (arrival and extinction times) instead of a flux model
+ *  evaluation, and the front depth of a firenode is found by
+ *  walking the burning map along its normal from the depth found
+ *  at the previous step, which usually takes two lookups.
+ *
+ *  The walk is made by steps of half the burning map resolution,
+ *  locating the interface defined by FireDomain::isBurning within
+ *  half a resolution for flux models whose instantaneous flux only
+ *  depends on the time elapsed since the arrival of the front
+ *  (e.g. heatFluxBasic, heatFluxNominal). The 'normalDir' scheme
+ *  marches by steps of a tenth of the previous depth before its
+ *  dichotomy, both schemes thus differing by up to one of these
+ *  steps. Flux models depending on time-varying data or burning
+ *  again after extinction are not represented.
+ */
+class FrontDepthField {
+
+	/*! \brief extinction times of the points of a cell */
+	struct Tile {
+		vector<double> arrival; /*!< arrival times the extinction times were computed for */
+		vector<double> extinction; /*!< extinction times */
+	};
+
+	FireDomain* domain; /*!< domain of the burning map */
+	vector<Tile> tiles; /*!< tiles of the cells, empty until queried */
+
+	size_t numSearches; /*!< number of extinction time searches */
+	size_t numLookups; /*!< number of burning checks */
+
+	/*! \brief tolerance on the extinction times (s) */
+	static const double timeTolerance;
+	/*! \brief residence time above which a point is considered to burn forever (s) */
+	static const double maxResidenceTime;
+
+	/*! \brief searching the extinction time of a point of the burning map */
+	double searchExtinctionTime(const size_t&, const size_t&, const double&);
+	/*! \brief checking whether the flux at a location is above the burning treshold */
+	bool fluxAboveTreshold(FFPoint&, const double&, const double&);
+
+public:
+
+	/*! \brief Constructor from the domain */
+	FrontDepthField(FireDomain*);
+	/*! \brief destructor */
+	~FrontDepthField();
+
+	/*! \brief extinction time of a point of the global burning map */
+	double getExtinctionTime(const size_t&, const size_t&);
+	/*! \brief checking whether a location is burning, from the cached field */
+	bool isBurning(FFPoint&, const double&);
+	/*! \brief front depth of a firenode along its normal */
+	double getFrontDepth(FireNode*);
+
+	/*! \brief forgetting all the extinction times (e.g. when the flux models change) */
+	void clear();
+	/*! \brief memory held by the allocated tiles (bytes) */
+	size_t getMemorySize();
+
+	size_t getNumSearches(){ return numSearches; }
+	size_t getNumLookups(){ return numLookups; }
+};
+
+}
+
+#endif /* FRONTDEPTHFIELD_H_ */
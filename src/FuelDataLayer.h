@@ -12,6 +12,7 @@
 #include "FFArrays.h"
 #include "PropagationModel.h"
 #include "FluxModel.h"
+#include "NCTileCache.h"
 
 using namespace std;
 
@@ -28,6 +29,7 @@ template<typename T> class FuelDataLayer : public DataLayer<T> {
 	/* Defining the map of fuels */
 	int* fuelMap;
 	FFArray<int>* myFuelMap; /*!< pointer to the FFArray containing the data */
+	NCTileCache<int>* tiles; /*!< lazily loaded map, 'fuelMap' then only being a copy for getFuelMap */
 
 	double SWCornerX; /*!< origin in the X direction */
 	double SWCornerY; /*!< origin in the Y direction */
@@ -61,11 +63,16 @@ template<typename T> class FuelDataLayer : public DataLayer<T> {
 
 	size_t getPos(FFPoint& loc, double& time);
 
+	/*! \brief copying the whole tiled map in 'fuelMap' */
+	void loadAllTiles();
+	/*! \brief fuel index at a given position in the (possibly tiled) map */
+	int fuelAtPos(size_t);
+
 public:
     
 	static const size_t MAXNUMFUELS = 1024;
 	/*! \brief Default constructor */
-	FuelDataLayer() : DataLayer<T>() {};
+	FuelDataLayer() : DataLayer<T>() { fuelMap = NULL; tiles = NULL; };
 	/*! \brief Constructor for a lone fuel */
 	FuelDataLayer(string name, int& findex) : DataLayer<T>(name) {
 		nx = 1;
@@ -75,6 +82,7 @@ public:
 		size = 1;
 		fuelMap = new int[size];
 		fuelMap[0] = findex;
+		tiles = NULL;
 	}
 	/*! \brief Constructor with a given file and given variable */
 	FuelDataLayer(string name, FFPoint& SWCorner, double& t0
@@ -92,6 +100,7 @@ public:
 		NECornerZ = SWCornerZ + extent.getZ();
 		endTime = startTime + timespan;
 		fuelMap = new int[size];
+		tiles = NULL;
 
 		for ( size_t i = 0; i<size; i++ ){
 			fuelMap[i] = fmap[i];
@@ -102,6 +111,30 @@ public:
 		dz = extent.getZ()/nz;
 		dt = timespan/nt;
 
+	}
+	/*! \brief Constructor with a map lazily read by tiles in a NetCDF file */
+	FuelDataLayer(string name, FFPoint& SWCorner, double& t0
+			, FFPoint& extent, double& timespan, size_t& nnx, size_t& nny
+			, size_t& nnz, size_t& nnt, NCTileCache<int>* lazyMap)
+		: DataLayer<T>(name), startTime(t0)
+		  , nx(nnx), ny(nny), nz(nnz), nt(nnt) {
+
+		size = (size_t) nx*ny*nz*nt;
+		SWCornerX = SWCorner.getX();
+		SWCornerY = SWCorner.getY();
+		SWCornerZ = SWCorner.getZ();
+		NECornerX = SWCornerX + extent.getX();
+		NECornerY = SWCornerY + extent.getY();
+		NECornerZ = SWCornerZ + extent.getZ();
+		endTime = startTime + timespan;
+		fuelMap = NULL;
+		tiles = lazyMap;
+
+		dx = extent.getX()/nx;
+		dy = extent.getY()/ny;
+		dz = extent.getZ()/nz;
+		dt = timespan/nt;
+
 	}
 	/*! \brief destructor */
 	~FuelDataLayer();
@@ -124,10 +157,21 @@ public:
 
 	/*! \brief getter to the desired data at surface for a given time (should not be used) */
 	void getMatrix(FFArray<T>**, const double&);
+	/*! \brief memory held by the layer (bytes) */
+	size_t getMemorySize(){ return (fuelMap ? size*sizeof(int) : 0) + (tiles ? tiles->residentBytes() : 0); }
+	/*! \brief evicting the resident tiles of lazily loaded data */
+	size_t releaseCache(){ return releaseMatrix() + (tiles ? tiles->evictAll() : 0); }
+	/*! \brief releasing the copy of the tiled map made by getFuelMap */
+	size_t releaseMatrix(){
+		if ( tiles == NULL or fuelMap == NULL ) return 0;
+		delete [] fuelMap;
+		fuelMap = NULL;
+		return size*sizeof(int);
+	}
 	/*! \brief stores data from a given array (should not be used) */
 	void setMatrix(string&, double*, const size_t&, size_t&, const double&);
 
-	int* getFuelMap(){return fuelMap;}
+	int* getFuelMap(){ loadAllTiles(); return fuelMap; }
 	size_t getDim(string = "total");
 	/*! \brief print the related data (should not be used) */
 	string print();
@@ -150,29 +194,44 @@ public:
 template<typename T>
 FuelDataLayer<T>::~FuelDataLayer() {
 	delete [] fuelMap;
+	delete tiles;
+}
+
+template<typename T>
+void FuelDataLayer<T>::loadAllTiles(){
+	if ( tiles == NULL or fuelMap != NULL ) return;
+	fuelMap = new int[size];
+	tiles->readAll(fuelMap);
 }
 
 template<typename T>
 int FuelDataLayer<T>::getFuel(size_t pos){
+	return fuelAtPos(pos);
+}
+
+template<typename T>
+int FuelDataLayer<T>::fuelAtPos(size_t pos){
+	if ( tiles ) return (*tiles)(pos/(ny*nz*nt), (pos/(nz*nt))%ny, (pos/nt)%nz, pos%nt);
 	return fuelMap[pos];
 }
 
 template<typename T>
 int FuelDataLayer<T>::getFuel(size_t i, size_t j, size_t k, size_t t){
+	if ( tiles ) return (*tiles)(i, j, k, t);
 	return fuelMap[i*ny*nz*nt + j*nz*nt + k*nt + t];
 }
 
 template<typename T>
 T FuelDataLayer<T>::getValueAt(FireNode* fn){
 	FFPoint loc = fn->getLoc();
-	T retval = (T) fuelMap[getPos(loc, fn->getTime())];
+	T retval = (T) fuelAtPos(getPos(loc, fn->getTime()));
    return retval;
 }
 
 template<typename T>
 T FuelDataLayer<T>::getValueAt(FFPoint loc, const double& time){
 	double mytime = time;
-	T retval = (T) fuelMap[getPos(loc, mytime)];
+	T retval = (T) fuelAtPos(getPos(loc, mytime));
    return retval;
 }
 
@@ -208,12 +267,18 @@ size_t FuelDataLayer<T>::getValuesAt(FFPoint loc, const double& t
 template<typename T>
 int FuelDataLayer<T>::getFuelAtLocation(FFPoint loc, double time){
 	if ( size == 1 ) return fuelMap[0];
-	return fuelMap[getPos(loc, time)];
+	return fuelAtPos(getPos(loc, time));
 }
 
 template<typename T>
 void FuelDataLayer<T>::setValueAt(FFPoint loc,  double timeV, T value){
-	fuelMap[getPos(loc, timeV)] = (int)value;
+	size_t pos = getPos(loc, timeV);
+	if ( tiles ){
+		/* kept by the cache over the eviction of the tile */
+		tiles->set((int) value, pos/(ny*nz*nt), (pos/(nz*nt))%ny, (pos/nt)%nz, pos%nt);
+		if ( fuelMap == NULL ) return;
+	}
+	fuelMap[pos] = (int)value;
 }
 template<typename T>
 size_t FuelDataLayer<T>::getDim(string dim){
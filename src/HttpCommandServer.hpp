@@ -1,6 +1,6 @@
 /**
  * @file HttpCommandServer.hpp
- * @brief TODO: add a brief description.
+ * @brief Embedded HTTP server answering ForeFire commands and serving the web interface.
  * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
  * @license This program is free software; See LICENSE file for details. (See LICENSE file).
  * @author Jean‑Baptiste Filippi — 2025
@@ -13,11 +13,23 @@
 #include <functional>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <deque>
+#include <vector>
+#include <map>
+#include <algorithm>
 #include <sstream>
+#include <fstream>
 #include <iostream>
 #include <cstring>
+#include <cerrno>
+#include <ctime>
 #include <sys/stat.h>
 #include <dirent.h>
+#include <poll.h>
+#include <fcntl.h>
 
 // POSIX headers for sockets
 #include <sys/socket.h>
@@ -27,18 +39,41 @@
 
 namespace http_command {
 
+    /*
+     * A pool of worker threads serves the requests of the connections,
+     * which are kept alive between requests (HTTP/1.1). A connection
+     * only holds a worker while one of its requests is read and
+     * answered: idle connections are watched by the accept thread and
+     * handed back to the workers when a new request arrives, or closed
+     * after some time without any. Commands are of two kinds:
+     * read-only queries are answered by the query callback (typically
+     * from a snapshot of the simulation) directly in the worker, all
+     * other commands are queued and executed one at a time by a single
+     * command thread, so that they never run concurrently.
+     */
     class HttpCommandServer {
     public:
         // The callback takes the command string (after the "ff:" prefix)
-        // and returns a complete HTTP response as a string.
+        // and returns the output of the command.
         using CommandCallback = std::function<std::string(const std::string&)>;
+        // The query callback returns true, and the answer, if the command
+        // is a read-only query it can answer without touching the simulation.
+        using QueryCallback = std::function<bool(const std::string&, std::string&)>;
 
-        HttpCommandServer() : server_fd(-1), running(false) {}
+        HttpCommandServer() : server_fd(-1), running(false), numWorkers(4) {
+            wake_fd[0] = -1;
+            wake_fd[1] = -1;
+        }
 
         ~HttpCommandServer() {
             stop();
         }
 
+        // Number of threads serving connections (to be set before listenOn).
+        void setWorkers(size_t n) {
+            numWorkers = (n > 0) ? n : 1;
+        }
+
         // Opens a listening socket on the given address (e.g. "localhost:8000").
         bool listenOn(const std::string &address) {
             size_t colon = address.find(':');
@@ -65,11 +100,21 @@ namespace http_command {
                 perror("bind");
                 return false;
             }
-            if (::listen(server_fd, 10) < 0) {
+            if (::listen(server_fd, 64) < 0) {
                 perror("listen");
                 return false;
             }
+            if (pipe(wake_fd) < 0) {
+                perror("pipe");
+                return false;
+            }
+            fcntl(wake_fd[0], F_SETFL, O_NONBLOCK);
+            fcntl(wake_fd[1], F_SETFL, O_NONBLOCK);
             running = true;
+            command_thread = std::thread(&HttpCommandServer::commandLoop, this);
+            for (size_t i = 0; i < numWorkers; i++) {
+                workers.push_back(std::thread(&HttpCommandServer::workerLoop, this));
+            }
             server_thread = std::thread(&HttpCommandServer::acceptLoop, this);
             std::cout 
                 << "\033[35m"   // start color
@@ -90,12 +135,40 @@ namespace http_command {
         void stop() {
             running = false;
             if (server_fd >= 0) {
+                shutdown(server_fd, SHUT_RDWR);
                 close(server_fd);
                 server_fd = -1;
             }
+            wakeAcceptLoop();
+            // taking the locks so that no thread misses the wake-up
+            { std::lock_guard<std::mutex> lock(clientsMutex); }
+            { std::lock_guard<std::mutex> lock(commandsMutex); }
+            clientsCond.notify_all();
+            commandsCond.notify_all();
             if (server_thread.joinable()) {
                 server_thread.join();
             }
+            for (size_t i = 0; i < workers.size(); i++) {
+                if (workers[i].joinable()) workers[i].join();
+            }
+            workers.clear();
+            if (command_thread.joinable()) {
+                command_thread.join();
+            }
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            while (!pendingClients.empty()) {
+                close(pendingClients.front().fd);
+                pendingClients.pop_front();
+            }
+            std::lock_guard<std::mutex> idleLock(idleMutex);
+            for (size_t i = 0; i < idleClients.size(); i++) {
+                close(idleClients[i].fd);
+            }
+            idleClients.clear();
+            for (int i = 0; i < 2; i++) {
+                if (wake_fd[i] >= 0) close(wake_fd[i]);
+                wake_fd[i] = -1;
+            }
         }
 
         // Set the callback function for processing ff: commands.
@@ -103,10 +176,75 @@ namespace http_command {
             callback = cb;
         }
 
+        // Set the callback function answering read-only ff: queries.
+        void setQueryCallback(QueryCallback cb) {
+            queryCallback = cb;
+        }
+
     private:
-        // Main loop: accept incoming connections.
+        static const int keepAliveTimeout = 5; // seconds of inactivity before closing
+        static const int readTimeout = 5; // seconds to wait for the rest of a started request
+        static const int maxRequestsPerConnection = 1000;
+        static const size_t maxRequestSize = 16 * 1024 * 1024;
+
+        // A connection, with the bytes received after its last request.
+        struct Connection {
+            int fd;
+            std::string pending;
+            int served;
+            std::time_t lastActive;
+        };
+
+        // A parsed HTTP request.
+        struct Request {
+            std::string method, uri, version, body;
+            bool keepAlive;
+        };
+
+        // Main loop: accept incoming connections, watch the idle ones and
+        // hand those with a new request to the workers.
         void acceptLoop() {
+            std::vector<pollfd> fds;
+            std::vector<Connection> watched;
             while (running) {
+                {
+                    std::lock_guard<std::mutex> lock(idleMutex);
+                    watched.insert(watched.end(), idleClients.begin(), idleClients.end());
+                    idleClients.clear();
+                }
+                fds.resize(2 + watched.size());
+                fds[0].fd = server_fd;
+                fds[1].fd = wake_fd[0];
+                for (size_t i = 0; i < watched.size(); i++) fds[2 + i].fd = watched[i].fd;
+                for (size_t i = 0; i < fds.size(); i++) {
+                    fds[i].events = POLLIN;
+                    fds[i].revents = 0;
+                }
+                if (poll(&fds[0], fds.size(), 1000) < 0) {
+                    if (errno != EINTR) perror("poll");
+                    continue;
+                }
+                if (!running) break;
+                if (fds[1].revents) {
+                    char buf[64];
+                    while (read(wake_fd[0], buf, sizeof(buf)) > 0) {}
+                }
+
+                // idle connections with a request (or closed by the client) go to the workers
+                std::time_t now = std::time(nullptr);
+                std::vector<Connection> still;
+                for (size_t i = 0; i < watched.size(); i++) {
+                    if (fds[2 + i].revents) {
+                        queueClient(watched[i]);
+                    } else if (now - watched[i].lastActive >= keepAliveTimeout) {
+                        close(watched[i].fd);
+                    } else {
+                        still.push_back(watched[i]);
+                    }
+                }
+                watched.swap(still);
+
+                if (!(fds[0].revents & POLLIN)) continue;
                 sockaddr_in client_addr;
                 socklen_t client_len = sizeof(client_addr);
                 int client_fd = accept(server_fd, reinterpret_cast<sockaddr*>(&client_addr), &client_len);
@@ -116,54 +254,194 @@ namespace http_command {
                     }
                     continue;
                 }
-                handleClient(client_fd);
-                close(client_fd);
+                timeval tv;
+                tv.tv_sec = readTimeout;
+                tv.tv_usec = 0;
+                setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+                Connection c;
+                c.fd = client_fd;
+                c.served = 0;
+                c.lastActive = now;
+                watched.push_back(c);
+            }
+            for (size_t i = 0; i < watched.size(); i++) close(watched[i].fd);
+        }
+
+        // Hands a connection with a request to the workers.
+        void queueClient(const Connection &c) {
+            {
+                std::lock_guard<std::mutex> lock(clientsMutex);
+                pendingClients.push_back(c);
+            }
+            clientsCond.notify_one();
+        }
+
+        // Gives an idle connection back to the accept loop.
+        void parkClient(Connection &c) {
+            c.lastActive = std::time(nullptr);
+            {
+                std::lock_guard<std::mutex> lock(idleMutex);
+                idleClients.push_back(c);
+            }
+            wakeAcceptLoop();
+        }
+
+        void wakeAcceptLoop() {
+            if (wake_fd[1] >= 0) {
+                char c = 0;
+                ssize_t ignored = write(wake_fd[1], &c, 1);
+                (void) ignored;
+            }
+        }
+
+        // Worker loop: serve the requests of the connections.
+        void workerLoop() {
+            while (true) {
+                Connection client;
+                {
+                    std::unique_lock<std::mutex> lock(clientsMutex);
+                    clientsCond.wait(lock, [this] { return !running || !pendingClients.empty(); });
+                    if (!running) return;
+                    client = pendingClients.front();
+                    pendingClients.pop_front();
+                }
+                serveConnection(client);
+            }
+        }
+
+        // Command loop: execute the queued commands one at a time.
+        void commandLoop() {
+            while (true) {
+                std::packaged_task<std::string()> task;
+                {
+                    std::unique_lock<std::mutex> lock(commandsMutex);
+                    commandsCond.wait(lock, [this] { return !running || !commands.empty(); });
+                    if (commands.empty()) return;
+                    task = std::move(commands.front());
+                    commands.pop_front();
+                }
+                task();
+            }
+        }
+
+        // Answers a query directly, or queues a command and waits for its output.
+        std::string runCommand(const std::string &fireCommand) {
+            std::string answer;
+            if (queryCallback && queryCallback(fireCommand, answer)) {
+                return answer;
+            }
+            CommandCallback cb = callback;
+            std::packaged_task<std::string()> task([cb, fireCommand] { return cb(fireCommand); });
+            std::future<std::string> result = task.get_future();
+            {
+                std::lock_guard<std::mutex> lock(commandsMutex);
+                if (!running) return "server stopping";
+                commands.push_back(std::move(task));
+            }
+            commandsCond.notify_one();
+            return result.get();
+        }
+
+        // Serves the requests of a connection that were received, the
+        // connection being then closed or handed back to the accept loop.
+        void serveConnection(Connection &c) {
+            while (running) {
+                Request req;
+                if (!readRequest(c.fd, c.pending, req))
+                    break;
+                std::string response = handleRequest(req);
+                c.served++;
+                if (!writeAll(c.fd, response) || !req.keepAlive || c.served >= maxRequestsPerConnection)
+                    break;
+                if (c.pending.find("\r\n\r\n") == std::string::npos) {
+                    parkClient(c);
+                    return;
+                }
             }
+            close(c.fd);
         }
 
-        // Handle a client connection by parsing the request.
-        void handleClient(int client_fd) {
+        // Reads one request (headers and body) from the connection.
+        bool readRequest(int client_fd, std::string &pending, Request &req) {
             const int buf_size = 4096;
             char buffer[buf_size];
-            int bytes_read = read(client_fd, buffer, buf_size - 1);
-            if (bytes_read <= 0)
-                return;
-            buffer[bytes_read] = '\0';
-            std::string request(buffer);
+            size_t headerEnd;
+            while ((headerEnd = pending.find("\r\n\r\n")) == std::string::npos) {
+                if (pending.size() > maxRequestSize) return false;
+                ssize_t bytes_read = read(client_fd, buffer, buf_size);
+                if (bytes_read <= 0) return false;
+                pending.append(buffer, bytes_read);
+            }
+            std::string header = pending.substr(0, headerEnd);
+            pending.erase(0, headerEnd + 4);
 
             // Parse the request line (e.g., "GET /uri HTTP/1.1" or "POST /uri HTTP/1.1").
-            std::istringstream requestStream(request);
-            std::string method, uri, version;
-            requestStream >> method >> uri >> version;
+            std::istringstream requestStream(header);
+            requestStream >> req.method >> req.uri >> req.version;
 
-            std::string complete_response;
-            // Handle POST requests: look for an ff: command in the body.
-            if (method == "POST") {
-                size_t pos = request.find("\r\n\r\n");
-                std::string body;
-                if (pos != std::string::npos) {
-                    body = request.substr(pos + 4);
+            size_t contentLength = 0;
+            std::string connection;
+            std::string line;
+            std::getline(requestStream, line);
+            while (std::getline(requestStream, line)) {
+                size_t colon = line.find(':');
+                if (colon == std::string::npos) continue;
+                std::string name = line.substr(0, colon);
+                std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+                std::string value = line.substr(colon + 1);
+                value.erase(0, value.find_first_not_of(" \t"));
+                if (!value.empty() && value[value.size() - 1] == '\r') value.erase(value.size() - 1);
+                if (name == "content-length") contentLength = std::strtoul(value.c_str(), nullptr, 10);
+                if (name == "connection") {
+                    connection = value;
+                    std::transform(connection.begin(), connection.end(), connection.begin(), ::tolower);
                 }
+            }
+            if (contentLength > maxRequestSize) return false;
+            while (pending.size() < contentLength) {
+                ssize_t bytes_read = read(client_fd, buffer, buf_size);
+                if (bytes_read <= 0) return false;
+                pending.append(buffer, bytes_read);
+            }
+            req.body = pending.substr(0, contentLength);
+            pending.erase(0, contentLength);
+
+            if (req.version == "HTTP/1.1")
+                req.keepAlive = (connection != "close");
+            else
+                req.keepAlive = (connection == "keep-alive");
+            return true;
+        }
+
+        // Writes the whole response on the connection.
+        bool writeAll(int client_fd, const std::string &data) {
+            size_t sent = 0;
+            while (sent < data.size()) {
+                ssize_t bytes_written = send(client_fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+                if (bytes_written <= 0) return false;
+                sent += bytes_written;
+            }
+            return true;
+        }
+
+        // Builds the response to a request.
+        std::string handleRequest(const Request &req) {
+            // Handle POST requests: look for an ff: command in the body.
+            if (req.method == "POST") {
+                const std::string &body = req.body;
                 if (body.size() > 3 && (body.substr(0, 3) == "ff:" || body.substr(0, 3) == "FF:")) {
-                    std::string fireCommand = body.substr(3);
-                    std::string result = callback(fireCommand);
-                    complete_response = buildResponse("200 OK", "text/plain; charset=UTF-8", result);
-                } else {
-                    complete_response = serveFileOrDirectory(uri);
+                    std::string result = runCommand(body.substr(3));
+                    return buildResponse("200 OK", "text/plain; charset=UTF-8", result, req.keepAlive);
                 }
+                return serveFileOrDirectory(req.uri, req.keepAlive);
             }
             // Handle GET requests.
-            else {
-                if (uri.size() > 4 && (uri.substr(0, 4) == "/ff:" || uri.substr(0, 4) == "/FF:")) {
-                    std::string fireCommand = uri.substr(4);
-                    std::string result = callback(fireCommand);
-                    complete_response = buildResponse("200 OK", "text/plain; charset=UTF-8", result);
-                } else {
-                    complete_response = serveFileOrDirectory(uri);
-                }
+            const std::string &uri = req.uri;
+            if (uri.size() > 4 && (uri.substr(0, 4) == "/ff:" || uri.substr(0, 4) == "/FF:")) {
+                std::string result = runCommand(uri.substr(4));
+                return buildResponse("200 OK", "text/plain; charset=UTF-8", result, req.keepAlive);
             }
-            ssize_t bytes_written = write(client_fd, complete_response.data(), complete_response.size());
-            (void)bytes_written;
+            return serveFileOrDirectory(uri, req.keepAlive);
         }
 
         // Check whether a file exists.
@@ -208,16 +486,18 @@ namespace http_command {
         // Build an HTTP response from status, content type, and body.
         std::string buildResponse(const std::string &status,
                                   const std::string &contentType,
-                                  const std::string &body) {
+                                  const std::string &body,
+                                  bool keepAlive = false) {
             std::ostringstream responseStream;
             std::time_t now = std::time(nullptr);
             char dateBuf[100];
-            std::tm *gmt = std::gmtime(&now);
-            std::strftime(dateBuf, sizeof(dateBuf), "%a, %d %b %Y %H:%M:%S GMT", gmt);
+            std::tm gmt;
+            gmtime_r(&now, &gmt);
+            std::strftime(dateBuf, sizeof(dateBuf), "%a, %d %b %Y %H:%M:%S GMT", &gmt);
 
-            responseStream << "HTTP/1.0 " << status << "\r\n"
+            responseStream << "HTTP/1.1 " << status << "\r\n"
                            << "Date: " << dateBuf << "\r\n"
-                           << "Connection: close\r\n"
+                           << "Connection: " << (keepAlive ? "keep-alive" : "close") << "\r\n"
                            << "Content-Type: " << contentType << "\r\n"
                            << "Content-Length: " << body.size() << "\r\n"
                            << "\r\n"
@@ -226,8 +506,9 @@ namespace http_command {
         }
 
         std::string buildSimpleResponse(const std::string &status,
-                                        const std::string &message) {
-            return buildResponse(status, "text/plain; charset=UTF-8", message);
+                                        const std::string &message,
+                                        bool keepAlive = false) {
+            return buildResponse(status, "text/plain; charset=UTF-8", message, keepAlive);
         }
 
         // Build a simple HTML directory listing.
@@ -261,7 +542,7 @@ namespace http_command {
         }
 
         // Serve a static file or a directory listing based on the request URI.
-        std::string serveFileOrDirectory(const std::string &uri) {
+        std::string serveFileOrDirectory(const std::string &uri, bool keepAlive = false) {
             std::string path = uri;
             size_t queryPos = path.find('?');
             if (queryPos != std::string::npos)
@@ -285,10 +566,10 @@ namespace http_command {
                 if (uri.empty() || uri.back() != '/') {
                     std::string location = "/" + path + "/";
                     return buildResponse("301 Moved Permanently", "text/plain; charset=UTF-8",
-                                           "Redirecting to " + location);
+                                           "Redirecting to " + location, keepAlive);
                 }
                 std::string body = buildDirectoryListing(path);
-                return buildResponse("200 OK", "text/html; charset=UTF-8", body);
+                return buildResponse("200 OK", "text/html; charset=UTF-8", body, keepAlive);
             } else {
                 if (!fileExists(path)) {
                     if (const char* ffHome = std::getenv("FOREFIREHOME")) {
@@ -304,22 +585,37 @@ namespace http_command {
                 if (fileExists(path)) {
                     std::ifstream file(path, std::ios::in | std::ios::binary);
                     if (!file) {
-                        return buildSimpleResponse("404 Not Found", "Unable to open file: " + path);
+                        return buildSimpleResponse("404 Not Found", "Unable to open file: " + path, keepAlive);
                     }
                     std::ostringstream contents;
                     contents << file.rdbuf();
                     std::string body = contents.str();
                     std::string contentType = determineContentType(path);
-                    return buildResponse("200 OK", contentType, body);
+                    return buildResponse("200 OK", contentType, body, keepAlive);
                 }
-                return buildSimpleResponse("404 Not Found", "No index.html found in run directory : " + path + " for default interface set environment variable FOREFIREHOME to forefire directory  ( export FOREFIREHOME=/path/to/forefire/ ) before launching ForeFire" );
+                return buildSimpleResponse("404 Not Found", "No index.html found in run directory : " + path + " for default interface set environment variable FOREFIREHOME to forefire directory  ( export FOREFIREHOME=/path/to/forefire/ ) before launching ForeFire", keepAlive);
                 }
             }
 
         int server_fd;
         std::atomic<bool> running;
+        size_t numWorkers;
         std::thread server_thread;
+        std::vector<std::thread> workers;
+        std::thread command_thread;
         CommandCallback callback;
+        QueryCallback queryCallback;
+
+        int wake_fd[2]; // pipe waking up the accept loop
+        std::mutex clientsMutex;
+        std::condition_variable clientsCond;
+        std::deque<Connection> pendingClients; // connections with a request
+        std::mutex idleMutex;
+        std::vector<Connection> idleClients; // connections given back by the workers
+
+        std::mutex commandsMutex;
+        std::condition_variable commandsCond;
+        std::deque<std::packaged_task<std::string()> > commands;
     };
 
 } // namespace http_command
@@ -0,0 +1,231 @@
+/**
+ * @file Logger.cpp
+ * @brief Implements the leveled diagnostics and their background sink
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#include "Logger.h"
+#include "SimulationParameters.h"
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
+
+namespace libforefire {
+
+int Logger::thresholds[Logger::numCategories] = {
+		Logger::info, Logger::info, Logger::info, Logger::info
+		, Logger::info, Logger::info, Logger::info, Logger::info };
+size_t Logger::rateLimit = 100;
+
+static const char* levelNames[] = { "error", "warning", "info", "debug", "trace" };
+static const char* categoryNames[] = { "general", "domain", "front", "node"
+		, "cell", "layer", "model", "coupling" };
+
+/* buffer of the messages and helper thread writing it; messages
+ * emitted after the sink is destroyed are written directly */
+static bool sinkAlive = false;
+/* in a forked child, messages are written without the buffer */
+static bool direct = false;
+static struct LogSink {
+	static const size_t maxPending = 1 << 20; /*!< size of the buffer (bytes) */
+	mutex lock; /*!< protecting the buffer */
+	mutex writing; /*!< keeping the chunks of the buffer in order */
+	condition_variable wake;
+	string pending; /*!< messages not written yet */
+	size_t dropped; /*!< messages dropped since the buffer was full */
+	thread flusher;
+	bool stopping;
+	ofstream file;
+
+	LogSink() : dropped(0), stopping(false) { sinkAlive = true; }
+	~LogSink(){
+		{
+			lock_guard<mutex> guard(lock);
+			stopping = true;
+		}
+		wake.notify_one();
+		if ( flusher.joinable() ) flusher.join();
+		drain();
+		sinkAlive = false;
+	}
+
+	ostream& out(){
+		return file.is_open() ? (ostream&) file : cout;
+	}
+
+	/* writing the buffer, the caller waiting for the stream */
+	void drain(){
+		lock_guard<mutex> order(writing);
+		string chunk;
+		{
+			lock_guard<mutex> guard(lock);
+			chunk.swap(pending);
+		}
+		if ( chunk.empty() ) return;
+		out().write(chunk.data(), chunk.size());
+		out().flush();
+	}
+
+	void run(){
+		unique_lock<mutex> guard(lock);
+		while ( true ){
+			wake.wait(guard, [this]{ return stopping or !pending.empty(); });
+			if ( pending.empty() and stopping ) return;
+			guard.unlock();
+			drain();
+			guard.lock();
+		}
+	}
+
+	/* errors are always kept, other messages being dropped when the
+	 * buffer is full */
+	void append(const string& text, bool keep){
+		{
+			lock_guard<mutex> guard(lock);
+			if ( !keep and pending.size() + text.size() > maxPending ){
+				dropped++;
+				return;
+			}
+			if ( dropped > 0 ){
+				ostringstream oss;
+				oss << "[warning][general] " << dropped
+						<< " messages dropped, the log output being too slow" << endl;
+				pending.append(oss.str());
+				dropped = 0;
+			}
+			pending.append(text);
+			if ( !flusher.joinable() and !stopping ) flusher = thread(&LogSink::run, this);
+		}
+		wake.notify_one();
+	}
+} sink;
+
+bool Logger::admit(Site& site){
+	if ( rateLimit == 0 ) return true;
+	long now = (long) chrono::duration_cast<chrono::seconds>(
+			chrono::steady_clock::now().time_since_epoch()).count();
+	long window = site.window.load();
+	if ( window != now and site.window.compare_exchange_strong(window, now) ) site.count = 0;
+	if ( ++site.count > rateLimit ){
+		site.suppressed++;
+		return false;
+	}
+	return true;
+}
+
+/* warning once when asking for messages that are not compiled in */
+static void checkCompiled(int level){
+	static atomic<bool> warned(false);
+	if ( level <= FF_LOG_MAX_LEVEL or warned.exchange(true) ) return;
+	cout << "WARNING: " << levelNames[level] << " messages are not compiled in"
+			<< ", build with FOREFIRE_DEBUG_LOGS to get them" << endl;
+}
+
+void Logger::write(const Level& level, const Category& category, const string& message, Site& site){
+	string text(message);
+	if ( !text.empty() and text[text.size()-1] == '\n' ) text.erase(text.size()-1);
+	size_t suppressed = site.suppressed.exchange(0);
+	if ( text.empty() and suppressed == 0 ) return;
+	text = string("[") + levelNames[level] + "][" + categoryNames[category] + "] " + text;
+	if ( suppressed > 0 ){
+		ostringstream oss;
+		oss << " (" << suppressed << " similar messages suppressed)";
+		text += oss.str();
+	}
+	text.push_back('\n');
+	if ( direct and sinkAlive ){
+		sink.out() << text << std::flush;
+		return;
+	}
+	if ( !sinkAlive ){
+		cout << text << std::flush;
+		return;
+	}
+	sink.append(text, level == error);
+	if ( level == error ) sink.drain();
+}
+
+void Logger::flush(){
+	if ( sinkAlive and !direct ) sink.drain();
+}
+
+void Logger::quiesce(){
+	if ( !sinkAlive or direct ) return;
+	{
+		lock_guard<mutex> guard(sink.lock);
+		sink.stopping = true;
+	}
+	sink.wake.notify_one();
+	if ( sink.flusher.joinable() ) sink.flusher.join();
+	sink.drain();
+	lock_guard<mutex> guard(sink.lock);
+	sink.stopping = false;
+}
+
+void Logger::forked(){
+	direct = true;
+}
+
+void Logger::setLevel(const Category& category, const Level& level){
+	if ( category < numCategories ) thresholds[category] = level;
+	checkCompiled(level);
+}
+
+int Logger::levelOf(const string& name){
+	for ( int l = error; l <= trace; l++ ){
+		if ( name == levelNames[l] ) return l;
+	}
+	return -1;
+}
+
+int Logger::categoryOf(const string& name){
+	for ( int c = general; c < numCategories; c++ ){
+		if ( name == categoryNames[c] ) return c;
+	}
+	return -1;
+}
+
+void Logger::configure(SimulationParameters* params){
+	int level = levelOf(params->getParameter("logLevel"));
+	if ( level < 0 ){
+		cout << "WARNING: unknown log level " << params->getParameter("logLevel")
+				<< ", keeping info" << endl;
+		level = info;
+	}
+	for ( int c = general; c < numCategories; c++ ) thresholds[c] = level;
+	checkCompiled(level);
+
+	/* per category levels, as in 'front:debug,layer:error' */
+	vector<string> specs = params->getParameterArray("logLevels");
+	for ( size_t i = 0; i < specs.size(); i++ ){
+		size_t colon = specs[i].find(':');
+		int category = categoryOf(specs[i].substr(0, colon));
+		int l = ( colon == string::npos ) ? -1 : levelOf(specs[i].substr(colon + 1));
+		if ( category < 0 or l < 0 ){
+			cout << "WARNING: ignoring log level specification " << specs[i] << endl;
+			continue;
+		}
+		thresholds[category] = l;
+		checkCompiled(l);
+	}
+
+	int limit = params->getInt("logRateLimit");
+	rateLimit = ( limit > 0 ) ? limit : 0;
+
+	string path = params->getParameter("logFile");
+	if ( !sinkAlive or direct ) return;
+	flush();
+	lock_guard<mutex> order(sink.writing);
+	if ( sink.file.is_open() ) sink.file.close();
+	if ( path.empty() or path == "cout" ) return;
+	sink.file.open(path.c_str(), ios_base::app);
+	if ( !sink.file.is_open() ) cout << "WARNING: could not open log file " << path << endl;
+}
+
+}
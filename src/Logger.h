@@ -0,0 +1,136 @@
+/**
+ * @file Logger.h
+ * @brief Leveled and rate limited diagnostics, written in the background.
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#ifndef LOGGER_H_
+#define LOGGER_H_
+
+#include <string>
+#include <sstream>
+#include <atomic>
+
+using namespace std;
+
+/* most verbose level compiled in the library, 'debug' and 'trace'
+ * messages being removed unless FOREFIRE_DEBUG_LOGS is set in cmake */
+#ifndef FF_LOG_MAX_LEVEL
+#define FF_LOG_MAX_LEVEL 2
+#endif
+
+namespace libforefire {
+
+class SimulationParameters;
+
+/*! \class Logger
+ * \brief Sink of the diagnostics of the simulation
+ *
+ *  Messages have a level (error, warning, info, debug, trace) and a
+ *  category naming the part of the code they come from. A message is
+ *  kept when its level is at most the threshold of its category,
+ *  set by the 'logLevel' and 'logLevels' parameters. Levels above
+ *  FF_LOG_MAX_LEVEL are removed at compile time, a warning being
+ *  printed when such a level is asked for.
+ *
+ *  Each call site may not emit more than 'logRateLimit' messages per
+ *  second, the number of messages suppressed being reported with the
+ *  next one emitted there.
+ *
+ *  Messages are prefixed by their level and category, as in
+ *  '[warning][layer] ...', and appended to a buffer, written to the
+ *  standard output or to 'logFile' by a helper thread, so that
+ *  emitting a message does not wait for the stream. Errors are written
+ *  before returning, and the buffer is written when the program exits.
+ *  When the stream cannot keep up and the buffer reaches 1 MB, other
+ *  messages are dropped, their number being reported with the next one kept.
+ *
+ *  Messages are emitted through the FF_ERROR, FF_WARNING, FF_INFO,
+ *  FF_DEBUG and FF_TRACE macros, e.g.
+ *  FF_WARNING(layer, "no data at " << loc.print());
+ *  the message being only formatted when kept.
+ */
+class Logger {
+
+public:
+
+	/*! \brief severity of the messages */
+	enum Level {
+		error = 0, warning = 1, info = 2, debug = 3, trace = 4
+	};
+
+	/*! \brief parts of the code the messages come from */
+	enum Category {
+		general = 0, domain, front, node, cell, layer, model, coupling, numCategories
+	};
+
+	/*! \brief rate limiting state of a call site */
+	struct Site {
+		atomic<long> window; /*!< second of the current window */
+		atomic<size_t> count; /*!< messages in the current window */
+		atomic<size_t> suppressed; /*!< messages suppressed since the last one emitted */
+		Site() : window(-1), count(0), suppressed(0) {}
+	};
+
+	/*! \brief checking whether a message of a given level and category is kept */
+	static bool enabled(const Level& l, const Category& c){
+		return l <= thresholds[c];
+	}
+	/*! \brief checking whether a call site may emit a message, accounting for it */
+	static bool admit(Site&);
+	/*! \brief appending a message to the buffer */
+	static void write(const Level&, const Category&, const string&, Site&);
+	/*! \brief writing the buffered messages before returning */
+	static void flush();
+	/*! \brief writing the buffered messages and stopping the helper thread,
+	 *  restarted by the next message, before forking the process */
+	static void quiesce();
+	/*! \brief writing the messages directly in a forked process, the locks
+	 *  of the buffer being possibly held by threads of the parent */
+	static void forked();
+
+	/*! \brief setting the threshold of a category */
+	static void setLevel(const Category&, const Level&);
+	/*! \brief reading the thresholds, rate limit and output of the parameters */
+	static void configure(SimulationParameters*);
+
+private:
+
+	static int thresholds[numCategories]; /*!< most verbose level kept per category */
+	static size_t rateLimit; /*!< messages per second and call site, 0 for no limit */
+
+	/*! \brief level corresponding to a name, or -1 */
+	static int levelOf(const string&);
+	/*! \brief category corresponding to a name, or -1 */
+	static int categoryOf(const string&);
+};
+
+}
+
+/*! \brief emitting a message if its level is compiled in and enabled */
+#define FF_LOG(level, category, message) do { \
+	if ( (level) <= FF_LOG_MAX_LEVEL \
+			and libforefire::Logger::enabled(level, category) ){ \
+		static libforefire::Logger::Site ffLogSite; \
+		if ( libforefire::Logger::admit(ffLogSite) ){ \
+			std::ostringstream ffLogMessage; \
+			ffLogMessage << message; \
+			libforefire::Logger::write(level, category, ffLogMessage.str(), ffLogSite); \
+		} \
+	} \
+} while (0)
+
+#define FF_ERROR(category, message) \
+	FF_LOG(libforefire::Logger::error, libforefire::Logger::category, message)
+#define FF_WARNING(category, message) \
+	FF_LOG(libforefire::Logger::warning, libforefire::Logger::category, message)
+#define FF_INFO(category, message) \
+	FF_LOG(libforefire::Logger::info, libforefire::Logger::category, message)
+#define FF_DEBUG(category, message) \
+	FF_LOG(libforefire::Logger::debug, libforefire::Logger::category, message)
+#define FF_TRACE(category, message) \
+	FF_LOG(libforefire::Logger::trace, libforefire::Logger::category, message)
+
+#endif /* LOGGER_H_ */
@@ -0,0 +1,130 @@
+/**
+ * @file NCChunkWriter.h
+ * @brief Chunked, band by band, writing of transposed arrays into NetCDF variables.
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#ifndef NCCHUNKWRITER_H_
+#define NCCHUNKWRITER_H_
+
+#include <netcdf>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+using namespace std;
+using namespace netCDF;
+using namespace netCDF::exceptions;
+
+namespace libforefire {
+
+/*! \class NCChunkWriter
+ * \brief Streaming export of arrays stored in the transposed FFArray layout
+ *
+ *  Landscape arrays are held in memory with the (x,y,z,t) layout
+ *  of the Fortran side, while NetCDF variables are written in the
+ *  C (t,z,y,x) order. Instead of reshaping a full copy of each
+ *  field, the writer transposes one band of 'chunkRows' rows at a
+ *  time and writes it with a strided put, so that only two bands
+ *  are ever held in memory. The next band is transposed in a
+ *  helper thread while the current one is being compressed and
+ *  written by the library, the NetCDF calls themselves staying on
+ *  the calling thread.
+ *
+ *  Variables are chunked by (1, 1, chunkRows, chunkCols) blocks so
+ *  that each band covers whole chunks, and compressed with deflate
+ *  and, optionally, the shuffle filter.
+ */
+class NCChunkWriter {
+
+	size_t chunkRows; /*!< number of rows (y) of a chunk, and of a band */
+	size_t chunkCols; /*!< number of columns (x) of a chunk */
+	bool chunked; /*!< variables are explicitly chunked */
+	bool shuffle; /*!< shuffle filter applied before deflate */
+	int level; /*!< deflate level, 0 for no compression */
+
+	/*! \brief transposing rows [y0, y0+rows) of the source into a band */
+	template<typename D, typename S> static void transposeBand(const S* src
+			, size_t nt, size_t nz, size_t ny, size_t nx
+			, size_t y0, size_t rows, vector<D>* band){
+		band->resize(nt*nz*rows*nx);
+		D* out = band->data();
+		for ( size_t t = 0; t < nt; t++ ){
+			for ( size_t z = 0; z < nz; z++ ){
+				for ( size_t y = y0; y < y0 + rows; y++ ){
+					for ( size_t x = 0; x < nx; x++ ){
+						*out++ = static_cast<D>(src[t + nt*(z + nz*(y + ny*x))]);
+					}
+				}
+			}
+		}
+	}
+
+public:
+
+	/*! \brief Constructor from the chunk shape (0 for contiguous storage),
+	 * the shuffle flag and the deflate level */
+	NCChunkWriter(size_t rows, size_t cols, bool shuf, int lvl)
+		: chunkRows(rows), chunkCols(cols), shuffle(shuf), level(lvl) {
+		chunked = ( chunkRows > 0 and chunkCols > 0 );
+		if ( !chunked ) {
+			/* bands are still used to bound the memory of the transposition */
+			chunkRows = 256;
+			chunkCols = 0;
+		}
+	}
+
+	/*! \brief setting storage and filters of a (t, z, y, x) variable,
+	 * to be called before anything is written in it */
+	void define(NcVar& var, size_t ny, size_t nx){
+		if ( chunked or level > 0 ) {
+			vector<size_t> chunks(4, 1);
+			chunks[2] = min(chunkRows, ny);
+			chunks[3] = chunked ? min(chunkCols, nx) : nx;
+			var.setChunking(NcVar::nc_CHUNKED, chunks);
+		}
+		if ( level > 0 ) var.setCompression(shuffle, true, level);
+	}
+
+	/*! \brief writing a source in the transposed layout of dimensions
+	 * (nx, ny, nz, nt) into a variable of type D, starting at index 'first'
+	 * of its leading dimension */
+	template<typename D, typename S> void write(NcVar& var, const S* src
+			, size_t nt, size_t nz, size_t ny, size_t nx, size_t first = 0){
+		if ( nt*nz*ny*nx == 0 ) return;
+		size_t rows = min(chunkRows, ny);
+		vector<D> bands[2];
+		transposeBand<D, S>(src, nt, nz, ny, nx, 0, rows, &bands[0]);
+		vector<size_t> start(4, 0);
+		vector<size_t> count(4, 0);
+		start[0] = first;
+		count[0] = nt;
+		count[1] = nz;
+		count[3] = nx;
+		size_t current = 0;
+		for ( size_t y0 = 0; y0 < ny; y0 += rows ){
+			size_t bandRows = min(rows, ny - y0);
+			size_t next = y0 + bandRows;
+			thread helper;
+			if ( next < ny ) helper = thread(transposeBand<D, S>, src, nt, nz, ny, nx
+					, next, min(rows, ny - next), &bands[1 - current]);
+			start[2] = y0;
+			count[2] = bandRows;
+			try {
+				var.putVar(start, count, bands[current].data());
+			} catch (...) {
+				if ( helper.joinable() ) helper.join();
+				throw;
+			}
+			if ( helper.joinable() ) helper.join();
+			current = 1 - current;
+		}
+	}
+
+};
+
+}
+
+#endif /* NCCHUNKWRITER_H_ */
@@ -0,0 +1,293 @@
+/**
+ * @file NCTileCache.h
+ * @brief Lazily loaded, LRU-capped tiles of a NetCDF landscape variable.
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#ifndef NCTILECACHE_H_
+#define NCTILECACHE_H_
+
+#include <netcdf>
+#include <list>
+#include <map>
+#include <vector>
+#include <iostream>
+
+using namespace std;
+using namespace netCDF;
+using namespace netCDF::exceptions;
+
+namespace libforefire {
+
+/*! \class NCTileCache
+ * \brief Tiled, on demand, access to a NetCDF variable
+ *
+ *  NCTileCache keeps the NetCDF variable opened and only reads
+ *  the (x,y) tiles that are actually accessed, each tile holding
+ *  all the 'z' and 't' levels of its columns. Tiles are aligned
+ *  on the chunks of the variable when it is chunked. Resident
+ *  tiles are limited in number, the least recently used tile is
+ *  evicted when the limit is reached. Values are returned with
+ *  the same (i,j,k,t) indexing as the transposed FFArray of a
+ *  fully loaded layer.
+ */
+template<typename T> class NCTileCache {
+
+	NcFile* file; /*!< NetCDF file kept opened */
+	NcVar var; /*!< NetCDF variable of the layer */
+
+	size_t nx; /*!< size of the variable in the X direction */
+	size_t ny; /*!< size of the variable in the Y direction */
+	size_t nz; /*!< size of the variable in the Z direction */
+	size_t nt; /*!< number of time steps read */
+	size_t firstT; /*!< first time step read in the variable */
+
+	size_t tileX; /*!< size of a tile in the X direction */
+	size_t tileY; /*!< size of a tile in the Y direction */
+	size_t tilesY; /*!< number of tiles in the Y direction */
+	size_t tileSize; /*!< number of values in a tile */
+	size_t maxTiles; /*!< maximum number of resident tiles */
+
+	typedef list<size_t> lruList;
+	lruList lru; /*!< resident tiles, most recently used first */
+	map<size_t, pair<T*, lruList::iterator> > tiles; /*!< resident tiles */
+
+	size_t lastKey; /*!< last accessed tile */
+	T* lastTile; /*!< data of the last accessed tile */
+
+	map<size_t, T> edits; /*!< values set since the file was read, by position */
+
+	size_t numLoads; /*!< number of tiles read from file */
+	size_t numEvictions; /*!< number of tiles evicted */
+
+	/*! \brief reading the given tile from file */
+	T* loadTile(const size_t&);
+	/*! \brief reading the given region of the variable in C order */
+	void readRegion(const size_t&, const size_t&, const size_t&, const size_t&, T*);
+
+public:
+
+	/*! \brief Constructor from a file, a variable name, its dimensions,
+	 * the selected time step (-1 for all), the memory cap in MB and
+	 * the size of tiles when the variable is not chunked */
+	NCTileCache(const string&, const string&, size_t, size_t, size_t, size_t
+			, int = -1, size_t = 256, size_t = 256);
+	/*! \brief destructor */
+	~NCTileCache();
+
+	/*! \brief obtains the value at a given position */
+	T operator() (size_t, size_t = 0, size_t = 0, size_t = 0);
+
+	/*! \brief setting the value at a given position, kept over evictions */
+	void set(const T&, size_t, size_t = 0, size_t = 0, size_t = 0);
+
+	/*! \brief reading the whole variable in the transposed layout */
+	void readAll(T*);
+
+	/*! \brief evicting all the resident tiles, returns the bytes freed */
+	size_t evictAll();
+
+	/*! \brief memory currently used by resident tiles */
+	size_t residentBytes(){ return tiles.size()*tileSize*sizeof(T)
+			+ edits.size()*(sizeof(size_t)+sizeof(T)); }
+	size_t getNumLoads(){ return numLoads; }
+	size_t getNumEvictions(){ return numEvictions; }
+	bool isNull(){ return file == NULL; }
+
+};
+
+template<typename T>
+NCTileCache<T>::NCTileCache(const string& filename, const string& varname
+		, size_t nnx, size_t nny, size_t nnz, size_t nnt
+		, int selectedT, size_t maxMB, size_t defaultTile)
+	: file(NULL), nx(nnx), ny(nny), nz(nnz), nt(nnt)
+	  , lastKey((size_t) -1), lastTile(NULL)
+	  , numLoads(0), numEvictions(0) {
+
+	if ( nz < 1 ) nz = 1;
+	if ( nt < 1 ) nt = 1;
+	firstT = ( selectedT < 0 ) ? 0 : selectedT;
+	if ( selectedT > -1 ) nt = 1;
+
+	try {
+		file = new NcFile(filename.c_str(), NcFile::read);
+		var = file->getVar(varname);
+		if ( var.isNull() ) {
+			cout<<"Error: variable "<<varname<<" not found in "<<filename<<endl;
+			delete file;
+			file = NULL;
+		}
+	} catch (NcException& e) {
+		cout<<"Error: unable to open "<<filename<<" for tiled access: "<<e.what()<<endl;
+		file = NULL;
+	}
+
+	/* tiles are made of whole chunks of the variable when possible */
+	tileX = defaultTile;
+	tileY = defaultTile;
+	if ( file != NULL && var.getDimCount() >= 2 ){
+		NcVar::ChunkMode mode;
+		vector<size_t> chunks;
+		var.getChunkingParameters(mode, chunks);
+		if ( mode == NcVar::nc_CHUNKED && chunks.size() == (size_t) var.getDimCount() ){
+			size_t cx = chunks[chunks.size()-1];
+			size_t cy = chunks[chunks.size()-2];
+			if ( cx > 0 ) tileX = cx*((defaultTile > cx) ? defaultTile/cx : 1);
+			if ( cy > 0 ) tileY = cy*((defaultTile > cy) ? defaultTile/cy : 1);
+		}
+	}
+	if ( tileX > nx ) tileX = nx;
+	if ( tileY > ny ) tileY = ny;
+	if ( tileX < 1 ) tileX = 1;
+	if ( tileY < 1 ) tileY = 1;
+	tilesY = (ny + tileY - 1)/tileY;
+	tileSize = tileX*tileY*nz*nt;
+
+	maxTiles = (maxMB*1024*1024)/(tileSize*sizeof(T));
+	if ( maxTiles < 4 ) maxTiles = 4;
+}
+
+template<typename T>
+NCTileCache<T>::~NCTileCache() {
+	typename map<size_t, pair<T*, lruList::iterator> >::iterator tile;
+	for ( tile = tiles.begin(); tile != tiles.end(); ++tile ) delete [] tile->second.first;
+	tiles.clear();
+	delete file;
+}
+
+template<typename T>
+T NCTileCache<T>::operator() (size_t i, size_t j, size_t k, size_t t){
+	size_t key = (i/tileX)*tilesY + j/tileY;
+	if ( key != lastKey ){
+		typename map<size_t, pair<T*, lruList::iterator> >::iterator tile = tiles.find(key);
+		if ( tile == tiles.end() ){
+			lastTile = loadTile(key);
+		} else {
+			lru.splice(lru.begin(), lru, tile->second.second);
+			lastTile = tile->second.first;
+		}
+		lastKey = key;
+	}
+	return lastTile[(((i%tileX)*tileY + j%tileY)*nz + k)*nt + t];
+}
+
+template<typename T>
+size_t NCTileCache<T>::evictAll(){
+	size_t freed = residentBytes();
+	typename map<size_t, pair<T*, lruList::iterator> >::iterator tile;
+	for ( tile = tiles.begin(); tile != tiles.end(); ++tile ) delete [] tile->second.first;
+	numEvictions += tiles.size();
+	tiles.clear();
+	lru.clear();
+	lastKey = (size_t) -1;
+	lastTile = NULL;
+	return freed;
+}
+
+template<typename T>
+T* NCTileCache<T>::loadTile(const size_t& key){
+
+	/* making room for the new tile */
+	while ( tiles.size() >= maxTiles ){
+		size_t oldest = lru.back();
+		lru.pop_back();
+		delete [] tiles[oldest].first;
+		tiles.erase(oldest);
+		numEvictions++;
+	}
+
+	size_t i0 = (key/tilesY)*tileX;
+	size_t j0 = (key%tilesY)*tileY;
+	size_t cx = ( i0 + tileX > nx ) ? nx - i0 : tileX;
+	size_t cy = ( j0 + tileY > ny ) ? ny - j0 : tileY;
+
+	T* data = new T[tileSize];
+	for ( size_t n = 0; n < tileSize; n++ ) data[n] = 0;
+
+	if ( file != NULL ){
+		T* tmp = new T[nt*nz*cy*cx];
+		readRegion(i0, j0, cx, cy, tmp);
+		/* from the [t][z][y][x] layout of the file to [x][y][z][t] */
+		size_t indF = 0;
+		for ( size_t l = 0; l < nt; l++ )
+			for ( size_t k = 0; k < nz; k++ )
+				for ( size_t jj = 0; jj < cy; jj++ )
+					for ( size_t ii = 0; ii < cx; ii++ )
+						data[((ii*tileY + jj)*nz + k)*nt + l] = tmp[indF++];
+		delete [] tmp;
+	}
+	/* values set since the file was read, columns of the tile being
+	 * contiguous in the positions for each of its rows */
+	typename map<size_t, T>::iterator edit = edits.lower_bound(i0*ny*nz*nt);
+	typename map<size_t, T>::iterator last = edits.lower_bound((i0+cx)*ny*nz*nt);
+	for ( ; edit != last; ++edit ){
+		size_t ii = edit->first/(ny*nz*nt);
+		size_t jj = (edit->first/(nz*nt))%ny;
+		if ( jj < j0 or jj >= j0 + cy ) continue;
+		data[(((ii-i0)*tileY + jj-j0)*nz + (edit->first/nt)%nz)*nt + edit->first%nt] = edit->second;
+	}
+
+	lru.push_front(key);
+	tiles[key] = make_pair(data, lru.begin());
+	numLoads++;
+	return data;
+}
+
+template<typename T>
+void NCTileCache<T>::readRegion(const size_t& i0, const size_t& j0
+		, const size_t& cx, const size_t& cy, T* vals){
+	int ndims = var.getDimCount();
+	vector<size_t> start(ndims, 0);
+	vector<size_t> count(ndims, 1);
+	start[ndims-1] = i0;
+	count[ndims-1] = cx;
+	if ( ndims > 1 ){
+		start[ndims-2] = j0;
+		count[ndims-2] = cy;
+	}
+	if ( ndims > 2 ) count[ndims-3] = nz;
+	if ( ndims > 3 ){
+		start[ndims-4] = firstT;
+		count[ndims-4] = nt;
+	}
+	try {
+		var.getVar(start, count, vals);
+	} catch (NcException& e) {
+		cout<<"Error: unable to read a tile of "<<var.getName()<<": "<<e.what()<<endl;
+		for ( size_t n = 0; n < nt*nz*cy*cx; n++ ) vals[n] = 0;
+	}
+}
+
+template<typename T>
+void NCTileCache<T>::readAll(T* data){
+	T* tmp = new T[nt*nz*ny*nx];
+	if ( file != NULL ) {
+		readRegion(0, 0, nx, ny, tmp);
+	} else {
+		for ( size_t n = 0; n < nt*nz*ny*nx; n++ ) tmp[n] = 0;
+	}
+	size_t indF = 0;
+	for ( size_t l = 0; l < nt; l++ )
+		for ( size_t k = 0; k < nz; k++ )
+			for ( size_t j = 0; j < ny; j++ )
+				for ( size_t i = 0; i < nx; i++ )
+					data[((i*ny + j)*nz + k)*nt + l] = tmp[indF++];
+	delete [] tmp;
+	typename map<size_t, T>::iterator edit;
+	for ( edit = edits.begin(); edit != edits.end(); ++edit ) data[edit->first] = edit->second;
+}
+
+template<typename T>
+void NCTileCache<T>::set(const T& value, size_t i, size_t j, size_t k, size_t t){
+	edits[((i*ny + j)*nz + k)*nt + t] = value;
+	typename map<size_t, pair<T*, lruList::iterator> >::iterator tile
+		= tiles.find((i/tileX)*tilesY + j/tileY);
+	if ( tile != tiles.end() )
+		tile->second.first[(((i%tileX)*tileY + j%tileY)*nz + k)*nt + t] = value;
+}
+
+}
+
+#endif /* NCTILECACHE_H_ */
@@ -13,6 +13,7 @@
 #include "DataLayer.h"
 
 #include "FluxModel.h"
+#include "NCTileCache.h"
 
 #include <cmath> // For atan2 and M_PI
 
@@ -61,6 +62,8 @@ template<typename T> class XYZTDataLayer : public DataLayer<T> {
 
 
 	FFArray<T>* array; /*!< pointer to the FFArray containing the data */
+	NCTileCache<T>* tiles; /*!< lazily loaded data, 'array' then only being a copy for getMatrix */
+	FFArray<float>* compact; /*!< single precision data, if not held in 'array' */
 
 	/*! \brief Interpolation method: lowest order */
 	T getNearestData(FFPoint, const double&);
@@ -69,6 +72,11 @@ template<typename T> class XYZTDataLayer : public DataLayer<T> {
 	FFPoint posToIndices(FFPoint&);
 	T bilinearInterp(FFPoint, const double&);
 
+	/*! \brief setting the geometry and interpolation mode of the layer */
+	void initGeometry(FFPoint&, FFPoint&, double&);
+	/*! \brief value at a given position in the (possibly tiled) data */
+	T valueAtPos(size_t);
+
 public:
 
 
@@ -80,6 +88,8 @@ public:
 			nz = 1;
 			nt = 1;
 			array = NULL;
+			tiles = NULL;
+			compact = NULL;
 			size = 1;
 			SWCornerX = 0.;
 			SWCornerY = 0.;
@@ -109,6 +119,8 @@ public:
 		nz = 1;
 		nt = 1;
 		array = new FFArray<T>(name, val, nx, ny, nz, nt);
+		tiles = NULL;
+		compact = NULL;
 		size = 1;
 		SWCornerX = 0.;
 		SWCornerY = 0.;
@@ -138,56 +150,21 @@ public:
 		DataLayer<T>(name), startTime(t0)
 		, nx(nnx), ny(nny), nz(nnz), nt(nnt) { 
 		array = new FFArray<T>(name, vals, nnx, nny, nnz, nnt);
-		size = (size_t) nx*ny*nz*nt;
- 
-		SWCornerX = SWCorner.getX();
-		nameOf=name;
-		SWCornerY = SWCorner.getY();
-		SWCornerZ = SWCorner.getZ();
-		NECornerX = SWCornerX + extent.getX();
-		NECornerY = SWCornerY + extent.getY();
-		NECornerZ = SWCornerZ + extent.getZ(); 
-		endTime = startTime + timespan;
- 
-		dx = extent.getX()/nx;
-		dy = extent.getY()/ny;
-		dz = extent.getZ()/nz;
-		dt = 0;
-		if((timespan < 3600*24)&&	(nt>1)){	 
-			dt = timespan/(nt-1);
-		}
- 
-		interp = InterpolationBilinear; 
-		interDirID0 = 0 ;
-		interDirID1 = 1 ;
-		interDirRatio = 1  ;
-		interDirScaler = 1  ;
-
-		if(nt>1){
-			interp = InterpolationBilinearT;
-		}
-		if((nt==1)&&(nz==2))
-		{
-			interp = InterpolationBilinearCoeff;
-		}		
-		if((nt==1)&&(nz==8))
-		{
-			interp = InterpolationBilinearDir;
-		}
-
-	/*	if(	interp == InterpolationBilinear){
-			cout<<"layer "<<name<<" is mode InterpolationBilinear"<<endl;
-		}
-		if(	interp == InterpolationBilinearT){
-			cout<<"layer "<<name<<" is mode InterpolationBilinear with Time"<<endl;
-		}
-		if(	interp == InterpolationBilinearCoeff){
-			cout<<"layer "<<name<<" is mode InterpolationBilinear with UV Coeff"<<endl;
-		}
-		if(	interp == InterpolationBilinearDir){
-			cout<<"layer "<<name<<" is mode InterpolationBilinear Scalar Dir (8 directions)"<<endl;
-		}*/
-
+		tiles = NULL;
+		compact = NULL;
+		initGeometry(SWCorner, extent, timespan);
+	}
+	/*! \brief Constructor with data lazily read by tiles in a NetCDF file */
+	XYZTDataLayer(string name, FFPoint& SWCorner, double& t0
+			, FFPoint& extent, double& timespan
+			, size_t& nnx, size_t& nny, size_t& nnz, size_t& nnt
+			, NCTileCache<T>* lazyData) :
+		DataLayer<T>(name), startTime(t0)
+		, nx(nnx), ny(nny), nz(nnz), nt(nnt) {
+		array = NULL;
+		tiles = lazyData;
+		compact = NULL;
+		initGeometry(SWCorner, extent, timespan);
 	}
 	/*! \brief destructor */
 	~XYZTDataLayer();
@@ -220,9 +197,21 @@ public:
 	size_t getValuesAt(FireNode*, PropagationModel*, size_t);
 	/*! \brief directly stores the desired values in a given array */
 	size_t getValuesAt(FFPoint, const double&, FluxModel*, size_t);
+	/*! \brief keeping the values in single precision, interpolations stay in double */
+	void setSinglePrecision();
+
+	/*! \brief values are only read, except for tiles loaded on demand */
+	bool concurrentReads(){ return tiles == 0; }
 
 	/*! \brief getter to the desired array at surface for a given time (should not be used) */
 	void getMatrix(FFArray<T>**, const double&);
+	/*! \brief memory held by the layer (bytes) */
+	size_t getMemorySize(){ return this->arrayMemory(array) + this->arrayMemory(compact)
+			+ (tiles ? tiles->residentBytes() : 0); }
+	/*! \brief evicting the resident tiles of lazily loaded data */
+	size_t releaseCache(){ return releaseMatrix() + (tiles ? tiles->evictAll() : 0); }
+	/*! \brief releasing the copy of the lazily loaded or single precision data made by getMatrix */
+	size_t releaseMatrix();
 	/*! \brief stores array from a given array (should not be used) */
 	void setMatrix(string&, double*, const size_t&, size_t&, const double&);
 
@@ -250,18 +239,96 @@ public:
 template<typename T>
 XYZTDataLayer<T>::~XYZTDataLayer() {
 	delete array;
+	delete tiles;
+	delete compact;
+}
+
+template<typename T>
+void XYZTDataLayer<T>::initGeometry(FFPoint& SWCorner, FFPoint& extent, double& timespan){
+	size = (size_t) nx*ny*nz*nt;
+	string name = this->getKey();
+
+	SWCornerX = SWCorner.getX();
+	nameOf=name;
+	SWCornerY = SWCorner.getY();
+	SWCornerZ = SWCorner.getZ();
+	NECornerX = SWCornerX + extent.getX();
+	NECornerY = SWCornerY + extent.getY();
+	NECornerZ = SWCornerZ + extent.getZ(); 
+	endTime = startTime + timespan;
+ 
+	dx = extent.getX()/nx;
+	dy = extent.getY()/ny;
+	dz = extent.getZ()/nz;
+	dt = 0;
+	if((timespan < 3600*24)&&	(nt>1)){	 
+		dt = timespan/(nt-1);
+	}
+ 
+	interp = InterpolationBilinear; 
+	interDirID0 = 0 ;
+	interDirID1 = 1 ;
+	interDirRatio = 1  ;
+	interDirScaler = 1  ;
+
+	if(nt>1){
+		interp = InterpolationBilinearT;
+	}
+	if((nt==1)&&(nz==2))
+	{
+		interp = InterpolationBilinearCoeff;
+	}		
+	if((nt==1)&&(nz==8))
+	{
+		interp = InterpolationBilinearDir;
+	}
+
+/*	if(	interp == InterpolationBilinear){
+		cout<<"layer "<<name<<" is mode InterpolationBilinear"<<endl;
+	}
+	if(	interp == InterpolationBilinearT){
+		cout<<"layer "<<name<<" is mode InterpolationBilinear with Time"<<endl;
+	}
+	if(	interp == InterpolationBilinearCoeff){
+		cout<<"layer "<<name<<" is mode InterpolationBilinear with UV Coeff"<<endl;
+	}
+	if(	interp == InterpolationBilinearDir){
+		cout<<"layer "<<name<<" is mode InterpolationBilinear Scalar Dir (8 directions)"<<endl;
+	}*/
+
 }
 
 template<typename T>
 T XYZTDataLayer<T>::getVal(size_t pos){
+	return valueAtPos(pos);
+}
+
+template<typename T>
+T XYZTDataLayer<T>::valueAtPos(size_t pos){
+	if ( tiles ) return (*tiles)(pos/(ny*nz*nt), (pos/(nz*nt))%ny, (pos/nt)%nz, pos%nt);
+	if ( compact ) return (T) (compact->getData())[pos];
 	return (*array)(pos);
 }
 
 template<typename T>
 T XYZTDataLayer<T>::getVal(size_t i, size_t j, size_t k, size_t t){
+	if ( tiles ) return (*tiles)(i, j, k, t);
+	if ( compact ) return (T) (*compact)(i, j, k, t);
 	return (*array)(i, j, k, t);
 }
 
+template<typename T>
+void XYZTDataLayer<T>::setSinglePrecision(){
+	/* lazily loaded layers are already kept out of memory */
+	if ( array == NULL or size < 2 ) return;
+	compact = new FFArray<float>(this->getKey(), 0.f, nx, ny, nz, nt);
+	T* vals = array->getData();
+	float* cvals = compact->getData();
+	for ( size_t pos = 0; pos < size; pos++ ) cvals[pos] = (float) vals[pos];
+	delete array;
+	array = NULL;
+}
+
 template<typename T>
 size_t XYZTDataLayer<T>::getPos(FFPoint& loc, const double& t){
 	int i = nx>1 ? (int) (loc.getX()-SWCornerX)/dx : 0;
@@ -305,10 +372,10 @@ template<typename T>
 T XYZTDataLayer<T>::getValueAt(FFPoint loc, const double& t){
 
 
-	if ( size == 1 ) return (*array)(0, 0, 0, 0);
+	if ( size == 1 ) return getVal(0, 0, 0, 0);
 
 	if ( interp == InterpolationNearestData ) {
-		return ((*array)(getPos(loc,t)));
+		return valueAtPos(getPos(loc,t));
 	}
 
 
@@ -446,7 +513,7 @@ size_t XYZTDataLayer<T>::getValuesAt(
 
 template<typename T>
 T XYZTDataLayer<T>::getNearestData(FFPoint loc, const double& time){
-	return (*array)(getPos(loc,time));
+	return valueAtPos(getPos(loc,time));
 }
 
 template<typename T>
@@ -463,9 +530,34 @@ FFPoint XYZTDataLayer<T>::posToIndices(FFPoint& loc){
 template<typename T>
 void XYZTDataLayer<T>::getMatrix(
 		FFArray<T>** matrix, const double& time){
+	if ( array == NULL and tiles != NULL ){
+		/* the whole field is copied, values being still read by tiles */
+		T* vals = new T[size];
+		tiles->readAll(vals);
+		array = new FFArray<T>(this->getKey(), vals, nx, ny, nz, nt);
+		delete [] vals;
+	}
+	if ( array == NULL and compact != NULL ){
+		/* the whole field is copied in full precision, values being
+		 * still read in single precision until the copy is released */
+		T* vals = new T[size];
+		float* cvals = compact->getData();
+		for ( size_t pos = 0; pos < size; pos++ ) vals[pos] = (T) cvals[pos];
+		array = new FFArray<T>(this->getKey(), vals, nx, ny, nz, nt);
+		delete [] vals;
+	}
 	*matrix = array;
 }
 
+template<typename T>
+size_t XYZTDataLayer<T>::releaseMatrix(){
+	if ( (tiles == NULL and compact == NULL) or array == NULL ) return 0;
+	size_t freed = this->arrayMemory(array);
+	delete array;
+	array = NULL;
+	return freed;
+}
+
 template<typename T>
 void XYZTDataLayer<T>::setMatrix(string& mname, double* inMatrix
 		, const size_t& sizein, size_t& sizeout, const double& time){
@@ -0,0 +1,90 @@
+/**
+ * @file PolygonIndex.cpp
+ * @brief Implements the y-banded edge table of a vertex ring
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#include "PolygonIndex.h"
+
+namespace libforefire {
+
+PolygonIndex::PolygonIndex() : numBands(0), numVertices(0)
+	, ymin(0.), ymax(0.), xmin(0.), invBandHeight(0.) {
+}
+
+PolygonIndex::PolygonIndex(const size_t& nvert, const double* vertx, const double* verty)
+	: numBands(0), numVertices(0), ymin(0.), ymax(0.), xmin(0.), invBandHeight(0.) {
+	build(nvert, vertx, verty);
+}
+
+PolygonIndex::~PolygonIndex() {
+}
+
+void PolygonIndex::build(const size_t& nvert, const double* vertx, const double* verty){
+	bandEdges.clear();
+	bandStart.clear();
+	numVertices = nvert;
+	numBands = 0;
+	if ( nvert == 0 ) return;
+
+	ymin = ymax = verty[0];
+	xmin = vertx[0];
+	for ( size_t i = 1; i < nvert; i++ ){
+		if ( verty[i] < ymin ) ymin = verty[i];
+		if ( verty[i] > ymax ) ymax = verty[i];
+		if ( vertx[i] < xmin ) xmin = vertx[i];
+	}
+	numBands = nvert/2 + 1;
+	invBandHeight = ( ymax > ymin ) ? numBands/(ymax - ymin) : 0.;
+
+	/* counting, then filling the edges of each band; horizontal
+	 * edges are never crossed and are left out */
+	vector<size_t> first(nvert), last(nvert);
+	bandStart.assign(numBands + 1, 0);
+	size_t j = nvert - 1;
+	for ( size_t i = 0; i < nvert; i++ ){
+		if ( verty[i] != verty[j] ){
+			first[i] = band(verty[i] < verty[j] ? verty[i] : verty[j]);
+			last[i] = band(verty[i] < verty[j] ? verty[j] : verty[i]);
+			for ( size_t b = first[i]; b <= last[i]; b++ ) bandStart[b + 1]++;
+		}
+		j = i;
+	}
+	for ( size_t b = 0; b < numBands; b++ ) bandStart[b + 1] += bandStart[b];
+	bandEdges.resize(bandStart[numBands]);
+	vector<size_t> fill(bandStart.begin(), bandStart.end() - 1);
+	j = nvert - 1;
+	for ( size_t i = 0; i < nvert; i++ ){
+		if ( verty[i] != verty[j] ){
+			Edge e = {vertx[i], verty[i], vertx[j], verty[j]};
+			for ( size_t b = first[i]; b <= last[i]; b++ ) bandEdges[fill[b]++] = e;
+		}
+		j = i;
+	}
+}
+
+bool PolygonIndex::contains(const double& x, const double& y) const {
+	/* an edge is crossed only if y is in ]min(yi,yj), max(yi,yj)]
+	 * and one of its ends is at the left of the point */
+	if ( numBands == 0 or !(y > ymin) or y > ymax or x < xmin ) return false;
+	size_t b = band(y);
+	bool oddNodes = false;
+	for ( size_t k = bandStart[b]; k < bandStart[b + 1]; k++ ){
+		const Edge& e = bandEdges[k];
+		if ( ((e.yi < y && e.yj >= y) or (e.yj < y && e.yi >= y))
+				and ( (e.xi <= x) or (e.xj <= x) ) ) {
+			if ( e.xi + (y - e.yi)/(e.yj - e.yi)*(e.xj - e.xi) < x ){
+				oddNodes = !oddNodes;
+			}
+		}
+	}
+	return oddNodes;
+}
+
+void PolygonIndex::contains(const size_t& n, const double* xs, const double* ys, char* inside) const {
+	for ( size_t p = 0; p < n; p++ ) inside[p] = contains(xs[p], ys[p]) ? 1 : 0;
+}
+
+}
@@ -0,0 +1,81 @@
+/**
+ * @file PolygonIndex.h
+ * @brief Y-banded edge table answering point in polygon queries without walking all the vertices.
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#ifndef POLYGONINDEX_H_
+#define POLYGONINDEX_H_
+
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+namespace libforefire {
+
+/*! \class PolygonIndex
+ * \brief Spatial index of the edges of a vertex ring
+ *
+ *  The y extent of the ring is cut into bands of equal height,
+ *  each band listing the edges whose y range overlaps it. A query
+ *  only tests the edges of the band of its y coordinate with the
+ *  same crossing rule and the same arithmetic as
+ *  FFPoint::pointInPolygon, so that both always agree. With about
+ *  one band per two vertices, the cost of a query is that of the
+ *  few edges crossing its band instead of the whole ring.
+ *
+ *  The index holds a copy of the edges, it has to be rebuilt when
+ *  the ring changes (see FireFront::constructVerticesVectors).
+ */
+class PolygonIndex {
+
+	/*! \brief edge from vertex 'i' to its predecessor 'j' */
+	struct Edge {
+		double xi, yi, xj, yj;
+	};
+
+	vector<Edge> bandEdges; /*!< edges of each band, band after band */
+	vector<size_t> bandStart; /*!< first edge of each band in 'bandEdges' */
+	size_t numBands; /*!< number of bands */
+	size_t numVertices; /*!< number of vertices of the ring */
+	double ymin; /*!< lowest y of the ring */
+	double ymax; /*!< highest y of the ring */
+	double xmin; /*!< lowest x of the ring */
+	double invBandHeight; /*!< inverse of the height of a band */
+
+	/*! \brief band of a given y coordinate */
+	size_t band(const double& y) const {
+		double b = (y - ymin)*invBandHeight;
+		if ( !(b > 0.) ) return 0;
+		size_t ib = (size_t) b;
+		return ( ib < numBands ) ? ib : numBands - 1;
+	}
+
+public:
+
+	/*! \brief Default constructor, empty index */
+	PolygonIndex();
+	/*! \brief Constructor from the vertices of a ring */
+	PolygonIndex(const size_t&, const double*, const double*);
+	/*! \brief destructor */
+	~PolygonIndex();
+
+	/*! \brief rebuilding the index for a new ring */
+	void build(const size_t&, const double*, const double*);
+
+	/*! \brief checking if a point lies inside the ring */
+	bool contains(const double&, const double&) const;
+	/*! \brief checking a batch of points, results being stored as 0 or 1 */
+	void contains(const size_t&, const double*, const double*, char*) const;
+
+	size_t getNumVertices() const { return numVertices; }
+	bool empty() const { return numVertices == 0; }
+
+};
+
+}
+
+#endif /* POLYGONINDEX_H_ */
@@ -0,0 +1,181 @@
+/**
+ * @file RasterPropagator.cpp
+ * @brief Implements the narrow band raster propagation engine
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#include "RasterPropagator.h"
+#include "FireDomain.h"
+#include "PolygonIndex.h"
+#include <cmath>
+#include <sstream>
+
+namespace libforefire {
+
+const int RasterPropagator::stencil[16][2] = {
+		{1,0}, {0,1}, {-1,0}, {0,-1},
+		{1,1}, {-1,1}, {-1,-1}, {1,-1},
+		{2,1}, {1,2}, {-1,2}, {-2,1},
+		{-2,-1}, {-1,-2}, {1,-2}, {2,-1} };
+
+RasterPropagator::RasterPropagator(FireDomain* fd, const double& t)
+	: ForeFireAtom(t), domain(fd), numBurnt(0), numEvaluations(0) {
+	probe = new FireNode(domain);
+	probe->setDomain(domain);
+	timeStep = SimulationParameters::GetInstance()->getDouble("rasterTimeStep");
+	if ( !(timeStep > 0.) ) timeStep = 10.;
+	setUpdateTime(t);
+}
+
+RasterPropagator::~RasterPropagator() {
+	delete probe;
+}
+
+bool RasterPropagator::burnt(const size_t& ii, const size_t& jj){
+	return domain->getArrivalTime(ii, jj) != numeric_limits<double>::infinity();
+}
+
+void RasterPropagator::push(const size_t& ii, const size_t& jj, const double& t){
+	if ( burnt(ii, jj) ) return;
+	size_t index = ii*domain->globalBMapSizeY + jj;
+	unordered_map<size_t, double>::iterator it = tentative.find(index);
+	if ( it != tentative.end() ){
+		if ( it->second <= t ) return;
+		it->second = t;
+	} else {
+		tentative[index] = t;
+	}
+	/* older entries of the point are left in the queue and skipped */
+	BandPoint bp = {t, index};
+	band.push(bp);
+}
+
+double RasterPropagator::travelTime(const size_t& ii, const size_t& jj
+		, const int& di, const int& dj, const double& t){
+	double dx = di*domain->burningMatrixResX;
+	double dy = dj*domain->burningMatrixResY;
+	double dist = sqrt(dx*dx + dy*dy);
+	FFPoint mid(domain->SWCornerX() + (ii + 0.5 + 0.5*di)*domain->burningMatrixResX
+			, domain->SWCornerY() + (jj + 0.5 + 0.5*dj)*domain->burningMatrixResY, 0.);
+	FFVector dir(dx/dist, dy/dist, 0.);
+	probe->setTime(t);
+	probe->setLoc(mid);
+	probe->setVel(dir);
+	numEvaluations++;
+	double ros = domain->getPropagationSpeed(probe);
+	if ( !(ros > 0.) ) return numeric_limits<double>::infinity();
+	return dist/ros;
+}
+
+void RasterPropagator::ignite(FFPoint& loc, const double& t){
+	if ( !domain->striclyWithinDomain(loc) ) return;
+	size_t ii = (size_t) ((loc.getX()-domain->SWCornerX())/domain->burningMatrixResX);
+	size_t jj = (size_t) ((loc.getY()-domain->SWCornerY())/domain->burningMatrixResY);
+	if ( ii > domain->globalBMapSizeX-1 or jj > domain->globalBMapSizeY-1 ) return;
+	push(ii, jj, t);
+}
+
+void RasterPropagator::ignite(vector<vector<FFPoint> >& rings, const double& t){
+	/* indexing the rings and getting their extent on the burning map */
+	vector<PolygonIndex> indices(rings.size());
+	double xmin = numeric_limits<double>::infinity();
+	double xmax = -xmin;
+	double ymin = xmin;
+	double ymax = -xmin;
+	for ( size_t r = 0; r < rings.size(); r++ ){
+		size_t nvert = rings[r].size();
+		vector<double> vertx(nvert), verty(nvert);
+		for ( size_t v = 0; v < nvert; v++ ){
+			vertx[v] = rings[r][v].getX();
+			verty[v] = rings[r][v].getY();
+			xmin = min(xmin, vertx[v]);
+			xmax = max(xmax, vertx[v]);
+			ymin = min(ymin, verty[v]);
+			ymax = max(ymax, verty[v]);
+		}
+		if ( nvert > 0 ) indices[r].build(nvert, vertx.data(), verty.data());
+	}
+	if ( xmax < xmin ) return;
+
+	double resX = domain->burningMatrixResX;
+	double resY = domain->burningMatrixResY;
+	double x0 = domain->SWCornerX();
+	double y0 = domain->SWCornerY();
+	size_t imin = (size_t) max(0., floor((xmin - x0)/resX));
+	size_t jmin = (size_t) max(0., floor((ymin - y0)/resY));
+	size_t imax = (size_t) max(0., min((double) domain->globalBMapSizeX - 1., floor((xmax - x0)/resX)));
+	size_t jmax = (size_t) max(0., min((double) domain->globalBMapSizeY - 1., floor((ymax - y0)/resY)));
+
+	/* points inside an odd number of rings are ignited */
+	for ( size_t ii = imin; ii <= imax; ii++ ){
+		double x = x0 + (ii + 0.5)*resX;
+		for ( size_t jj = jmin; jj <= jmax; jj++ ){
+			double y = y0 + (jj + 0.5)*resY;
+			bool inside = false;
+			for ( size_t r = 0; r < indices.size(); r++ ){
+				if ( indices[r].contains(x, y) ) inside = !inside;
+			}
+			if ( inside ) push(ii, jj, t);
+		}
+	}
+}
+
+void RasterPropagator::advanceTo(const double& endTime){
+	size_t sizeY = domain->globalBMapSizeY;
+	size_t sizeX = domain->globalBMapSizeX;
+	while ( !band.empty() and band.top().time <= endTime ){
+		BandPoint bp = band.top();
+		band.pop();
+		unordered_map<size_t, double>::iterator it = tentative.find(bp.index);
+		if ( it == tentative.end() or it->second != bp.time ) continue;
+		tentative.erase(it);
+		size_t ii = bp.index/sizeY;
+		size_t jj = bp.index%sizeY;
+		domain->setArrivalTime(ii, jj, bp.time);
+		numBurnt++;
+		for ( size_t n = 0; n < 16; n++ ){
+			int di = stencil[n][0];
+			int dj = stencil[n][1];
+			if ( (di < 0 and ii < (size_t) -di) or ii + di >= sizeX ) continue;
+			if ( (dj < 0 and jj < (size_t) -dj) or jj + dj >= sizeY ) continue;
+			if ( burnt(ii + di, jj + dj) ) continue;
+			double tt = travelTime(ii, jj, di, dj, bp.time);
+			if ( tt == numeric_limits<double>::infinity() ) continue;
+			push(ii + di, jj + dj, bp.time + tt);
+		}
+	}
+}
+
+void RasterPropagator::input(){
+}
+
+void RasterPropagator::update(){
+	setTime(getUpdateTime());
+	advanceTo(getTime());
+}
+
+void RasterPropagator::timeAdvance(){
+	setUpdateTime(getTime() + timeStep);
+}
+
+void RasterPropagator::output(){
+}
+
+size_t RasterPropagator::getMemorySize(){
+	/* the queue keeps outdated entries of the points, each tentative
+	 * time being also a node of the hash map */
+	return band.size()*sizeof(BandPoint)
+			+ tentative.size()*(sizeof(pair<size_t, double>) + sizeof(void*))
+			+ tentative.bucket_count()*sizeof(void*);
+}
+
+string RasterPropagator::toString(){
+	ostringstream oss;
+	oss << "raster propagation at t=" << getTime() << ", " << numBurnt
+			<< " burnt points, " << getBandSize() << " in the band";
+	return oss.str();
+}
+
+}
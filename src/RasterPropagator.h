@@ -0,0 +1,122 @@
+/**
+ * @file RasterPropagator.h
+ * @brief Raster propagation engine advancing the arrival times directly on the burning map.
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#ifndef RASTERPROPAGATOR_H_
+#define RASTERPROPAGATOR_H_
+
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include "ForeFireAtom.h"
+#include "FFPoint.h"
+
+using namespace std;
+
+namespace libforefire {
+
+class FireDomain;
+class FireNode;
+
+/*! \class RasterPropagator
+ * \brief Narrow band minimum travel time propagation on the burning map
+ *
+ *  Alternative to the tracking of the fronts by firenodes for very
+ *  large domains ('propagationEngine' parameter set to 'raster').
+ *  The points of the burning map that are not burnt yet but
+ *  neighbour burnt ones form the narrow band, ordered by their
+ *  tentative arrival time. The earliest point of the band is
+ *  burnt, its arrival time being stored in the burning map, and
+ *  the tentative arrival times of its neighbours are lowered to
+ *  the time it would take the fire to reach them from it, as in a
+ *  fast marching scheme.
+ *
+ *  Neighbours are taken on a 16 directions stencil, the travel
+ *  time to a neighbour being its distance divided by the rate of
+ *  spread given by the registered propagation models in that
+ *  direction, evaluated at the middle of the segment with a probe
+ *  firenode whose normal is the direction of propagation. Front
+ *  depth and curvature of the probe are null. Rates of spread are
+ *  evaluated at the arrival time of the burning point.
+ *
+ *  The engine is an atom of the simulation, burning all the points
+ *  of the band with an arrival time before its update time by time
+ *  steps of 'rasterTimeStep' seconds. Arrival times do not depend
+ *  on this step, which only sets how often the burning map seen by
+ *  the flux layers and outputs is brought up to date. There are no
+ *  fronts nor topology to handle, the cost only depends on the
+ *  number of burnt points and the size of the band, at the price of
+ *  the precision of the markers and of the metric error of the
+ *  stencil, arrival times being up to 3% late in the directions
+ *  lying between those of the stencil.
+ */
+class RasterPropagator: public ForeFireAtom {
+
+	/*! \brief point of the band */
+	struct BandPoint {
+		double time; /*!< tentative arrival time */
+		size_t index; /*!< index of the point in the global burning map */
+		bool operator>(const BandPoint& b) const { return time > b.time; }
+	};
+
+	FireDomain* domain; /*!< domain of the burning map */
+	FireNode* probe; /*!< firenode used to query the propagation models */
+
+	/*! \brief band of the points to burn, earliest first */
+	priority_queue<BandPoint, vector<BandPoint>, greater<BandPoint> > band;
+	/*! \brief lowest tentative arrival time of the points of the band */
+	unordered_map<size_t, double> tentative;
+
+	double timeStep; /*!< time step of the updates of the burning map */
+	size_t numBurnt; /*!< number of points burnt by the engine */
+	size_t numEvaluations; /*!< number of rate of spread evaluations */
+
+	static const int stencil[16][2]; /*!< offsets of the neighbours */
+
+	friend class Checkpoint;
+
+	/*! \brief adding a point to the band with a tentative arrival time */
+	void push(const size_t&, const size_t&, const double&);
+	/*! \brief checking whether a point is already burnt */
+	bool burnt(const size_t&, const size_t&);
+	/*! \brief time for the fire to go from a point to one of its neighbours */
+	double travelTime(const size_t&, const size_t&, const int&, const int&, const double&);
+
+public:
+
+	/*! \brief Constructor from the domain and the starting time */
+	RasterPropagator(FireDomain*, const double&);
+	/*! \brief destructor */
+	virtual ~RasterPropagator();
+
+	/*! \brief igniting the point of the burning map at a given location */
+	void ignite(FFPoint&, const double&);
+	/*! \brief igniting the points inside a set of rings (even-odd rule) */
+	void ignite(vector<vector<FFPoint> >&, const double&);
+
+	/*! \brief burning all the points of the band up to a given time */
+	void advanceTo(const double&);
+
+	/* making the 'update()', 'timeAdvance()' and 'accept()'
+	 * virtual functions of 'ForeFireAtom' not virtual */
+	void input();
+	void update();
+	void timeAdvance();
+	void output();
+
+	size_t getBandSize(){ return tentative.size(); }
+	size_t getNumBurnt(){ return numBurnt; }
+	size_t getNumEvaluations(){ return numEvaluations; }
+	/*! \brief memory held by the band (bytes) */
+	size_t getMemorySize();
+
+	string toString();
+};
+
+}
+
+#endif /* RASTERPROPAGATOR_H_ */
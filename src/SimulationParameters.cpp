@@ -355,14 +355,27 @@ std::string landCoverIndexedCSV = R"(Index;Rhod;Rhol;Md;Ml;sd;sl;e;Sigmad;Sigmal
     parameters.insert(make_pair("ISOdate", "2012-01-01T00:00:00Z"));
     parameters.insert(make_pair("count", "0"));                      
     parameters.insert(make_pair("dumpMode", "ff")); 
+    parameters.insert(make_pair("binaryFrontQuantum", "0"));
 
 	parameters.insert(make_pair("runmode", "standalone")); 
 	parameters.insert(make_pair("MNHalt", "0")); 
+	parameters.insert(make_pair("laggedCoupling", "0"));
 
 
 	parameters.insert(make_pair("propagationModel", "Iso"));
+	parameters.insert(make_pair("propagationEngine", "lagrangian"));
+	parameters.insert(make_pair("rasterTimeStep", "10"));
 	parameters.insert(make_pair("frontScanDistance", "1000"));
 	parameters.insert(make_pair("burningTresholdFlux", "10"));
+	parameters.insert(make_pair("fluxBinningTolerance", "0"));
+	parameters.insert(make_pair("fluxBinningErrorCheck", "0"));
+	parameters.insert(make_pair("burningMapPrecision", "double"));
+	parameters.insert(make_pair("singlePrecisionLayers", ""));
+	parameters.insert(make_pair("memoryBudgetMB", "0"));
+	parameters.insert(make_pair("memoryBudgetLossy", "0"));
+	parameters.insert(make_pair("extinguishedCellsQuantum", "0"));
+	parameters.insert(make_pair("loggerBufferRows", "16384"));
+	parameters.insert(make_pair("loggerSampling", "1"));
 	parameters.insert(make_pair("normalScheme","medians"));
 	parameters.insert(make_pair("curvatureComputation", "1"));
 	parameters.insert(make_pair("curvatureScheme","circumradius"));
@@ -392,6 +405,10 @@ std::string landCoverIndexedCSV = R"(Index;Rhod;Rhol;Md;Ml;sd;sl;e;Sigmad;Sigmal
 	parameters.insert(make_pair("day", "1"));
 	parameters.insert(make_pair("DefaultSWLngLat","8.6192,41.765"));
 	parameters.insert(make_pair("perimeterResolution", "40"));
+	parameters.insert(make_pair("adaptivePerimeterResolution", "0"));
+	parameters.insert(make_pair("maxPerimeterResolution", "160"));
+	parameters.insert(make_pair("perimeterSagittaTolerance", "1"));
+	parameters.insert(make_pair("adaptiveResolutionSpeed", "0.5"));
 	parameters.insert(make_pair("spatialIncrement", "2"));
 	parameters.insert(make_pair("watchedProc", "-2"));
 	parameters.insert(make_pair("CommandOutputs", "0"));
@@ -400,6 +417,10 @@ std::string landCoverIndexedCSV = R"(Index;Rhod;Rhol;Md;Ml;sd;sl;e;Sigmad;Sigmal
 	parameters.insert(make_pair("FireNodeOutputs", "1"));
 	parameters.insert(make_pair("FDCellsOutputs", "1"));
 	parameters.insert(make_pair("HaloOutputs", "1"));
+	parameters.insert(make_pair("logLevel", "info"));
+	parameters.insert(make_pair("logLevels", ""));
+	parameters.insert(make_pair("logRateLimit", "100"));
+	parameters.insert(make_pair("logFile", ""));
 	parameters.insert(make_pair("propagationSpeedAdjustmentFactor", "1"));
 	parameters.insert(make_pair("fireOutputDirectory", "."));
 	parameters.insert(make_pair("atmoOutputDirectories", "."));
@@ -408,6 +429,16 @@ std::string landCoverIndexedCSV = R"(Index;Rhod;Rhol;Md;Ml;sd;sl;e;Sigmad;Sigmal
 	parameters.insert(make_pair("debugFronts", "0"));
 	parameters.insert(make_pair("surfaceOutputs","0"));
 	parameters.insert(make_pair("bmapOutputUpdate","0"));
+	parameters.insert(make_pair("bmapOutputMode","full"));
+	parameters.insert(make_pair("httpWorkers","4"));
+	parameters.insert(make_pair("httpSnapshotPeriod","1"));
+	parameters.insert(make_pair("httpTiles",""));
+	parameters.insert(make_pair("httpTilesColormap","turbo"));
+	parameters.insert(make_pair("lazyLayerLoading","0"));
+	parameters.insert(make_pair("lazyLayerCacheMB","256"));
+	parameters.insert(make_pair("lazyLayerTileSize","256"));
+	parameters.insert(make_pair("rasterThreads","0"));
+	parameters.insert(make_pair("ensembleWorkers","0"));
 	parameters.insert(make_pair("numAtmoIterations","1000000"));
 	parameters.insert(make_pair("numberOfAtmoStepPerParallelCom","1"));
 	parameters.insert(make_pair("MNHExchangeScalarLayersNames","plumeTopHeight,plumeBottomHeight,smokeAtGround,tke"));
@@ -421,7 +452,9 @@ std::string landCoverIndexedCSV = R"(Index;Rhod;Rhol;Md;Ml;sd;sl;e;Sigmad;Sigmal
 	
 
 	parameters.insert(make_pair("updateBinStreamFrequency","10"));
+	parameters.insert(make_pair("spottingRandomSeed","0"));
 	parameters.insert(make_pair("max_inner_front_nodes_filter","50"));
+	parameters.insert(make_pair("frontPolygonIndex","1"));
 	parameters.insert(make_pair("heatFluxDefaultModel","heatFluxBasic"));
 	parameters.insert(make_pair("vaporFluxDefaultModel","vaporFluxBasic"));
 
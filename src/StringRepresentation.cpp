@@ -47,9 +47,23 @@ StringRepresentation::StringRepresentation(FireDomain* fdom) : Visitor() {
     updateStep = SimulationParameters::GetInstance()->getDouble("outputsUpdate");
     setUpdateTime(domain->getTime());
     dumpMode = FF_MODE;  // default; will be set by dumpStringRepresentation()
+    binary = 0;
 }
 
-StringRepresentation::~StringRepresentation() { }
+StringRepresentation::~StringRepresentation() {
+    if (binary != 0)
+        delete binary;
+}
+
+bool StringRepresentation::binaryMode() {
+    return SimulationParameters::GetInstance()->getParameter("dumpMode") == "binary";
+}
+
+BinaryRepresentation* StringRepresentation::getBinaryRepresentation() {
+    if (binary == 0)
+        binary = new BinaryRepresentation(domain);
+    return binary;
+}
 
 void StringRepresentation::input() { }
 
@@ -74,6 +88,12 @@ void StringRepresentation::output() {
         return;
     writedOnce = true;
 
+    if (binaryMode()) {
+        // all output times are appended to a single stream
+        getBinaryRepresentation()->appendRecord(outPattern + ".ffb");
+        return;
+    }
+
     ostringstream oss;
     oss << outPattern << "." << getTime();
     ofstream outputfile(oss.str().c_str());
@@ -323,14 +343,21 @@ void StringRepresentation::postVisitAll(FireFront* ff) {
 void StringRepresentation::postVisitInner(FireDomain* fd) { }
 void StringRepresentation::postVisitAll(FireDomain* fd) { }
 
+string StringRepresentation::dumpFileRepresentation() {
+    if (binaryMode())
+        return getBinaryRepresentation()->dumpBinaryRepresentation();
+    return dumpStringRepresentation();
+}
+
 string StringRepresentation::dumpStringRepresentation() {
     // Set dump mode based on simulation parameters.
+    // The binary mode is only written to files, its text counterpart is geojson.
     string mode = SimulationParameters::GetInstance()->getParameter("dumpMode");
     if (mode == "json")
         dumpMode = JSON_MODE;
     else if (mode == "ff")
         dumpMode = FF_MODE;
-    else if (mode == "geojson")
+    else if (mode == "geojson" or mode == "binary")
         dumpMode = GEOJSON_MODE;
     else if (mode == "kml")
         dumpMode = KML_MODE;
@@ -10,6 +10,7 @@
 #define STRINGREPRESENTATION_H_
 
 #include "Visitor.h"
+#include "BinaryRepresentation.h"
 #include "SimulationParameters.h"
 #include "include/Futils.h"
 
@@ -22,6 +23,10 @@ class StringRepresentation: public Visitor {
 
 	double updateStep;
 
+	BinaryRepresentation* binary; /*!< encoder of the 'binary' dump mode */
+	/*! \brief checking if fronts are dumped in the binary format */
+	static bool binaryMode();
+
 public:
 
 	static ostringstream outputstr;
@@ -56,7 +61,12 @@ public:
 	void increaseLevel();
 	void decreaseLevel();
 
+	/*! \brief text representation of the fronts, geojson in the 'binary' dump mode */
 	string dumpStringRepresentation();
+	/*! \brief representation of the fronts written to files, binary in the 'binary' dump mode */
+	string dumpFileRepresentation();
+	/*! \brief binary encoder of the fronts, created on first use */
+	BinaryRepresentation* getBinaryRepresentation();
 
 	string toString();
     
@@ -0,0 +1,191 @@
+/**
+ * @file TilePyramid.cpp
+ * @brief Implements the multi-resolution pyramid of image tiles
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#include "TilePyramid.h"
+#include "Command.h"
+#include "FDCell.h"
+#include <sys/stat.h>
+#include <errno.h>
+#include <cstdio>
+
+namespace libforefire {
+
+/* zlib level of the tiles, favoring speed over size */
+static const int tileCompression = 1;
+
+/* creating a directory and its parents if needed */
+static bool makeDirectory(const string& path){
+	for ( size_t pos = 1; pos <= path.size(); pos++ ){
+		if ( pos < path.size() and path[pos] != '/' ) continue;
+		string sub = path.substr(0, pos);
+		if ( mkdir(sub.c_str(), 0755) != 0 and errno != EEXIST ) {
+			cout << "Error: unable to create directory " << sub << endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+TilePyramid::TilePyramid(FireDomain* fd, const string& dir, const string& param
+		, const string& cmap, size_t tsize, int zoom, double vmin, double vmax)
+	: domain(fd), directory(dir), parameter(param), colormap(cmap)
+	  , tileSize(tsize), requestedZoom(zoom), maxZoom(0)
+	  , minVal(vmin), maxVal(vmax), lastTime(-numeric_limits<double>::infinity()) {
+	if ( tileSize < 1 ) tileSize = 256;
+	fixedRange = !(std::isinf(minVal) and std::isinf(maxVal));
+	bmapDerived = ( parameter == "arrival_time" or parameter == "speed" );
+	setGeometry();
+}
+
+TilePyramid::~TilePyramid() {
+}
+
+bool TilePyramid::matches(FireDomain* fd, const string& param, const string& cmap
+		, size_t tsize, int zoom, double vmin, double vmax){
+	if ( fd != domain or param != parameter or cmap != colormap ) return false;
+	if ( tsize != tileSize or zoom != requestedZoom ) return false;
+	/* an automatic range is kept for the lifetime of the pyramid */
+	if ( std::isinf(vmin) and std::isinf(vmax) ) return !fixedRange;
+	return fixedRange and vmin == minVal and vmax == maxVal;
+}
+
+size_t TilePyramid::tileKey(const int& z, const size_t& x, const size_t& y){
+	return (((size_t) z) << 56) | (x << 28) | y;
+}
+
+void TilePyramid::setGeometry(){
+	FFPoint& sw = domain->getSWCorner();
+	FFPoint& ne = domain->getNECorner();
+	double width = ne.getX() - sw.getX();
+	double height = ne.getY() - sw.getY();
+	double side = max(width, height);
+
+	pixelSize = SimulationParameters::GetInstance()->getDouble("bmapResolution");
+	if ( pixelSize <= 0. or pixelSize > side ) pixelSize = side/tileSize;
+
+	/* deepest level with one pixel per burning matrix element */
+	if ( requestedZoom < 0 ) {
+		maxZoom = 0;
+		while ( maxZoom < 24 and tileSize*pixelSize*(1 << maxZoom) < side ) maxZoom++;
+	} else {
+		maxZoom = min(requestedZoom, 24);
+		pixelSize = side/(tileSize*(1 << maxZoom));
+	}
+	extent = tileSize*pixelSize*(1 << maxZoom);
+	originX = sw.getX();
+	originY = ne.getY();
+}
+
+void TilePyramid::setRange(){
+	FFRaster<float> raster;
+	size_t eni = tileSize;
+	size_t enj = tileSize;
+	FFPoint sw(originX, originY - extent, 0.);
+	FFPoint ne(originX + extent, originY, 0.);
+	if ( domain->getDataRaster(parameter, sw, ne, eni, enj, raster) ) raster.minMax(minVal, maxVal);
+	if ( minVal > maxVal ){
+		/* nothing to see yet, the range will be set at the next rendering */
+		minVal = numeric_limits<double>::infinity();
+		maxVal = numeric_limits<double>::infinity();
+	}
+}
+
+size_t TilePyramid::render(){
+
+	double now = domain->getSimulationTime();
+	/* going back in time (restart), nothing rendered can be trusted */
+	if ( now < lastTime ) rendered.clear();
+	lastTime = now;
+
+	if ( !fixedRange and std::isinf(minVal) and std::isinf(maxVal) ) {
+		setRange();
+		rendered.clear();
+	}
+
+	FFPoint& dsw = domain->getSWCorner();
+	FFPoint& dne = domain->getNECorner();
+	size_t written = 0;
+
+	for ( int z = 0; z <= maxZoom; z++ ){
+		size_t n = ((size_t) 1) << z;
+		double side = extent/n;
+		size_t nx = min(n, (size_t) ceil((dne.getX() - originX)/side));
+		size_t ny = min(n, (size_t) ceil((originY - dsw.getY())/side));
+		for ( size_t x = 0; x < nx; x++ ){
+			for ( size_t y = 0; y < ny; y++ ){
+				FFPoint sw(originX + x*side, originY - (y + 1)*side, 0.);
+				FFPoint ne(originX + (x + 1)*side, originY - y*side, 0.);
+				size_t key = tileKey(z, x, y);
+				map<size_t, size_t>::iterator done = rendered.find(key);
+				if ( done != rendered.end() ) {
+					if ( !bmapDerived ) {
+						rendered.erase(done);
+					} else {
+						/* speeds depend on the neighboring pixels */
+						FFPoint margin(pixelSize, pixelSize, 0.);
+						FFPoint swm = sw - margin;
+						FFPoint nem = ne + margin;
+						if ( domain->getBurningRevision(swm, nem) <= done->second ) continue;
+					}
+				}
+				if ( renderTile(z, x, y, sw, ne) ) written++;
+				rendered[key] = FDCell::getRevisionCounter();
+			}
+		}
+	}
+
+	writeMetadata();
+	return written;
+}
+
+bool TilePyramid::renderTile(const int& z, const size_t& x, const size_t& y
+		, FFPoint& sw, FFPoint& ne){
+	FFRaster<float> raster;
+	size_t eni = tileSize;
+	size_t enj = tileSize;
+	if ( !domain->getDataRaster(parameter, sw, ne, eni, enj, raster) ) return false;
+
+	ostringstream dir;
+	dir << directory << "/" << z << "/" << x;
+	if ( !makeDirectory(dir.str()) ) return false;
+	ostringstream path;
+	path << dir.str() << "/" << y << ".png";
+	/* tiles may be served while rendered, they are replaced at once */
+	string tmp = path.str() + ".tmp";
+	Command::writeImage(tmp.c_str(), raster, minVal, maxVal, colormap, tileCompression);
+	return rename(tmp.c_str(), path.str().c_str()) == 0;
+}
+
+void TilePyramid::writeMetadata(){
+	if ( !makeDirectory(directory) ) return;
+	string path = directory + "/tiles.json";
+	string tmp = path + ".tmp";
+	ofstream out(tmp.c_str());
+	if ( !out ) {
+		cout << "Error: unable to write " << path << endl;
+		return;
+	}
+	double east = originX + extent;
+	double south = originY - extent;
+	out << setprecision(10);
+	out << "{\"parameter\":\"" << parameter << "\""
+			<< ",\"time\":" << lastTime
+			<< ",\"tileSize\":" << tileSize
+			<< ",\"minZoom\":0"
+			<< ",\"maxZoom\":" << maxZoom
+			<< ",\"minVal\":" << minVal
+			<< ",\"maxVal\":" << maxVal
+			<< ",\"bounds\":[" << originX << "," << south << "," << east << "," << originY << "]"
+			<< ",\"boundsWSEN\":[" << domain->getLonFromX(originX) << "," << domain->getLatFromY(south)
+			<< "," << domain->getLonFromX(east) << "," << domain->getLatFromY(originY) << "]"
+			<< "}" << endl;
+	out.close();
+	rename(tmp.c_str(), path.c_str());
+}
+
+}
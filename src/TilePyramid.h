@@ -0,0 +1,94 @@
+/**
+ * @file TilePyramid.h
+ * @brief Multi-resolution pyramid of image tiles re-rendered where the fire changed.
+ * @copyright Copyright (C) 2025 ForeFire, Fire Team, SPE, CNRS/Universita di Corsica.
+ * @license This program is free software; See LICENSE file for details. (See LICENSE file).
+ * @author Jean‑Baptiste Filippi — 2025
+ */
+
+#ifndef TILEPYRAMID_H_
+#define TILEPYRAMID_H_
+
+#include "FFPoint.h"
+#include "include/Futils.h"
+
+using namespace std;
+
+namespace libforefire {
+
+class FireDomain;
+
+/*! \class TilePyramid
+ * \brief XYZ-style tiles of a field at several zoom levels
+ *
+ *  The pyramid covers a square anchored at the north-west corner
+ *  of the domain. Zoom level 'z' is made of 2^z x 2^z tiles of
+ *  'tileSize' pixels, the deepest level being at the resolution
+ *  of the burning matrix, and tiles are written as
+ *  'directory/z/x/y.png' with 'y' counted from the north.
+ *  Tiles entirely outside of the domain are not written.
+ *
+ *  For fields derived from the burning matrix ('arrival_time'
+ *  and 'speed') the pyramid remembers, for each tile, the change
+ *  counter of the burning maps (see FDCell::touch) when it was
+ *  rendered: only tiles covering cells that changed since, and
+ *  thereby their ancestors, are rendered again. Other fields are
+ *  rendered completely at each call. Tiles are sampled directly
+ *  at their own resolution and written with a fast PNG compression.
+ */
+class TilePyramid {
+
+	FireDomain* domain; /*!< domain the tiles were rendered for */
+	string directory; /*!< root directory of the tiles */
+	string parameter; /*!< name of the rendered field */
+	string colormap; /*!< name of the colormap */
+	size_t tileSize; /*!< number of pixels on the side of a tile */
+	int requestedZoom; /*!< maximum zoom level asked for, -1 for automatic */
+	int maxZoom; /*!< deepest zoom level */
+	double minVal; /*!< value of the first color of the colormap */
+	double maxVal; /*!< value of the last color of the colormap */
+	bool fixedRange; /*!< range given by the user */
+	bool bmapDerived; /*!< field only depending on the burning matrix */
+
+	double originX; /*!< x coordinate of the north-west corner */
+	double originY; /*!< y coordinate of the north-west corner */
+	double extent; /*!< side of the square covered by the pyramid */
+	double pixelSize; /*!< size of a pixel at the deepest level */
+
+	map<size_t, size_t> rendered; /*!< change counter of each tile at rendering */
+	double lastTime; /*!< simulation time of the last rendering */
+
+	/*! \brief unique key of a tile */
+	static size_t tileKey(const int&, const size_t&, const size_t&);
+	/*! \brief setting the geometry of the pyramid from the domain */
+	void setGeometry();
+	/*! \brief setting the color range from the whole field */
+	void setRange();
+	/*! \brief rendering one tile into its file */
+	bool renderTile(const int&, const size_t&, const size_t&, FFPoint&, FFPoint&);
+	/*! \brief writing the description of the pyramid */
+	void writeMetadata();
+
+public:
+
+	/*! \brief Constructor from the domain, the directory, the field, the colormap,
+	 * the size of tiles, the maximum zoom (-1 for automatic) and the color range
+	 * (infinite bounds for automatic) */
+	TilePyramid(FireDomain*, const string&, const string&, const string&
+			, size_t, int, double, double);
+	/*! \brief destructor */
+	~TilePyramid();
+
+	/*! \brief checking if the pyramid renders the given settings */
+	bool matches(FireDomain*, const string&, const string&, size_t, int, double, double);
+
+	/*! \brief rendering the tiles that changed, returns their number */
+	size_t render();
+
+	int getMaxZoom(){ return maxZoom; }
+
+};
+
+}
+
+#endif /* TILEPYRAMID_H_ */
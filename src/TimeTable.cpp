@@ -64,14 +64,20 @@ size_t TimeTable::size(){
 	return incr-decr;
 }
 
+size_t TimeTable::getMemorySize(){
+	/* the events are chained in a list, their links being part of the events */
+	return size()*sizeof(FFEvent);
+}
+
 FFEvent* TimeTable::getUpcomingEvent(){
 	FFEvent* upEvent = head;
 	if ( size() > 1 ) {
 		setHead(head->getNext());
 		decrement();
 	} else if ( size() == 1 ) {
-		// this is the only event left
+		// this is the only event left, the table no longer owns it
 		decrement();
+		head = nullptr;
 	} else {
 		// no events left to be treated (size=0)
 		//cout << "ForeFire simulation ended with no more event to be treated" << endl;
@@ -116,6 +122,52 @@ void TimeTable::insertBefore(FFEvent* newEv){
 	increment();
 }
 
+void TimeTable::insertBefore(vector<FFEvent*>& newEvs){
+	if ( newEvs.empty() ) return;
+	double evTime = newEvs[0]->getTime();
+	for ( size_t i = 1; i < newEvs.size(); i++ ){
+		if ( newEvs[i]->getTime() != evTime ){
+			// not a single time, inserting the events one by one
+			for ( size_t k = 0; k < newEvs.size(); k++ ) insertBefore(newEvs[k]);
+			return;
+		}
+	}
+	if ( evTime < 0. ){
+		// deleting the events
+		for ( size_t k = 0; k < newEvs.size(); k++ ) delete newEvs[k];
+		return;
+	}
+	// chaining the events, the last one first as successive
+	// calls to 'insertBefore()' would do
+	FFEvent* first = newEvs.back();
+	FFEvent* last = newEvs.front();
+	for ( size_t i = newEvs.size() - 1; i > 0; i-- ){
+		newEvs[i]->setNext(newEvs[i-1]);
+		newEvs[i-1]->setPrev(newEvs[i]);
+	}
+	if ( size() == 0 ) {
+		head = first;
+		first->setPrev(last);
+		last->setNext(first);
+	} else {
+		// searching the time of insertion only once
+		FFEvent* tmpEv = head;
+		bool newHead = ( evTime < head->getTime() + EPSILONT );
+		if ( !newHead and evTime <= head->getPrev()->getTime() ){
+			while ( evTime > tmpEv->getTime() + EPSILONT ){
+				tmpEv = tmpEv->getNext();
+			}
+		}
+		FFEvent* prevEv = tmpEv->getPrev();
+		prevEv->setNext(first);
+		first->setPrev(prevEv);
+		last->setNext(tmpEv);
+		tmpEv->setPrev(last);
+		if ( newHead ) head = first;
+	}
+	incr += newEvs.size();
+}
+
 void TimeTable::insert(FFEvent* newEv){
 	// checking the event consistency
 	double evTime = newEv->getTime();
@@ -185,6 +237,19 @@ void TimeTable::dropAtomEvents(ForeFireAtom* atom){
 	}
 }
 
+void TimeTable::dropAtomEvents(const set<ForeFireAtom*>& atoms){
+	// removing possible events at head
+	while ( head != 0 and atoms.count(head->getAtom()) > 0 ) dropEvent(head);
+	if ( !head ) return;
+	FFEvent* tmpEvNext;
+	FFEvent* tmpEv = head->getNext();
+	while ( tmpEv != head ) {
+		tmpEvNext = tmpEv->getNext();
+		if ( atoms.count(tmpEv->getAtom()) > 0 ) dropEvent(tmpEv);
+		tmpEv = tmpEvNext;
+	}
+}
+
 string TimeTable::print(){
 	if ( !head ) return "";
 	ostringstream oss;
@@ -72,6 +72,9 @@ public:
     FFEvent* getHead();
     /*! \brief Inserting a new event before the head */
     void insertBefore(FFEvent*);
+    /*! \brief Inserting new events of the same time at once, in the
+     *  order of successive calls to 'insertBefore(FFEvent*)' */
+    void insertBefore(vector<FFEvent*>&);
     /*! \brief Inserting a new event according to its time of activation */
     void insert(FFEvent*);
     /*! \brief Removing an event */
@@ -81,10 +84,15 @@ public:
     /*! \brief Removing all the events associated to a ForeFireAtom */
 
     void dropAtomEvents(ForeFireAtom*);
+    /*! \brief Removing all the events associated to a set of ForeFireAtoms, in one pass */
+    void dropAtomEvents(const set<ForeFireAtom*>&);
 
     /*! \brief Getting the current time of the timetable */
     double getTime();
 
+    /*! \brief Memory held by the scheduled events (bytes) */
+    size_t getMemorySize();
+
     /*! \brief Printing the timetable */
     string print();
 };
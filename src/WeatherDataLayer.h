@@ -203,6 +203,8 @@ public:
 
 	/*! \brief getter to the desired array at surface for a given time (should not be used) */
 	void getMatrix(FFArray<T>**, const double&);
+	/*! \brief memory held by the layer (bytes) */
+	size_t getMemorySize(){ return this->arrayMemory(array); }
 	/*! \brief stores array from a given array (should not be used) */
 	void setMatrix(string&, double*, const size_t&, size_t&, const double&);
 
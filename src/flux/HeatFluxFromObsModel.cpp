@@ -9,6 +9,7 @@
 #include "../FluxModel.h"
 #include "../FireDomain.h"
 #include "FromObsModels.h"
+#include "../Logger.h"
 using namespace std;
 
 namespace libforefire {
@@ -176,10 +177,10 @@ double HeatFluxFromObsModel::getValue(double* valueOf
     double nominalHeatFlux_s = valueOf[nominalHeatFlux_s_data];
     SensibleheatFlux sensibleheatFlux = computeHeatFLuxFromBmap(burningTime,residenceTime,nominalHeatFlux_f,nominalHeatFlux_s,bt,et,at+evaporationTime);
 if (at >= 0)
-cout << "formObs " << et << ' ' << bt << ' ' << at << ' ' << "  -  "
+FF_TRACE(model, "formObs " << et << ' ' << bt << ' ' << at << ' ' << "  -  "
              <<                     burningTime/500 << '|' << residenceTime
              << ' ' << nominalHeatFlux_f/1.8e6        << '|' <<nominalHeatFlux_s << ' '
-             << ' ' << sensibleheatFlux.flaming << '|' <<  sensibleheatFlux.smoldering << endl;
+             << ' ' << sensibleheatFlux.flaming << '|' <<  sensibleheatFlux.smoldering);
 return sensibleheatFlux.flaming + sensibleheatFlux.smoldering ;
 }
 
@@ -8,10 +8,10 @@
 
 #include "../PropagationModel.h"
 #include "../FireDomain.h"
+#include "../ColumnLogger.h"
 #include <vector>
 #include <cmath>
 #include <iostream>
-#include <fstream>
 
 #include "ANN.h"  // Include the ANN definitions
 
@@ -22,7 +22,7 @@ class BMapLoggerForANNTraining: public PropagationModel {
     static int isInitialized;
 
     Network annNetwork; // Neural network instance for the model
-    std::ofstream csvfile;
+    ColumnLogger* logger; // Buffered sink of the logged rows
 public:
     BMapLoggerForANNTraining(const int& = 0, DataBroker* db = nullptr);
     virtual ~BMapLoggerForANNTraining();
@@ -60,20 +60,19 @@ BMapLoggerForANNTraining::BMapLoggerForANNTraining(const int & mindex, DataBroke
     maxSpeed = params->getDouble("maxSpeed");
     
     annNetwork.loadFromFile(annPath.c_str());
-    csvfile.open(csvPath); 
     properties = new double[annNetwork.inputNames.size() + 1];
-    csvfile << "ROS";
+    std::vector<std::string> columns(1, "ROS");
     registerProperty("arrival_time_gradient");
 
     std::cout << "Props: ";
     for (const auto& inputName : annNetwork.inputNames) {
-        csvfile << ";"<< inputName ;
+        columns.push_back(inputName);
         size_t ni = registerProperty(inputName);
         std::cout<<ni<<":"<< inputName<<" ;";
     }
     std::cout << std::endl;
     
-    csvfile << std::endl;
+    logger = new ColumnLogger(csvPath, columns);
     dataBroker->registerPropagationModel(this);
 }
 
@@ -82,9 +81,7 @@ BMapLoggerForANNTraining::~BMapLoggerForANNTraining() {
     if (properties) {
         delete[] properties;
     }
-        if (csvfile.is_open()) {
-        csvfile.close();
-    }
+    delete logger;
 }
 
 /* accessor to the name of the model */
@@ -103,11 +100,7 @@ double BMapLoggerForANNTraining::getSpeed(double* valueOf) {
     if (RosVal > maxSpeed){
        RosVal = maxSpeed;
     }
-    csvfile << RosVal << ";";   
-    for (size_t i = 0; i < annNetwork.inputNames.size()-1; ++i) {
-        csvfile << valueOf[i+1] << ";";
-    }
-    csvfile<<valueOf[annNetwork.inputNames.size()] << std::endl;
+    if (logger->sampled()) logger->append(&RosVal, 1, valueOf + 1);
  
     return RosVal;
 }
@@ -8,6 +8,7 @@
 
 #include "../PropagationModel.h"
 #include "../FireDomain.h"
+#include "../ColumnLogger.h"
 #include <cstring>
 #include <cmath>
 
@@ -52,7 +53,7 @@ namespace libforefire
 		size_t idx_heatl;
 
 		/*! local variables */
-		std::ofstream csvfile;
+		ColumnLogger* logger;
 		/*! result of the model */
 		double getSpeed(double *);
 
@@ -119,26 +120,17 @@ namespace libforefire
 			adjustementWind = params->getDouble("Farsite.adjustementWind");
 
 
+		logger = 0;
 		if (params->isValued("FarsiteLoggerCSVPath")) {
-			csvfile.open(params->getParameter("FarsiteLoggerCSVPath"));
 			std::cout<< "logging Farsite data in "<<params->getParameter("FarsiteLoggerCSVPath")<<std::endl;
-		}
-		
-		if (csvfile.is_open()) {
-			
-			csvfile << "ROS;rateo;phiew";
+			std::vector<std::string> columns = {"ROS", "rateo", "phiew"};
 			std::cout << "Props: ";
 			for (const auto& inputName : wantedProperties) {
-				csvfile << ";" << inputName;
+				columns.push_back(inputName);
 				std::cout << inputName << " ";
 			}
 			std::cout << std::endl;
-	
-			
-			csvfile << std::endl;
-	
-			
-			
+			logger = new ColumnLogger(params->getParameter("FarsiteLoggerCSVPath"), columns);
 		} 
 
 
@@ -149,6 +141,7 @@ namespace libforefire
 	/* destructor (shoudn't be modified) */
 	Farsite::~Farsite()
 	{
+		delete logger;
 	}
 
 	/* accessor to the name of the model */
@@ -475,12 +468,9 @@ namespace libforefire
 
 		rate_of_spread = rate_of_spread/60.0;
 
-		if (csvfile.is_open()) {
-			csvfile << rate_of_spread<<";"<<rateo/60.0 <<";"<<phiew;   
-			for (size_t i = 0; i < wantedProperties.size(); ++i) {
-				csvfile << ";" << valueOf[i] ;
-			}
-			csvfile << std::endl;
+		if (logger and logger->sampled()) {
+			double lead[3] = {rate_of_spread, rateo/60.0, phiew};
+			logger->append(lead, 3, valueOf);
 		}
 		return rate_of_spread; // eventually in m/s
 	}
@@ -8,6 +8,7 @@
 
 #include "../PropagationModel.h"
 #include "../FireDomain.h"
+#include "../ColumnLogger.h"
 #include <math.h>
 using namespace std;
 namespace libforefire {
@@ -49,7 +50,7 @@ class Rothermel: public PropagationModel {
 	/*! coefficients needed by the model */
 
 	/*! local variables */
-	std::ofstream csvfile;
+	ColumnLogger* logger;
 	/*! result of the model */
 	double getSpeed(double*);
 
@@ -110,32 +111,24 @@ Rothermel::Rothermel(const int & mindex, DataBroker* db)
 	if ( numProperties > 0 ) properties =  new double[numProperties];
 	dataBroker->registerPropagationModel(this);
 	/* registering the model in the data broker */
+    logger = 0;
     if (params->isValued("RothermelLoggerCSVPath")) {
-        csvfile.open(params->getParameter("RothermelLoggerCSVPath"));
 		std::cout<< "logging Rothermel data in "<<params->getParameter("RothermelLoggerCSVPath")<<std::endl;
-    }
-    
-    if (csvfile.is_open()) {
-     
-        csvfile << "ROS";
+        std::vector<std::string> columns(1, "ROS");
         std::cout << "Props: ";
         for (const auto& inputName : wantedProperties) {
-            csvfile << ";" << inputName;
+            columns.push_back(inputName);
             std::cout << inputName << " ";
         }
         std::cout << std::endl;
-
-        
-        csvfile << std::endl;
-
-       
-      
+        logger = new ColumnLogger(params->getParameter("RothermelLoggerCSVPath"), columns);
     } 
 	/* Definition of the coefficients */
 }
 
 /* destructor (shoudn't be modified) */
 Rothermel::~Rothermel() {
+	delete logger;
 }
 
 /* accessor to the name of the model */
@@ -242,13 +235,7 @@ double Rothermel::getSpeed(double* valueOf){
    
 
 
-    if (csvfile.is_open()) {
-        csvfile << R ;   
-        for (size_t i = 0; i < wantedProperties.size(); ++i) {
-            csvfile << ";" << valueOf[i] ;
-        }
-        csvfile << std::endl;
-    }
+    if (logger and logger->sampled()) logger->append(&R, 1, valueOf);
 
 	return R;
 }
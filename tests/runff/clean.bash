@@ -1,2 +1 @@
-rm -f *.kml *json to_reload.ff ForeFire.0.nc
-
+rm -f *.kml *json to_reload.ff ForeFire.0.nc checkpoint*.ffck checkpoint_ref.* checkpoint_restart.* checkpoint_raster_ref.* checkpoint_raster_restart.* series_case.0.* series_full.* series_rebuilt.* binary_fronts.ffb binary_fronts.out polygon_indexed.* polygon_scan.* depth_normal.ff depth_residence.ff adaptive_fronts.* uniform_fronts.* precision_double.* precision_float.* extinguished.* extinguished_ref.* http_commands.fifo http_server.out httpConnectInfo.txt
\ No newline at end of file
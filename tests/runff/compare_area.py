@@ -0,0 +1,47 @@
+# tests/runff/compare_area.py
+import sys
+import numpy as np
+import xarray as xr
+
+# --- Configuration ---
+# Relative difference allowed between the burnt areas of both runs
+AREA_TOLERANCE = 0.02
+VARIABLE = "arrival_time_of_front"
+# ---
+
+def arrival_times(path):
+    """Arrival time map, with NaN at the points not reached by the fire (-9999 or inf)."""
+    with xr.open_dataset(path, cache=False) as ds:
+        atime = np.asarray(ds[VARIABLE].values, dtype=np.float64)
+    atime[~(np.isfinite(atime) & (atime >= 0))] = np.nan
+    return atime
+
+if __name__ == "__main__":
+    if len(sys.argv) not in (3, 4):
+        print("Usage: python compare_area.py <generated_nc_file> <reference_nc_file> [max_mean_difference_s]", file=sys.stderr)
+        sys.exit(2) # Exit code for usage error
+
+    try:
+        atime = arrival_times(sys.argv[1])
+        ref_atime = arrival_times(sys.argv[2])
+    except Exception as e:
+        print(f"An unexpected error occurred while reading the arrival times: {e}", file=sys.stderr)
+        sys.exit(1)
+
+    generated = int(np.count_nonzero(~np.isnan(atime)))
+    reference = int(np.count_nonzero(~np.isnan(ref_atime)))
+    if atime.shape != ref_atime.shape or reference == 0 or abs(generated - reference) > AREA_TOLERANCE*reference:
+        print(f"Burnt areas differ: {generated} vs {reference} points.", file=sys.stderr)
+        sys.exit(1)
+
+    # optionally, arrival times of the points burnt in both runs
+    if len(sys.argv) == 4:
+        both = ~np.isnan(atime) & ~np.isnan(ref_atime)
+        mean_difference = float(np.mean(np.abs(atime[both] - ref_atime[both])))
+        if mean_difference > float(sys.argv[3]):
+            print(f"Arrival times differ on average by {mean_difference:.3f} s.", file=sys.stderr)
+            sys.exit(1)
+        print(f"Mean arrival time difference {mean_difference:.3f} s.")
+
+    print(f"Burnt area of {sys.argv[1]} matches {sys.argv[2]} ({generated} vs {reference} points).")
+    sys.exit(0)
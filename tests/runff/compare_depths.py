@@ -0,0 +1,57 @@
+# tests/runff/compare_depths.py
+import re
+import sys
+
+# --- Configuration ---
+# Both schemes locate the same interface, 'normalDir' marching by steps
+# of a tenth of the front depth before refining to the burning map resolution
+RELATIVE_TOLERANCE = 0.15
+ABSOLUTE_TOLERANCE = 5.0 # meters, a few burning map resolutions
+MEAN_RELATIVE_TOLERANCE = 0.1
+# ---
+
+NODE = re.compile(r"FireNode\[domain=\d+;id=(\d+);fdepth=([^;]+);kappa=[^;]+;loc=(\([^)]*\))")
+
+def read_nodes(path):
+    """Returns the front depth and location of each firenode of a 'ff' dump, by id."""
+    nodes = {}
+    with open(path) as f:
+        for line in f:
+            m = NODE.search(line)
+            if m:
+                nodes[m.group(1)] = (float(m.group(2)), m.group(3))
+    return nodes
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print("Usage: python compare_depths.py <generated_ff_file> <reference_ff_file>", file=sys.stderr)
+        sys.exit(2) # Exit code for usage error
+
+    generated = read_nodes(sys.argv[1])
+    reference = read_nodes(sys.argv[2])
+
+    if not reference or generated.keys() != reference.keys():
+        print(f"Firenodes differ: {len(generated)} vs {len(reference)} nodes", file=sys.stderr)
+        sys.exit(1)
+
+    total = 0.
+    total_ref = 0.
+    for node_id, (depth, loc) in generated.items():
+        ref_depth, ref_loc = reference[node_id]
+        if loc != ref_loc:
+            print(f"Firenode {node_id} moved differently: {loc} vs {ref_loc}", file=sys.stderr)
+            sys.exit(1)
+        if abs(depth - ref_depth) > RELATIVE_TOLERANCE*ref_depth + ABSOLUTE_TOLERANCE:
+            print(f"Front depths of firenode {node_id} differ: {depth} vs {ref_depth}", file=sys.stderr)
+            sys.exit(1)
+        total += abs(depth - ref_depth)
+        total_ref += ref_depth
+
+    if total > MEAN_RELATIVE_TOLERANCE*total_ref:
+        print(f"Front depths differ on average by {total/len(reference):.3f} m "
+              f"(mean depth {total_ref/len(reference):.3f} m)", file=sys.stderr)
+        sys.exit(1)
+
+    print(f"Front depths of {sys.argv[1]} match {sys.argv[2]} "
+          f"(mean difference {total/len(reference):.3f} m).")
+    sys.exit(0)
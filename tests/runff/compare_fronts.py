@@ -0,0 +1,58 @@
+# tests/runff/compare_fronts.py
+import sys
+import json
+import importlib.util
+
+# --- Configuration ---
+# GeoJSON coordinates are written with 5 decimals (about a meter)
+DEGREE_TOLERANCE = 2e-5
+HELPERS_PATH = "../../bindings/python/src/pyforefire/helpers.py"
+# ---
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print("Usage: python compare_fronts.py <binary_fronts_file> <reference_geojson_file>", file=sys.stderr)
+        sys.exit(2) # Exit code for usage error
+
+    # loading the decoder without the compiled extension of the package
+    spec = importlib.util.spec_from_file_location("helpers", HELPERS_PATH)
+    helpers = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(helpers)
+
+    try:
+        header, records = helpers.read_binary_fronts(sys.argv[1])
+        with open(sys.argv[2]) as f:
+            reference = json.load(f)
+    except Exception as e:
+        print(f"Error reading fronts: {e}", file=sys.stderr)
+        sys.exit(1)
+
+    if len(records) != 1:
+        print(f"Expected one record in {sys.argv[1]}, found {len(records)}.", file=sys.stderr)
+        sys.exit(1)
+    decoded = helpers.binary_fronts_to_geojson(header, records[0])
+
+    if decoded["valid_at"] != reference["valid_at"]:
+        print(f"Dates differ: {decoded['valid_at']} vs {reference['valid_at']}", file=sys.stderr)
+        sys.exit(1)
+    if len(decoded["features"]) != len(reference["features"]):
+        print(f"Number of fronts differ: {len(decoded['features'])} vs {len(reference['features'])}", file=sys.stderr)
+        sys.exit(1)
+
+    for feature, ref_feature in zip(decoded["features"], reference["features"]):
+        rings = feature["geometry"]["coordinates"][0]
+        ref_rings = ref_feature["geometry"]["coordinates"][0]
+        if len(rings) != len(ref_rings):
+            print(f"Number of rings differ: {len(rings)} vs {len(ref_rings)}", file=sys.stderr)
+            sys.exit(1)
+        for ring, ref_ring in zip(rings, ref_rings):
+            if len(ring) != len(ref_ring):
+                print(f"Number of nodes differ: {len(ring)} vs {len(ref_ring)}", file=sys.stderr)
+                sys.exit(1)
+            for p, q in zip(ring, ref_ring):
+                if abs(p[0] - q[0]) > DEGREE_TOLERANCE or abs(p[1] - q[1]) > DEGREE_TOLERANCE:
+                    print(f"Nodes differ: {p} vs {q}", file=sys.stderr)
+                    sys.exit(1)
+
+    print(f"Decoded fronts of {sys.argv[1]} match {sys.argv[2]}.")
+    sys.exit(0)
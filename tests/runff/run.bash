@@ -31,4 +31,141 @@ if [ "$actual_size" -lt "$min_size" ]; then
     exit 1
 fi
 
+# Checkpoint and restart: the restarted run has to continue exactly
+# as the uninterrupted one, for the fronts and the arrival times
+../../bin/forefire -i checkpoint_case.ff
+../../bin/forefire -i restart_case.ff
+if ! cmp -s checkpoint_ref.ff checkpoint_restart.ff; then
+    echo "Fronts of the restarted run differ from the uninterrupted run."
+    exit 1
+fi
+if ! python3 compare_nc.py checkpoint_restart.0.nc checkpoint_ref.0.nc; then
+    echo "Arrival times of the restarted run differ from the uninterrupted run."
+    exit 1
+fi
+../../bin/forefire -i raster_checkpoint_case.ff
+../../bin/forefire -i raster_restart_case.ff
+if ! python3 compare_nc.py checkpoint_raster_restart.0.nc checkpoint_raster_ref.0.nc; then
+    echo "Arrival times of the restarted raster run differ from the uninterrupted run."
+    exit 1
+fi
+
+# Arrival time series: the map rebuilt from the base snapshot and the
+# changed tiles has to match the full map written at the same time
+../../bin/forefire -i series_case.ff
+if ! python3 ../../tools/postprocessing/atimeSeries.py series_case.0.series.nc --output series_rebuilt.0.nc; then
+    echo "Arrival time series could not be read."
+    exit 1
+fi
+if ! python3 compare_nc.py series_rebuilt.0.nc series_full.0.nc; then
+    echo "Arrival times rebuilt from the series differ from the full output."
+    exit 1
+fi
+
+# Binary fronts: the decoded stream has to match the geojson output,
+# and print[] on the console stays in text in the binary mode
+../../bin/forefire -i binary_fronts.ff > binary_fronts.out
+if ! grep -q FeatureCollection binary_fronts.out || grep -q FFFRONTS binary_fronts.out; then
+    echo "Console output of the binary mode is not geojson."
+    exit 1
+fi
+if ! python3 compare_fronts.py binary_fronts.ffb binary_fronts.geojson; then
+    echo "Decoded binary fronts differ from the geojson output."
+    exit 1
+fi
+
+# Polygon index: the indexed burning checks have to give the same
+# fronts and arrival times as walking all the vertices of the fronts
+../../bin/forefire -i polygon_index_case.ff
+../../bin/forefire -i polygon_scan_case.ff
+if ! cmp -s polygon_indexed.ff polygon_scan.ff; then
+    echo "Fronts with the polygon index differ from the vertex walk."
+    exit 1
+fi
+if ! python3 compare_nc.py polygon_indexed.0.nc polygon_scan.0.nc; then
+    echo "Arrival times with the polygon index differ from the vertex walk."
+    exit 1
+fi
+
+# Front depths: the residence time scheme has to find the same burning
+# interface as the march along the normals, within the march steps
+../../bin/forefire -i depth_normal_case.ff
+../../bin/forefire -i depth_residence_case.ff
+if ! python3 compare_depths.py depth_residence.ff depth_normal.ff; then
+    echo "Front depths of the residenceTime scheme differ from normalDir."
+    exit 1
+fi
+
+# Adaptive perimeter resolution: fewer firenodes than the uniform
+# resolution, for the same burnt area
+../../bin/forefire -i adaptive_case.ff
+../../bin/forefire -i uniform_case.ff
+adaptive_nodes=$(grep -c FireNode adaptive_fronts.ff)
+uniform_nodes=$(grep -c FireNode uniform_fronts.ff)
+if [ "$adaptive_nodes" -ge "$uniform_nodes" ]; then
+    echo "Adaptive resolution uses ${adaptive_nodes} firenodes (uniform: ${uniform_nodes})."
+    exit 1
+fi
+if ! python3 compare_area.py adaptive_fronts.0.nc uniform_fronts.0.nc; then
+    echo "Burnt area with the adaptive resolution differs from the uniform resolution."
+    exit 1
+fi
+
+# Single precision storage: layers and burning maps kept as floats have
+# to give the arrival times of the double precision run within tolerance
+../../bin/forefire -i precision_double_case.ff > precision_double.out
+../../bin/forefire -i precision_float_case.ff > precision_float.out
+if ! python3 compare_area.py precision_float.0.nc precision_double.0.nc 1.0; then
+    echo "Arrival times with single precision storage deviate from double precision."
+    exit 1
+fi
+# and the float storage has to be in use, as reported by memory[]
+for item in burningMaps layers; do
+    double_mb=$(awk -v item=$item '$1 == item { sub("MB", "", $2); print $2 }' precision_double.out)
+    float_mb=$(awk -v item=$item '$1 == item { sub("MB", "", $2); print $2 }' precision_float.out)
+    if ! awk -v f="$float_mb" -v d="$double_mb" 'BEGIN { exit !(d > 0 && f < 0.75*d) }'; then
+        echo "Single precision ${item} use ${float_mb}MB (double precision: ${double_mb}MB)."
+        exit 1
+    fi
+done
+
+# Extinguished cells: burning maps compressed once burnt for longer than
+# the residence time have to give the arrival times within one quantum
+../../bin/forefire -i extinguished_ref_case.ff > extinguished_ref.out
+../../bin/forefire -i extinguished_case.ff > extinguished.out
+if ! python3 compare_area.py extinguished.0.nc extinguished_ref.0.nc 1.0; then
+    echo "Arrival times of the compressed burning maps deviate from the uncompressed run."
+    exit 1
+fi
+# and cells have to be compressed, as reported by compressedCells and memory[]
+compressed_cells=$(tail -n 1 extinguished.out | tr -d '[:space:]')
+if ! [ "$compressed_cells" -gt 0 ] 2> /dev/null; then
+    echo "No burning map was compressed (compressedCells: '${compressed_cells}')."
+    exit 1
+fi
+ref_mb=$(awk '$1 == "burningMaps" { sub("MB", "", $2); print $2 }' extinguished_ref.out)
+compressed_mb=$(awk '$1 == "burningMaps" { sub("MB", "", $2); print $2 }' extinguished.out)
+if ! awk -v c="$compressed_mb" -v r="$ref_mb" 'BEGIN { exit !(r > 0 && c < r) }'; then
+    echo "Compressed burning maps use ${compressed_mb}MB (uncompressed: ${ref_mb}MB)."
+    exit 1
+fi
+
+# HTTP commands: the reply of a command carries its error messages
+if command -v curl > /dev/null; then
+    rm -f http_commands.fifo
+    mkfifo http_commands.fifo
+    ../../bin/forefire -i http_commands.fifo > http_server.out 2>&1 &
+    server=$!
+    exec 3> http_commands.fifo
+    echo "listenHTTP[localhost:8765]" >&3
+    reply=$(curl -sg --retry 10 --retry-connrefused --retry-delay 1 "http://localhost:8765/ff:getParameter[noSuchParameter]")
+    exec 3>&-
+    kill $server 2> /dev/null
+    wait $server 2> /dev/null
+    if [[ "$reply" != *"doesn't exist"* ]]; then
+        echo "HTTP reply to an erroneous command has no error message: '${reply}'."
+        exit 1
+    fi
+fi
+
 exit 0
\ No newline at end of file
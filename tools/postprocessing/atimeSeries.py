@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""
+Reader of the 'series' burning map outputs (bmapOutputMode=series).
+
+The series file holds a base snapshot of the arrival time map and,
+for each output time, the burning map tiles that changed since the
+previous output. This script lists the recorded times, or rebuilds
+the full arrival time map at a given time and writes it as a regular
+ForeFire arrival time NetCDF file (same layout as bmapOutputMode=full).
+
+    python atimeSeries.py ForeFire.0.series.nc --list
+    python atimeSeries.py ForeFire.0.series.nc --time 3600 --output atime3600.nc
+"""
+
+import numpy as np
+from netCDF4 import Dataset
+
+
+def record_times(path):
+    """Times of the records of a series file."""
+    with Dataset(path) as ds:
+        return np.array(ds.variables["time"][:])
+
+
+def reconstruct(path, time):
+    """Arrival time map (y, x) at the last record before 'time', and the time of that record."""
+    with Dataset(path) as ds:
+        atime = np.array(ds.variables["arrival_time_of_front"][:], dtype=np.float64)
+        times = np.array(ds.variables["time"][:])
+        if times.size == 0:
+            return atime, float(ds.variables["arrival_time_of_front"].time)
+        last = max(0, int(np.searchsorted(times, time, side="right")) - 1)
+        first = np.array(ds.variables["first_tile"][:last + 1])
+        count = np.array(ds.variables["num_tiles"][:last + 1])
+        ntiles = int(first[last] + count[last])
+        if ntiles == 0:
+            return atime, float(times[last])
+        tile_i = np.array(ds.variables["tile_i"][:ntiles])
+        tile_j = np.array(ds.variables["tile_j"][:ntiles])
+        ty = len(ds.dimensions["tile_y"])
+        tx = len(ds.dimensions["tile_x"])
+        ny, nx = atime.shape
+        data = ds.variables["tile_data"]
+        # records are applied in order, later tiles overwriting earlier ones
+        for r in range(1, last + 1):
+            if count[r] == 0:
+                continue
+            tiles = np.array(data[first[r]:first[r] + count[r]])
+            for t in range(count[r]):
+                i0 = tile_i[first[r] + t] * tx
+                j0 = tile_j[first[r] + t] * ty
+                h = min(ty, ny - j0)
+                w = min(tx, nx - i0)
+                atime[j0:j0 + h, i0:i0 + w] = tiles[t, :h, :w]
+        return atime, float(times[last])
+
+
+def write_full(path, series_path, atime):
+    """Writes a rebuilt map as a regular arrival time file."""
+    with Dataset(series_path) as src, Dataset(path, "w") as dst:
+        ny, nx = atime.shape
+        dst.createDimension("DIMX", nx)
+        dst.createDimension("DIMY", ny)
+        var = dst.createVariable("arrival_time_of_front", "f8", ("DIMY", "DIMX"), zlib=True, complevel=6, shuffle=True)
+        var[:] = atime
+        dst.createDimension("domdim", 1)
+        dom = dst.createVariable("domain", "S1", ("domdim",))
+        sdom = src.variables["domain"]
+        for att in sdom.ncattrs():
+            dom.setncattr(att, sdom.getncattr(att))
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Rebuilds arrival time maps from a ForeFire series output")
+    parser.add_argument("series", help="series file (<experiment>.<domainID>.series.nc)")
+    parser.add_argument("--list", action="store_true", help="list the recorded times")
+    parser.add_argument("--time", type=float, default=np.inf, help="time of the map to rebuild (default: last record)")
+    parser.add_argument("--output", help="arrival time NetCDF file to write")
+    args = parser.parse_args()
+
+    if args.list:
+        for t in record_times(args.series):
+            print(t)
+    else:
+        atime, rtime = reconstruct(args.series, args.time)
+        print("record at t=%g, %d burnt points" % (rtime, int(np.sum(atime != -9999))))
+        if args.output:
+            write_full(args.output, args.series, atime)